@@ -0,0 +1,93 @@
+#include "LiveBPApplyScheduler.h"
+#include "LiveBPCore.h"
+
+FLiveBPApplyScheduler::FLiveBPApplyScheduler()
+	: BacklogTotal(0)
+{
+}
+
+ELiveBPApplyPriority FLiveBPApplyScheduler::GetPriority(ELiveBPNodeOperation Operation)
+{
+	switch (Operation)
+	{
+	case ELiveBPNodeOperation::Add:
+	case ELiveBPNodeOperation::Delete:
+		return ELiveBPApplyPriority::Structure;
+	case ELiveBPNodeOperation::PinConnect:
+	case ELiveBPNodeOperation::PinDisconnect:
+		return ELiveBPApplyPriority::Links;
+	default:
+		return ELiveBPApplyPriority::Layout;
+	}
+}
+
+void FLiveBPApplyScheduler::Enqueue(FLiveBPInboundMessage&& Message)
+{
+	// Groups of moves and transactions are applied as one operation each. A transaction may create
+	// nodes that its own links refer to, so it runs with the structural changes.
+	ELiveBPApplyPriority Priority;
+	if (Message.Data.IsType<FLiveBPNodeOperationData>())
+	{
+		Priority = GetPriority(Message.Data.Get<FLiveBPNodeOperationData>().Operation);
+	}
+	else if (Message.Data.IsType<TArray<FLiveBPNodeMove>>())
+	{
+		Priority = ELiveBPApplyPriority::Layout;
+	}
+	else if (Message.Data.IsType<TArray<FLiveBPNodeOperationData>>())
+	{
+		Priority = ELiveBPApplyPriority::Structure;
+	}
+	else
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Only node operations can be scheduled for apply (got message type %d)"),
+			static_cast<int32>(Message.MessageType));
+		return;
+	}
+
+	Queues[static_cast<int32>(Priority)].Add(MoveTemp(Message));
+	BacklogTotal++;
+}
+
+int32 FLiveBPApplyScheduler::Apply(double BudgetSeconds, TFunctionRef<void(FLiveBPInboundMessage& Message)> ApplyOperation)
+{
+	const double Deadline = FPlatformTime::Seconds() + BudgetSeconds;
+	int32 Applied = 0;
+
+	for (TRingBuffer<FLiveBPInboundMessage>& Queue : Queues)
+	{
+		while (!Queue.IsEmpty())
+		{
+			if (Applied > 0 && FPlatformTime::Seconds() >= Deadline)
+			{
+				return Applied;
+			}
+
+			FLiveBPInboundMessage Message = Queue.PopFrontValue();
+			ApplyOperation(Message);
+			Applied++;
+		}
+	}
+
+	BacklogTotal = 0;
+	return Applied;
+}
+
+int32 FLiveBPApplyScheduler::Num() const
+{
+	int32 Total = 0;
+	for (const TRingBuffer<FLiveBPInboundMessage>& Queue : Queues)
+	{
+		Total += Queue.Num();
+	}
+	return Total;
+}
+
+void FLiveBPApplyScheduler::Reset()
+{
+	for (TRingBuffer<FLiveBPInboundMessage>& Queue : Queues)
+	{
+		Queue.Empty();
+	}
+	BacklogTotal = 0;
+}
@@ -0,0 +1,1129 @@
+#include "LiveBPBinaryCodec.h"
+#include "LiveBPCore.h"
+#include "LiveBPUtils.h"
+#include "LiveBPPerformanceMonitor.h"
+#include "Misc/Compression.h"
+
+// FLiveBPMessageView implementation
+FLiveBPMessage FLiveBPMessageView::ToMessage() const
+{
+	FLiveBPMessage Message;
+	Message.MessageType = MessageType;
+	Message.BlueprintId = BlueprintId;
+	Message.GraphId = GraphId;
+	Message.UserId = GetUserId();
+	Message.Timestamp = Timestamp;
+	Message.PayloadData = TArray<uint8>(Payload);
+	Message.NameTable = NameTable;
+	return Message;
+}
+
+// FLiveBPBinaryWriter implementation
+FLiveBPBinaryWriter::FLiveBPBinaryWriter(TArray<uint8>& InBuffer)
+	: Buffer(InBuffer)
+	, Interner(nullptr)
+{
+}
+
+void FLiveBPBinaryWriter::WriteByte(uint8 Value)
+{
+	Buffer.Add(Value);
+}
+
+void FLiveBPBinaryWriter::WriteVarUInt(uint64 Value)
+{
+	do
+	{
+		uint8 Byte = static_cast<uint8>(Value & 0x7F);
+		Value >>= 7;
+		if (Value != 0)
+		{
+			Byte |= 0x80;
+		}
+		Buffer.Add(Byte);
+	}
+	while (Value != 0);
+}
+
+void FLiveBPBinaryWriter::WriteVarInt(int64 Value)
+{
+	// Zigzag so small negative numbers stay small
+	WriteVarUInt((static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+}
+
+void FLiveBPBinaryWriter::WriteFloat(float Value)
+{
+	uint32 Bits;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	Bits = INTEL_ORDER32(Bits);
+	WriteBytes(&Bits, sizeof(Bits));
+}
+
+void FLiveBPBinaryWriter::WriteInt16(int16 Value)
+{
+	const uint16 Bits = INTEL_ORDER16(static_cast<uint16>(Value));
+	WriteBytes(&Bits, sizeof(Bits));
+}
+
+void FLiveBPBinaryWriter::WriteGuid(const FGuid& Value)
+{
+	const uint32 Components[4] = { INTEL_ORDER32(Value.A), INTEL_ORDER32(Value.B), INTEL_ORDER32(Value.C), INTEL_ORDER32(Value.D) };
+	WriteBytes(Components, sizeof(Components));
+}
+
+void FLiveBPBinaryWriter::WriteString(const FString& Value)
+{
+	FTCHARToUTF8 Utf8(*Value, Value.Len());
+	WriteVarUInt(Utf8.Length());
+	WriteBytes(Utf8.Get(), Utf8.Length());
+}
+
+void FLiveBPBinaryWriter::WriteBytes(const void* Data, int32 InNum)
+{
+	if (InNum > 0)
+	{
+		Buffer.Append(static_cast<const uint8*>(Data), InNum);
+	}
+}
+
+void FLiveBPBinaryWriter::WriteName(ELiveBPNameKind Kind, const FString& Value)
+{
+	if (Interner)
+	{
+		WriteVarUInt((static_cast<uint64>(Interner->Intern(Kind, Value)) << 1) | 1);
+		return;
+	}
+
+	FTCHARToUTF8 Utf8(*Value, Value.Len());
+	WriteVarUInt(static_cast<uint64>(Utf8.Length()) << 1);
+	WriteBytes(Utf8.Get(), Utf8.Length());
+}
+
+void FLiveBPBinaryWriter::WriteName(ELiveBPNameKind Kind, const FGuid& Value)
+{
+	if (Interner)
+	{
+		WriteVarUInt((static_cast<uint64>(Interner->Intern(Kind, Value)) << 1) | 1);
+		return;
+	}
+
+	WriteVarUInt(0);
+	WriteGuid(Value);
+}
+
+// FLiveBPBinaryReader implementation
+FLiveBPBinaryReader::FLiveBPBinaryReader(const uint8* InData, int32 InNum)
+	: Data(InData)
+	, Num(InNum)
+	, Offset(0)
+	, bError(false)
+	, Names(nullptr)
+{
+}
+
+FLiveBPBinaryReader::FLiveBPBinaryReader(TArrayView<const uint8> InData)
+	: FLiveBPBinaryReader(InData.GetData(), InData.Num())
+{
+}
+
+bool FLiveBPBinaryReader::CanRead(int32 Bytes)
+{
+	if (bError || Bytes < 0 || Bytes > Num - Offset)
+	{
+		bError = true;
+		return false;
+	}
+	return true;
+}
+
+uint8 FLiveBPBinaryReader::ReadByte()
+{
+	return CanRead(1) ? Data[Offset++] : 0;
+}
+
+uint64 FLiveBPBinaryReader::ReadVarUInt()
+{
+	uint64 Value = 0;
+	for (int32 Shift = 0; Shift < 64; Shift += 7)
+	{
+		if (!CanRead(1))
+		{
+			return 0;
+		}
+
+		const uint8 Byte = Data[Offset++];
+		Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0)
+		{
+			return Value;
+		}
+	}
+
+	// More than 10 bytes is never produced by the writer
+	bError = true;
+	return 0;
+}
+
+int64 FLiveBPBinaryReader::ReadVarInt()
+{
+	const uint64 Encoded = ReadVarUInt();
+	return static_cast<int64>(Encoded >> 1) ^ -static_cast<int64>(Encoded & 1);
+}
+
+float FLiveBPBinaryReader::ReadFloat()
+{
+	uint32 Bits = 0;
+	if (!ReadBytes(&Bits, sizeof(Bits)))
+	{
+		return 0.0f;
+	}
+
+	Bits = INTEL_ORDER32(Bits);
+	float Value;
+	FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+	return Value;
+}
+
+int16 FLiveBPBinaryReader::ReadInt16()
+{
+	uint16 Bits = 0;
+	if (!ReadBytes(&Bits, sizeof(Bits)))
+	{
+		return 0;
+	}
+	return static_cast<int16>(INTEL_ORDER16(Bits));
+}
+
+FGuid FLiveBPBinaryReader::ReadGuid()
+{
+	uint32 Components[4] = { 0, 0, 0, 0 };
+	if (!ReadBytes(Components, sizeof(Components)))
+	{
+		return FGuid();
+	}
+	return FGuid(INTEL_ORDER32(Components[0]), INTEL_ORDER32(Components[1]), INTEL_ORDER32(Components[2]), INTEL_ORDER32(Components[3]));
+}
+
+FString FLiveBPBinaryReader::ReadString()
+{
+	const uint64 Length = ReadVarUInt();
+	if (Length > static_cast<uint64>(MAX_int32) || !CanRead(static_cast<int32>(Length)))
+	{
+		bError = true;
+		return FString();
+	}
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), static_cast<int32>(Length));
+	Offset += static_cast<int32>(Length);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+bool FLiveBPBinaryReader::ReadBytes(void* OutData, int32 InNum)
+{
+	if (!CanRead(InNum))
+	{
+		return false;
+	}
+
+	FMemory::Memcpy(OutData, Data + Offset, InNum);
+	Offset += InNum;
+	return true;
+}
+
+bool FLiveBPBinaryReader::Skip(int32 InNum)
+{
+	if (!CanRead(InNum))
+	{
+		return false;
+	}
+
+	Offset += InNum;
+	return true;
+}
+
+FString FLiveBPBinaryReader::ReadName(ELiveBPNameKind Kind)
+{
+	const uint64 Tag = ReadVarUInt();
+	if (Tag & 1)
+	{
+		const FString* Value = Names ? Names->FindString(Kind, Tag >> 1) : nullptr;
+		if (!Value)
+		{
+			bError = true;
+			return FString();
+		}
+		return *Value;
+	}
+
+	const uint64 Length = Tag >> 1;
+	if (Length > static_cast<uint64>(MAX_int32) || !CanRead(static_cast<int32>(Length)))
+	{
+		bError = true;
+		return FString();
+	}
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), static_cast<int32>(Length));
+	Offset += static_cast<int32>(Length);
+	return FString(Converted.Length(), Converted.Get());
+}
+
+FGuid FLiveBPBinaryReader::ReadGuidName(ELiveBPNameKind Kind)
+{
+	const uint64 Tag = ReadVarUInt();
+	if (Tag & 1)
+	{
+		const FGuid* Value = Names ? Names->FindGuid(Kind, Tag >> 1) : nullptr;
+		if (!Value)
+		{
+			bError = true;
+			return FGuid();
+		}
+		return *Value;
+	}
+
+	if (Tag != 0)
+	{
+		bError = true;
+		return FGuid();
+	}
+	return ReadGuid();
+}
+
+// FLiveBPBinaryCodec implementation
+uint32 FLiveBPBinaryCodec::GetNodeOperationLayout(ELiveBPNodeOperation Operation)
+{
+	switch (Operation)
+	{
+	case ELiveBPNodeOperation::Add:
+		return NodeField_NodeId | NodeField_Position | NodeField_NodeClass | NodeField_PropertyData;
+	case ELiveBPNodeOperation::Delete:
+		return NodeField_NodeId;
+	case ELiveBPNodeOperation::Move:
+		return NodeField_NodeId | NodeField_Position;
+	case ELiveBPNodeOperation::PinConnect:
+	case ELiveBPNodeOperation::PinDisconnect:
+		return NodeField_NodeId | NodeField_TargetNodeId | NodeField_PinName | NodeField_TargetPinName;
+	case ELiveBPNodeOperation::PropertyChange:
+		return NodeField_NodeId | NodeField_PropertyData;
+	default:
+		return NodeField_NodeId;
+	}
+}
+
+void FLiveBPBinaryCodec::EncodeNodeOperation(const FLiveBPNodeOperationData& NodeOperation, TArray<uint8>& OutData)
+{
+	FLiveBPBinaryWriter Writer(OutData);
+	EncodeNodeOperation(NodeOperation, Writer);
+}
+
+void FLiveBPBinaryCodec::EncodeNodeOperation(const FLiveBPNodeOperationData& NodeOperation, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::NodeOperation);
+	WriteNodeOperationBody(NodeOperation, Writer);
+}
+
+void FLiveBPBinaryCodec::WriteNodeOperationBody(const FLiveBPNodeOperationData& NodeOperation, FLiveBPBinaryWriter& Writer)
+{
+	// Only write the fields this operation uses, and skip the empty optional ones
+	uint32 FieldMask = GetNodeOperationLayout(NodeOperation.Operation);
+	if (!NodeOperation.TargetNodeId.IsValid())
+	{
+		FieldMask &= ~NodeField_TargetNodeId;
+	}
+	if (NodeOperation.PinName.IsEmpty())
+	{
+		FieldMask &= ~NodeField_PinName;
+	}
+	if (NodeOperation.TargetPinName.IsEmpty())
+	{
+		FieldMask &= ~NodeField_TargetPinName;
+	}
+	if (NodeOperation.NodeClass.IsEmpty())
+	{
+		FieldMask &= ~NodeField_NodeClass;
+	}
+	if (NodeOperation.PropertyData.IsEmpty())
+	{
+		FieldMask &= ~NodeField_PropertyData;
+	}
+
+	Writer.WriteByte(static_cast<uint8>(NodeOperation.Operation));
+	Writer.WriteVarUInt(FieldMask);
+
+	if (FieldMask & NodeField_NodeId)
+	{
+		Writer.WriteGuid(NodeOperation.NodeId);
+	}
+	if (FieldMask & NodeField_TargetNodeId)
+	{
+		Writer.WriteGuid(NodeOperation.TargetNodeId);
+	}
+	if (FieldMask & NodeField_PinName)
+	{
+		Writer.WriteName(ELiveBPNameKind::Pin, NodeOperation.PinName);
+	}
+	if (FieldMask & NodeField_TargetPinName)
+	{
+		Writer.WriteName(ELiveBPNameKind::Pin, NodeOperation.TargetPinName);
+	}
+	if (FieldMask & NodeField_Position)
+	{
+		// Graph node positions are integral (NodePosX/NodePosY)
+		Writer.WriteVarInt(FMath::RoundToInt(NodeOperation.Position.X));
+		Writer.WriteVarInt(FMath::RoundToInt(NodeOperation.Position.Y));
+	}
+	if (FieldMask & NodeField_NodeClass)
+	{
+		Writer.WriteName(ELiveBPNameKind::NodeClass, NodeOperation.NodeClass);
+	}
+	if (FieldMask & NodeField_PropertyData)
+	{
+		Writer.WriteString(NodeOperation.PropertyData);
+	}
+}
+
+bool FLiveBPBinaryCodec::DecodeNodeOperation(TArrayView<const uint8> Data, FLiveBPNodeOperationData& OutNodeOperation, const FLiveBPNameTable* Names)
+{
+	FLiveBPBinaryReader Reader(Data);
+	Reader.SetNameTable(Names);
+	return DecodeNodeOperation(Reader, OutNodeOperation);
+}
+
+bool FLiveBPBinaryCodec::DecodeNodeOperation(FLiveBPBinaryReader& Reader, FLiveBPNodeOperationData& OutNodeOperation)
+{
+	return ReadHeader(Reader, EPayloadKind::NodeOperation) && ReadNodeOperationBody(Reader, OutNodeOperation);
+}
+
+bool FLiveBPBinaryCodec::ReadNodeOperationBody(FLiveBPBinaryReader& Reader, FLiveBPNodeOperationData& OutNodeOperation)
+{
+	const uint8 Operation = Reader.ReadByte();
+	if (Operation > static_cast<uint8>(ELiveBPNodeOperation::PropertyChange))
+	{
+		return false;
+	}
+	OutNodeOperation.Operation = static_cast<ELiveBPNodeOperation>(Operation);
+
+	const uint64 FieldMask = Reader.ReadVarUInt();
+	if (FieldMask & ~static_cast<uint64>(GetNodeOperationLayout(OutNodeOperation.Operation)))
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Node operation payload carries fields outside the %s layout"),
+			*FLiveBPUtils::NodeOperationToString(OutNodeOperation.Operation));
+		return false;
+	}
+
+	if (FieldMask & NodeField_NodeId)
+	{
+		OutNodeOperation.NodeId = Reader.ReadGuid();
+	}
+	if (FieldMask & NodeField_TargetNodeId)
+	{
+		OutNodeOperation.TargetNodeId = Reader.ReadGuid();
+	}
+	if (FieldMask & NodeField_PinName)
+	{
+		OutNodeOperation.PinName = Reader.ReadName(ELiveBPNameKind::Pin);
+	}
+	if (FieldMask & NodeField_TargetPinName)
+	{
+		OutNodeOperation.TargetPinName = Reader.ReadName(ELiveBPNameKind::Pin);
+	}
+	if (FieldMask & NodeField_Position)
+	{
+		OutNodeOperation.Position.X = static_cast<double>(Reader.ReadVarInt());
+		OutNodeOperation.Position.Y = static_cast<double>(Reader.ReadVarInt());
+	}
+	if (FieldMask & NodeField_NodeClass)
+	{
+		OutNodeOperation.NodeClass = Reader.ReadName(ELiveBPNameKind::NodeClass);
+	}
+	if (FieldMask & NodeField_PropertyData)
+	{
+		OutNodeOperation.PropertyData = Reader.ReadString();
+	}
+
+	return !Reader.IsError();
+}
+
+void FLiveBPBinaryCodec::EncodeNodeTransaction(TArrayView<const FLiveBPNodeOperationData> NodeOperations, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::NodeTransaction);
+	Writer.WriteVarUInt(NodeOperations.Num());
+	for (const FLiveBPNodeOperationData& NodeOperation : NodeOperations)
+	{
+		WriteNodeOperationBody(NodeOperation, Writer);
+	}
+}
+
+bool FLiveBPBinaryCodec::DecodeNodeTransaction(TArrayView<const uint8> Data, TArray<FLiveBPNodeOperationData>& OutNodeOperations,
+	const FLiveBPNameTable* Names)
+{
+	FLiveBPBinaryReader Reader(Data);
+	Reader.SetNameTable(Names);
+	if (!ReadHeader(Reader, EPayloadKind::NodeTransaction))
+	{
+		return false;
+	}
+
+	// Every operation takes at least two bytes (its kind and field mask)
+	const uint64 Count = Reader.ReadVarUInt();
+	if (Reader.IsError() || Count > static_cast<uint64>(Reader.GetRemaining().Num() / 2))
+	{
+		return false;
+	}
+
+	OutNodeOperations.Reset(static_cast<int32>(Count));
+	for (uint64 Index = 0; Index < Count; ++Index)
+	{
+		if (!ReadNodeOperationBody(Reader, OutNodeOperations.AddDefaulted_GetRef()))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FLiveBPBinaryCodec::EncodeNodeLock(const FLiveBPNodeLock& NodeLock, TArray<uint8>& OutData)
+{
+	FLiveBPBinaryWriter Writer(OutData);
+	EncodeNodeLock(NodeLock, Writer);
+}
+
+void FLiveBPBinaryCodec::EncodeNodeLock(const FLiveBPNodeLock& NodeLock, FLiveBPBinaryWriter& Writer)
+{
+	uint32 FieldMask = LockField_NodeId | LockField_LockTime | LockField_Duration;
+	if (!NodeLock.UserId.IsEmpty())
+	{
+		FieldMask |= LockField_UserId;
+	}
+
+	WriteHeader(Writer, EPayloadKind::NodeLock);
+	Writer.WriteByte(static_cast<uint8>(NodeLock.LockState));
+	Writer.WriteVarUInt(FieldMask);
+
+	Writer.WriteGuid(NodeLock.NodeId);
+	if (FieldMask & LockField_UserId)
+	{
+		Writer.WriteName(ELiveBPNameKind::User, NodeLock.UserId);
+	}
+	Writer.WriteFloat(static_cast<float>(NodeLock.LockTime));
+	Writer.WriteFloat(static_cast<float>(NodeLock.ExpiryTime - NodeLock.LockTime));
+}
+
+bool FLiveBPBinaryCodec::DecodeNodeLock(TArrayView<const uint8> Data, FLiveBPNodeLock& OutNodeLock, const FLiveBPNameTable* Names)
+{
+	FLiveBPBinaryReader Reader(Data);
+	Reader.SetNameTable(Names);
+	return DecodeNodeLock(Reader, OutNodeLock);
+}
+
+bool FLiveBPBinaryCodec::DecodeNodeLock(FLiveBPBinaryReader& Reader, FLiveBPNodeLock& OutNodeLock)
+{
+	if (!ReadHeader(Reader, EPayloadKind::NodeLock))
+	{
+		return false;
+	}
+
+	const uint8 LockState = Reader.ReadByte();
+	if (LockState > static_cast<uint8>(ELiveBPLockState::Pending))
+	{
+		return false;
+	}
+	OutNodeLock.LockState = static_cast<ELiveBPLockState>(LockState);
+
+	const uint64 FieldMask = Reader.ReadVarUInt();
+	if (FieldMask & LockField_NodeId)
+	{
+		OutNodeLock.NodeId = Reader.ReadGuid();
+	}
+	if (FieldMask & LockField_UserId)
+	{
+		OutNodeLock.UserId = Reader.ReadName(ELiveBPNameKind::User);
+	}
+	if (FieldMask & LockField_LockTime)
+	{
+		OutNodeLock.LockTime = Reader.ReadFloat();
+	}
+	if (FieldMask & LockField_Duration)
+	{
+		OutNodeLock.ExpiryTime = OutNodeLock.LockTime + Reader.ReadFloat();
+	}
+
+	return !Reader.IsError();
+}
+
+void FLiveBPBinaryCodec::EncodeNodeLockSet(const FLiveBPNodeLockSet& LockSet, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::NodeLockSet);
+	Writer.WriteByte(static_cast<uint8>(LockSet.LockState));
+	Writer.WriteFloat(LockSet.Duration);
+	Writer.WriteVarUInt(LockSet.NodeIds.Num());
+	for (const FGuid& NodeId : LockSet.NodeIds)
+	{
+		Writer.WriteName(ELiveBPNameKind::Node, NodeId);
+	}
+}
+
+bool FLiveBPBinaryCodec::DecodeNodeLockSet(TArrayView<const uint8> Data, FLiveBPNodeLockSet& OutLockSet, const FLiveBPNameTable* Names)
+{
+	FLiveBPBinaryReader Reader(Data);
+	Reader.SetNameTable(Names);
+	if (!ReadHeader(Reader, EPayloadKind::NodeLockSet))
+	{
+		return false;
+	}
+
+	const uint8 LockState = Reader.ReadByte();
+	if (LockState > static_cast<uint8>(ELiveBPLockState::Pending))
+	{
+		return false;
+	}
+	OutLockSet.LockState = static_cast<ELiveBPLockState>(LockState);
+	OutLockSet.Duration = Reader.ReadFloat();
+
+	// Every node id takes at least one byte (a name handle)
+	const uint64 Count = Reader.ReadVarUInt();
+	if (Reader.IsError() || Count > static_cast<uint64>(Reader.GetRemaining().Num()))
+	{
+		return false;
+	}
+
+	OutLockSet.NodeIds.Reset(static_cast<int32>(Count));
+	for (uint64 Index = 0; Index < Count; ++Index)
+	{
+		OutLockSet.NodeIds.Add(Reader.ReadGuidName(ELiveBPNameKind::Node));
+	}
+
+	return !Reader.IsError();
+}
+
+void FLiveBPBinaryCodec::EncodeWirePreview(const FLiveBPWirePreview& WirePreview, TArray<uint8>& OutData)
+{
+	FLiveBPBinaryWriter Writer(OutData);
+	EncodeWirePreview(WirePreview, Writer);
+}
+
+void FLiveBPBinaryCodec::EncodeWirePreview(const FLiveBPWirePreview& WirePreview, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::WirePreview);
+	Writer.WriteGuid(WirePreview.NodeId);
+	Writer.WriteName(ELiveBPNameKind::Pin, WirePreview.PinName);
+	Writer.WriteFloat(WirePreview.StartPosition.X);
+	Writer.WriteFloat(WirePreview.StartPosition.Y);
+	Writer.WriteFloat(WirePreview.EndPosition.X);
+	Writer.WriteFloat(WirePreview.EndPosition.Y);
+}
+
+bool FLiveBPBinaryCodec::DecodeWirePreview(TArrayView<const uint8> Data, FLiveBPWirePreview& OutWirePreview, const FLiveBPNameTable* Names)
+{
+	FLiveBPBinaryReader Reader(Data);
+	Reader.SetNameTable(Names);
+	return DecodeWirePreview(Reader, OutWirePreview);
+}
+
+bool FLiveBPBinaryCodec::DecodeWirePreview(FLiveBPBinaryReader& Reader, FLiveBPWirePreview& OutWirePreview)
+{
+	if (!ReadHeader(Reader, EPayloadKind::WirePreview))
+	{
+		return false;
+	}
+
+	OutWirePreview.NodeId = Reader.ReadGuid();
+	OutWirePreview.PinName = Reader.ReadName(ELiveBPNameKind::Pin);
+	OutWirePreview.StartPosition.X = Reader.ReadFloat();
+	OutWirePreview.StartPosition.Y = Reader.ReadFloat();
+	OutWirePreview.EndPosition.X = Reader.ReadFloat();
+	OutWirePreview.EndPosition.Y = Reader.ReadFloat();
+
+	return !Reader.IsError();
+}
+
+void FLiveBPBinaryCodec::EncodeWirePreviewPacket(const FWirePreviewPacket& Packet, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::WirePreviewStream);
+	Writer.WriteByte((static_cast<uint8>(Packet.Event) << 6) | (Packet.KeyframeId & WirePreviewKeyframeIdMask));
+
+	switch (Packet.Event)
+	{
+	case EWirePreviewEvent::Begin:
+		Writer.WriteGuid(Packet.NodeId);
+		Writer.WriteName(ELiveBPNameKind::Pin, Packet.PinName);
+		Writer.WriteVarInt(Packet.StartPosition.X);
+		Writer.WriteVarInt(Packet.StartPosition.Y);
+		Writer.WriteVarInt(Packet.EndPosition.X);
+		Writer.WriteVarInt(Packet.EndPosition.Y);
+		break;
+	case EWirePreviewEvent::Keyframe:
+		Writer.WriteVarInt(Packet.EndPosition.X);
+		Writer.WriteVarInt(Packet.EndPosition.Y);
+		break;
+	case EWirePreviewEvent::Delta:
+		check(Packet.EndPosition.X >= MIN_int16 && Packet.EndPosition.X <= MAX_int16);
+		check(Packet.EndPosition.Y >= MIN_int16 && Packet.EndPosition.Y <= MAX_int16);
+		Writer.WriteInt16(static_cast<int16>(Packet.EndPosition.X));
+		Writer.WriteInt16(static_cast<int16>(Packet.EndPosition.Y));
+		break;
+	case EWirePreviewEvent::End:
+		break;
+	}
+}
+
+bool FLiveBPBinaryCodec::DecodeWirePreviewPacket(FLiveBPBinaryReader& Reader, FWirePreviewPacket& OutPacket)
+{
+	if (!ReadHeader(Reader, EPayloadKind::WirePreviewStream))
+	{
+		return false;
+	}
+
+	const uint8 EventByte = Reader.ReadByte();
+	OutPacket.Event = static_cast<EWirePreviewEvent>(EventByte >> 6);
+	OutPacket.KeyframeId = EventByte & WirePreviewKeyframeIdMask;
+
+	switch (OutPacket.Event)
+	{
+	case EWirePreviewEvent::Begin:
+		OutPacket.NodeId = Reader.ReadGuid();
+		OutPacket.PinName = Reader.ReadName(ELiveBPNameKind::Pin);
+		OutPacket.StartPosition.X = static_cast<int32>(Reader.ReadVarInt());
+		OutPacket.StartPosition.Y = static_cast<int32>(Reader.ReadVarInt());
+		OutPacket.EndPosition.X = static_cast<int32>(Reader.ReadVarInt());
+		OutPacket.EndPosition.Y = static_cast<int32>(Reader.ReadVarInt());
+		break;
+	case EWirePreviewEvent::Keyframe:
+		OutPacket.EndPosition.X = static_cast<int32>(Reader.ReadVarInt());
+		OutPacket.EndPosition.Y = static_cast<int32>(Reader.ReadVarInt());
+		break;
+	case EWirePreviewEvent::Delta:
+		OutPacket.EndPosition.X = Reader.ReadInt16();
+		OutPacket.EndPosition.Y = Reader.ReadInt16();
+		break;
+	case EWirePreviewEvent::End:
+		break;
+	}
+
+	return !Reader.IsError();
+}
+
+void FLiveBPBinaryCodec::EncodeInterest(TArrayView<const FGuid> BlueprintIds, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::Interest);
+	Writer.WriteVarUInt(BlueprintIds.Num());
+	for (const FGuid& BlueprintId : BlueprintIds)
+	{
+		Writer.WriteGuid(BlueprintId);
+	}
+}
+
+bool FLiveBPBinaryCodec::DecodeInterest(TArrayView<const uint8> Data, TArray<FGuid>& OutBlueprintIds)
+{
+	FLiveBPBinaryReader Reader(Data);
+	if (!ReadHeader(Reader, EPayloadKind::Interest))
+	{
+		return false;
+	}
+
+	// Every id takes 16 bytes, so a count the data can't hold is malformed
+	const uint64 Count = Reader.ReadVarUInt();
+	if (Reader.IsError() || Count > static_cast<uint64>(Reader.GetRemaining().Num() / sizeof(FGuid)))
+	{
+		return false;
+	}
+
+	OutBlueprintIds.Reset(static_cast<int32>(Count));
+	for (uint64 Index = 0; Index < Count; ++Index)
+	{
+		OutBlueprintIds.Add(Reader.ReadGuid());
+	}
+
+	return !Reader.IsError();
+}
+
+void FLiveBPBinaryCodec::EncodeHeartbeat(const FLiveBPHeartbeat& Heartbeat, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::Heartbeat);
+	Writer.WriteVarUInt(Heartbeat.SendTimeUs);
+	Writer.WriteVarUInt(Heartbeat.EchoTimeUs);
+	Writer.WriteVarUInt(Heartbeat.EchoDelayUs);
+	Writer.WriteVarUInt(Heartbeat.UnreliableReceived);
+}
+
+bool FLiveBPBinaryCodec::DecodeHeartbeat(TArrayView<const uint8> Data, FLiveBPHeartbeat& OutHeartbeat)
+{
+	FLiveBPBinaryReader Reader(Data);
+	if (!ReadHeader(Reader, EPayloadKind::Heartbeat))
+	{
+		return false;
+	}
+
+	OutHeartbeat.SendTimeUs = Reader.ReadVarUInt();
+	OutHeartbeat.EchoTimeUs = Reader.ReadVarUInt();
+	OutHeartbeat.EchoDelayUs = Reader.ReadVarUInt();
+	OutHeartbeat.UnreliableReceived = Reader.ReadVarUInt();
+
+	return !Reader.IsError() && OutHeartbeat.SendTimeUs != 0;
+}
+
+void FLiveBPBinaryCodec::EncodePresence(const FLiveBPPresence& Presence, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::Presence);
+	Writer.WriteByte(Presence.bHasCursor ? 1 : 0);
+	if (Presence.bHasCursor)
+	{
+		Writer.WriteVarInt(Presence.Cursor.X);
+		Writer.WriteVarInt(Presence.Cursor.Y);
+	}
+	Writer.WriteVarInt(Presence.View.Min.X);
+	Writer.WriteVarInt(Presence.View.Min.Y);
+	Writer.WriteVarUInt(FMath::Max(Presence.View.Width(), 0));
+	Writer.WriteVarUInt(FMath::Max(Presence.View.Height(), 0));
+}
+
+bool FLiveBPBinaryCodec::DecodePresence(TArrayView<const uint8> Data, FLiveBPPresence& OutPresence)
+{
+	FLiveBPBinaryReader Reader(Data);
+	if (!ReadHeader(Reader, EPayloadKind::Presence))
+	{
+		return false;
+	}
+
+	const uint8 Flags = Reader.ReadByte();
+	OutPresence.bHasCursor = (Flags & 1) != 0;
+	if (OutPresence.bHasCursor)
+	{
+		OutPresence.Cursor.X = static_cast<int32>(Reader.ReadVarInt());
+		OutPresence.Cursor.Y = static_cast<int32>(Reader.ReadVarInt());
+	}
+
+	OutPresence.View.Min.X = static_cast<int32>(Reader.ReadVarInt());
+	OutPresence.View.Min.Y = static_cast<int32>(Reader.ReadVarInt());
+	const uint64 Width = Reader.ReadVarUInt();
+	const uint64 Height = Reader.ReadVarUInt();
+	if (Reader.IsError() || Width > MAX_int32 || Height > MAX_int32)
+	{
+		return false;
+	}
+	OutPresence.View.Max = OutPresence.View.Min + FIntPoint(static_cast<int32>(Width), static_cast<int32>(Height));
+
+	return true;
+}
+
+void FLiveBPBinaryCodec::EncodeNodeMoves(TArrayView<const FLiveBPNodeMove> Moves, FLiveBPBinaryWriter& Writer)
+{
+	WriteHeader(Writer, EPayloadKind::NodeMoves);
+	Writer.WriteVarUInt(Moves.Num());
+	for (const FLiveBPNodeMove& Move : Moves)
+	{
+		Writer.WriteName(ELiveBPNameKind::Node, Move.NodeId);
+		Writer.WriteVarInt(Move.Position.X);
+		Writer.WriteVarInt(Move.Position.Y);
+	}
+}
+
+bool FLiveBPBinaryCodec::DecodeNodeMoves(TArrayView<const uint8> Data, TArray<FLiveBPNodeMove>& OutMoves, const FLiveBPNameTable* Names)
+{
+	FLiveBPBinaryReader Reader(Data);
+	Reader.SetNameTable(Names);
+	if (!ReadHeader(Reader, EPayloadKind::NodeMoves))
+	{
+		return false;
+	}
+
+	// Every move takes at least three bytes (a name handle and two varints)
+	const uint64 Count = Reader.ReadVarUInt();
+	if (Reader.IsError() || Count > static_cast<uint64>(Reader.GetRemaining().Num() / 3))
+	{
+		return false;
+	}
+
+	OutMoves.Reset(static_cast<int32>(Count));
+	for (uint64 Index = 0; Index < Count; ++Index)
+	{
+		FLiveBPNodeMove& Move = OutMoves.AddDefaulted_GetRef();
+		Move.NodeId = Reader.ReadGuidName(ELiveBPNameKind::Node);
+		Move.Position.X = static_cast<int32>(Reader.ReadVarInt());
+		Move.Position.Y = static_cast<int32>(Reader.ReadVarInt());
+	}
+
+	return !Reader.IsError();
+}
+
+bool FLiveBPBinaryCodec::IsWirePreviewStreamPayload(TArrayView<const uint8> Data)
+{
+	return Data.Num() >= 3 && Data[0] == FormatMagic && Data[2] == static_cast<uint8>(EPayloadKind::WirePreviewStream);
+}
+
+void FLiveBPBinaryCodec::EncodeFrame(const FLiveBPMessage& Message, FLiveBPNameInterner& Interner, TArray<uint8>& OutFrame, const FLiveBPCompressionPolicy* Compression)
+{
+	EncodeFrame(Message.MessageType, Message.UserId, Message.BlueprintId, Message.GraphId, Message.PayloadData, Interner, OutFrame, Compression);
+}
+
+void FLiveBPBinaryCodec::EncodeFrame(ELiveBPMessageType MessageType, const FString& UserId, const FGuid& BlueprintId, const FGuid& GraphId,
+	TArrayView<const uint8> Payload, FLiveBPNameInterner& Interner, TArray<uint8>& OutFrame, const FLiveBPCompressionPolicy* Compression,
+	uint32 Sequence)
+{
+	// Intern the envelope first so its definitions go out together with the payload's
+	const uint32 UserHandle = Interner.Intern(ELiveBPNameKind::User, UserId);
+	const uint32 BlueprintHandle = Interner.Intern(ELiveBPNameKind::Blueprint, BlueprintId);
+	const uint32 GraphHandle = Interner.Intern(ELiveBPNameKind::Graph, GraphId);
+
+	uint8 Flags = FrameFlag_Message;
+	if (Interner.HasPendingDefinitions())
+	{
+		Flags |= FrameFlag_Definitions;
+	}
+	if (Sequence != 0)
+	{
+		Flags |= FrameFlag_Sequenced;
+	}
+
+	// Small payloads are left alone; compressing them costs more CPU than it saves on the wire.
+	// Only this path allocates, so steady-state small messages never touch the heap.
+	const int32 RawSize = Payload.Num();
+	TArray<uint8> CompressedPayload;
+	if (Compression && Compression->MinPayloadBytes > 0 && RawSize >= Compression->MinPayloadBytes)
+	{
+		const FName FormatName = GetCompressionFormatName(Compression->Format);
+		const double StartTime = FPlatformTime::Seconds();
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, RawSize);
+		CompressedPayload.SetNumUninitialized(CompressedSize);
+		const bool bCompressed = FCompression::CompressMemory(FormatName, CompressedPayload.GetData(), CompressedSize, Payload.GetData(), RawSize);
+
+		// Only worth it if the result still wins after the [Format][RawSize] prefix
+		if (bCompressed && CompressedSize + 1 + 5 < RawSize)
+		{
+			CompressedPayload.SetNum(CompressedSize, EAllowShrinking::No);
+			Flags |= FrameFlag_Compressed;
+		}
+		else
+		{
+			CompressedPayload.Reset();
+		}
+
+		LIVEBP_RECORD_COMPRESSION(MessageType, RawSize, (Flags & FrameFlag_Compressed) ? CompressedSize : RawSize,
+			(FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+
+	OutFrame.Reset();
+	FLiveBPBinaryWriter Writer(OutFrame);
+	Writer.WriteByte((FrameVersion << 4) | Flags);
+	Writer.WriteByte(static_cast<uint8>(MessageType));
+	if (Flags & FrameFlag_Definitions)
+	{
+		Interner.WritePendingDefinitions(Writer);
+	}
+	Writer.WriteVarUInt(UserHandle);
+	Writer.WriteVarUInt(BlueprintHandle);
+	Writer.WriteVarUInt(GraphHandle);
+	if (Flags & FrameFlag_Sequenced)
+	{
+		Writer.WriteVarUInt(Sequence);
+	}
+	if (Flags & FrameFlag_Compressed)
+	{
+		Writer.WriteByte(static_cast<uint8>(Compression->Format));
+		Writer.WriteVarUInt(RawSize);
+		Writer.WriteBytes(CompressedPayload.GetData(), CompressedPayload.Num());
+	}
+	else
+	{
+		Writer.WriteBytes(Payload.GetData(), RawSize);
+	}
+}
+
+void FLiveBPBinaryCodec::EncodeSnapshotFrame(const FLiveBPNameInterner& Interner, TArray<uint8>& OutFrame)
+{
+	OutFrame.Reset();
+	FLiveBPBinaryWriter Writer(OutFrame);
+	Writer.WriteByte((FrameVersion << 4) | FrameFlag_Definitions);
+	Interner.WriteSnapshot(Writer);
+}
+
+bool FLiveBPBinaryCodec::EncodePendingDefinitionsFrame(FLiveBPNameInterner& Interner, TArray<uint8>& OutFrame)
+{
+	if (!Interner.HasPendingDefinitions())
+	{
+		return false;
+	}
+
+	OutFrame.Reset();
+	FLiveBPBinaryWriter Writer(OutFrame);
+	Writer.WriteByte((FrameVersion << 4) | FrameFlag_Definitions);
+	Interner.WritePendingDefinitions(Writer);
+	return true;
+}
+
+bool FLiveBPBinaryCodec::DecodeFrame(TArrayView<const uint8> Frame, FLiveBPNameTable& Names, FLiveBPMessage& OutMessage, bool& bOutHasMessage)
+{
+	// Only compressed payloads use the arena, and they are copied out before it goes away
+	FLiveBPDecodeArena Arena;
+	FLiveBPMessageView View;
+	if (!DecodeFrame(Frame, Names, Arena, View, bOutHasMessage))
+	{
+		return false;
+	}
+
+	if (bOutHasMessage)
+	{
+		OutMessage = View.ToMessage();
+	}
+	return true;
+}
+
+bool FLiveBPBinaryCodec::DecodeFrame(TArrayView<const uint8> Frame, FLiveBPNameTable& Names, FLiveBPDecodeArena& Arena, FLiveBPMessageView& OutView, bool& bOutHasMessage,
+	EFrameError* OutError)
+{
+	FLiveBPBinaryReader Reader(Frame);
+	bOutHasMessage = false;
+
+	EFrameError UnusedError;
+	EFrameError& Error = OutError ? *OutError : UnusedError;
+	Error = EFrameError::Malformed;
+
+	const uint8 Header = Reader.ReadByte();
+	if (Reader.IsError() || (Header >> 4) != FrameVersion)
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Unsupported LiveBP frame version %d"), Header >> 4);
+		return false;
+	}
+
+	const uint8 Flags = Header & 0x0F;
+	uint8 MessageType = 0;
+	if (Flags & FrameFlag_Message)
+	{
+		MessageType = Reader.ReadByte();
+		if (MessageType > static_cast<uint8>(ELiveBPMessageType::LockSet))
+		{
+			return false;
+		}
+	}
+
+	if ((Flags & FrameFlag_Definitions) && !Names.ReadDefinitions(Reader))
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Rejected malformed session dictionary definitions"));
+		return false;
+	}
+
+	if (!(Flags & FrameFlag_Message))
+	{
+		if (Reader.IsError())
+		{
+			return false;
+		}
+		Error = EFrameError::None;
+		return true;
+	}
+
+	const FString* UserId = Names.FindString(ELiveBPNameKind::User, Reader.ReadVarUInt());
+	const FGuid* BlueprintId = Names.FindGuid(ELiveBPNameKind::Blueprint, Reader.ReadVarUInt());
+	const FGuid* GraphId = Names.FindGuid(ELiveBPNameKind::Graph, Reader.ReadVarUInt());
+	if (Reader.IsError())
+	{
+		return false;
+	}
+	if (!UserId || !BlueprintId || !GraphId)
+	{
+		Error = EFrameError::UndefinedHandle;
+		return false;
+	}
+
+	OutView.MessageType = static_cast<ELiveBPMessageType>(MessageType);
+	OutView.UserId = UserId;
+	OutView.BlueprintId = *BlueprintId;
+	OutView.GraphId = *GraphId;
+	OutView.Timestamp = FPlatformTime::Seconds();
+	OutView.Sequence = 0;
+
+	if (Flags & FrameFlag_Sequenced)
+	{
+		const uint64 Sequence = Reader.ReadVarUInt();
+		if (Reader.IsError() || Sequence == 0 || Sequence > MAX_uint32)
+		{
+			return false;
+		}
+		OutView.Sequence = static_cast<uint32>(Sequence);
+	}
+
+	if (Flags & FrameFlag_Compressed)
+	{
+		const uint8 Format = Reader.ReadByte();
+		const uint64 RawSize = Reader.ReadVarUInt();
+		if (Reader.IsError() || Format > static_cast<uint8>(ELiveBPCompressionFormat::LZ4) || RawSize == 0 || RawSize > MaxUncompressedPayloadBytes)
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Rejected compressed LiveBP frame (format %d, raw size %llu)"), Format, RawSize);
+			return false;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		const TArrayView<const uint8> CompressedPayload = Reader.GetRemaining();
+		const TArrayView<uint8> Payload = Arena.Allocate(static_cast<int32>(RawSize));
+		if (!FCompression::UncompressMemory(GetCompressionFormatName(static_cast<ELiveBPCompressionFormat>(Format)),
+			Payload.GetData(), Payload.Num(), CompressedPayload.GetData(), CompressedPayload.Num()))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Failed to decompress LiveBP payload (%d bytes)"), CompressedPayload.Num());
+			return false;
+		}
+
+		OutView.Payload = Payload;
+		LIVEBP_RECORD_DECOMPRESSION(OutView.MessageType, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+	else
+	{
+		// Points straight into the received frame
+		OutView.Payload = Reader.GetRemaining();
+	}
+
+	bOutHasMessage = true;
+	Error = EFrameError::None;
+	return true;
+}
+
+bool FLiveBPBinaryCodec::HasFrameDefinitions(TArrayView<const uint8> Frame)
+{
+	return Frame.Num() > 0 && (Frame[0] & FrameFlag_Definitions) != 0;
+}
+
+FName FLiveBPBinaryCodec::GetCompressionFormatName(ELiveBPCompressionFormat Format)
+{
+	switch (Format)
+	{
+	case ELiveBPCompressionFormat::Zlib:
+		return NAME_Zlib;
+	case ELiveBPCompressionFormat::Gzip:
+		return NAME_Gzip;
+	case ELiveBPCompressionFormat::LZ4:
+		return NAME_LZ4;
+	case ELiveBPCompressionFormat::Oodle:
+	default:
+		return NAME_Oodle;
+	}
+}
+
+bool FLiveBPBinaryCodec::IsBinaryPayload(TArrayView<const uint8> Data)
+{
+	return Data.Num() >= 2 && Data[0] == FormatMagic;
+}
+
+void FLiveBPBinaryCodec::WriteHeader(FLiveBPBinaryWriter& Writer, EPayloadKind Kind)
+{
+	Writer.WriteByte(FormatMagic);
+	Writer.WriteByte(FormatVersion);
+	Writer.WriteByte(static_cast<uint8>(Kind));
+}
+
+bool FLiveBPBinaryCodec::ReadHeader(FLiveBPBinaryReader& Reader, EPayloadKind ExpectedKind)
+{
+	if (Reader.ReadByte() != FormatMagic)
+	{
+		return false;
+	}
+
+	const uint8 Version = Reader.ReadByte();
+	if (Version == 0 || Version > FormatVersion)
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Unsupported LiveBP payload version %d (max %d)"), Version, FormatVersion);
+		return false;
+	}
+
+	return Reader.ReadByte() == static_cast<uint8>(ExpectedKind) && !Reader.IsError();
+}
@@ -0,0 +1,249 @@
+#include "LiveBPCongestionControl.h"
+#include "LiveBPCore.h"
+
+namespace LiveBPCongestion
+{
+	// Additive increase while a peer keeps up
+	static const float IncreaseHzPerSecond = 5.0f;
+
+	// Multiplicative decrease on congestion, at most once per round trip (or this interval, if longer)
+	static const float DecreaseFactor = 0.5f;
+	static const double MinDecreaseInterval = 0.25;
+
+	// Congestion thresholds
+	static const float LossThreshold = 0.05f;
+	static const double RttInflationFactor = 2.0;
+	static const double MinRttInflation = 0.05;
+	static const float QueueFillThreshold = 0.5f;
+
+	// One probe per peer per second; ones still waiting for an echo beyond this are forgotten
+	static const double HeartbeatInterval = 1.0;
+	static const int32 MaxOutstandingProbes = 4;
+}
+
+FLiveBPCongestionController::FLiveBPCongestionController()
+{
+}
+
+void FLiveBPCongestionController::SetBounds(const FLiveBPRateBounds& InBounds)
+{
+	Bounds = InBounds;
+	Bounds.MinRateHz = FMath::Max(Bounds.MinRateHz, 0.1f);
+	Bounds.MaxRateHz = FMath::Max(Bounds.MaxRateHz, Bounds.MinRateHz);
+
+	for (TPair<FGuid, FPeerState>& Pair : Peers)
+	{
+		Pair.Value.RateHz = Bounds.bAdaptive ? ClampRate(Pair.Value.RateHz) : ClampRate(Bounds.InitialRateHz);
+	}
+}
+
+void FLiveBPCongestionController::AddPeer(const FGuid& PeerId)
+{
+	FPeerState& Peer = Peers.Add(PeerId);
+	Peer.RateHz = ClampRate(Bounds.InitialRateHz);
+}
+
+void FLiveBPCongestionController::RemovePeer(const FGuid& PeerId)
+{
+	Peers.Remove(PeerId);
+}
+
+void FLiveBPCongestionController::Reset()
+{
+	Peers.Empty();
+}
+
+void FLiveBPCongestionController::Update(double CurrentTime, float QueueFill)
+{
+	for (TPair<FGuid, FPeerState>& Pair : Peers)
+	{
+		FPeerState& Peer = Pair.Value;
+		const double DeltaTime = Peer.LastUpdateTime > 0.0 ? CurrentTime - Peer.LastUpdateTime : 0.0;
+		Peer.LastUpdateTime = CurrentTime;
+
+		if (!Bounds.bAdaptive)
+		{
+			Peer.RateHz = ClampRate(Bounds.InitialRateHz);
+			continue;
+		}
+
+		if (!IsCongested(Peer, QueueFill))
+		{
+			Peer.RateHz = ClampRate(Peer.RateHz + LiveBPCongestion::IncreaseHzPerSecond * static_cast<float>(DeltaTime));
+			continue;
+		}
+
+		// Give the last decrease a round trip to take effect before cutting again
+		const double HoldTime = FMath::Max(Peer.SmoothedRtt, LiveBPCongestion::MinDecreaseInterval);
+		if (CurrentTime - Peer.LastDecreaseTime >= HoldTime)
+		{
+			Peer.RateHz = ClampRate(Peer.RateHz * LiveBPCongestion::DecreaseFactor);
+			Peer.LastDecreaseTime = CurrentTime;
+			Peer.bCongestionReported = false;
+
+			UE_LOG(LogLiveBPCore, Verbose, TEXT("Congestion towards endpoint %s (RTT %.0f ms, loss %.0f%%, queue %.0f%%); preview rate now %.1f Hz"),
+				*Pair.Key.ToString(), Peer.SmoothedRtt * 1000.0, Peer.LossRate * 100.0f, QueueFill * 100.0f, Peer.RateHz);
+		}
+	}
+}
+
+bool FLiveBPCongestionController::ShouldSend(const FGuid& PeerId, double CurrentTime)
+{
+	FPeerState* Peer = Peers.Find(PeerId);
+	if (!Peer)
+	{
+		return true;
+	}
+
+	if (CurrentTime < Peer->NextSendTime)
+	{
+		return false;
+	}
+
+	// Scheduled from the previous slot so tick-aligned sends still average out to the rate,
+	// but never so far back that an idle stream gets to burst
+	const double Interval = 1.0 / Peer->RateHz;
+	Peer->NextSendTime = FMath::Max(Peer->NextSendTime + Interval, CurrentTime + Interval * 0.5);
+	Peer->UnreliableSent++;
+	return true;
+}
+
+bool FLiveBPCongestionController::MakeHeartbeat(const FGuid& PeerId, double CurrentTime, FLiveBPHeartbeat& OutHeartbeat)
+{
+	FPeerState* Peer = Peers.Find(PeerId);
+	if (!Peer || CurrentTime < Peer->NextHeartbeatTime)
+	{
+		return false;
+	}
+
+	Peer->NextHeartbeatTime = CurrentTime + LiveBPCongestion::HeartbeatInterval;
+
+	OutHeartbeat = FLiveBPHeartbeat();
+	OutHeartbeat.SendTimeUs = ToMicroseconds(CurrentTime);
+	OutHeartbeat.UnreliableReceived = Peer->UnreliableReceived;
+
+	// Each of the peer's probes is echoed once
+	if (Peer->PeerSendTimeUs != 0)
+	{
+		OutHeartbeat.EchoTimeUs = Peer->PeerSendTimeUs;
+		OutHeartbeat.EchoDelayUs = ToMicroseconds(CurrentTime - Peer->PeerProbeReceivedTime);
+		Peer->PeerSendTimeUs = 0;
+	}
+
+	if (Peer->Probes.Num() >= LiveBPCongestion::MaxOutstandingProbes)
+	{
+		Peer->Probes.RemoveAt(0);
+	}
+	Peer->Probes.Add({ OutHeartbeat.SendTimeUs, Peer->UnreliableSent });
+
+	return true;
+}
+
+void FLiveBPCongestionController::OnHeartbeat(const FGuid& PeerId, const FLiveBPHeartbeatReceipt& Receipt)
+{
+	FPeerState* Peer = Peers.Find(PeerId);
+	if (!Peer)
+	{
+		return;
+	}
+
+	const FLiveBPHeartbeat& Heartbeat = Receipt.Heartbeat;
+	Peer->PeerSendTimeUs = Heartbeat.SendTimeUs;
+	Peer->PeerProbeReceivedTime = Receipt.ReceivedTime;
+	Peer->UnreliableReceived = Receipt.UnreliableReceived;
+
+	const int32 ProbeIndex = Heartbeat.EchoTimeUs != 0
+		? Peer->Probes.IndexOfByPredicate([&Heartbeat](const FProbe& Probe) { return Probe.SendTimeUs == Heartbeat.EchoTimeUs; })
+		: INDEX_NONE;
+	if (ProbeIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FProbe Probe = Peer->Probes[ProbeIndex];
+	Peer->Probes.RemoveAt(0, ProbeIndex + 1);
+
+	// Round trip, without the time the peer sat on our probe
+	const double Rtt = Receipt.ReceivedTime - ToSeconds(Heartbeat.EchoTimeUs) - ToSeconds(Heartbeat.EchoDelayUs);
+	if (Rtt > 0.0)
+	{
+		Peer->SmoothedRtt = Peer->SmoothedRtt > 0.0 ? Peer->SmoothedRtt * 0.875 + Rtt * 0.125 : Rtt;
+		Peer->MinRtt = Peer->MinRtt > 0.0 ? FMath::Min(Peer->MinRtt, Rtt) : Rtt;
+	}
+
+	// Loss over the window between two acknowledged probes: what we sent against what the peer got.
+	// Frames sent before a probe can reach the peer after it (the lanes are not ordered against each
+	// other), so a window's shortfall is only counted as lost if the next window does not make it up.
+	if (Peer->LastAcknowledged.SendTimeUs != 0 && Heartbeat.UnreliableReceived >= Peer->LastReportedReceived)
+	{
+		const uint64 Sent = Probe.UnreliableSent - Peer->LastAcknowledged.UnreliableSent;
+		const uint64 Received = Heartbeat.UnreliableReceived - Peer->LastReportedReceived;
+
+		// Whatever this window got beyond what it sent is the last one's stragglers
+		const uint64 Late = Received > Sent ? FMath::Min(Received - Sent, Peer->Outstanding) : 0;
+		if (Peer->OutstandingSent > 0)
+		{
+			const uint64 Lost = Peer->Outstanding - Late;
+			const float Loss = FMath::Clamp(static_cast<float>(Lost) / static_cast<float>(Peer->OutstandingSent), 0.0f, 1.0f);
+			Peer->LossRate = Peer->LossRate * 0.5f + Loss * 0.5f;
+		}
+
+		Peer->Outstanding = Sent > Received ? Sent - Received : 0;
+		Peer->OutstandingSent = Sent;
+	}
+	Peer->LastAcknowledged = Probe;
+	Peer->LastReportedReceived = Heartbeat.UnreliableReceived;
+
+	const bool bRttInflated = Peer->SmoothedRtt > Peer->MinRtt * LiveBPCongestion::RttInflationFactor
+		&& Peer->SmoothedRtt - Peer->MinRtt > LiveBPCongestion::MinRttInflation;
+	if (Peer->LossRate > LiveBPCongestion::LossThreshold || bRttInflated)
+	{
+		Peer->bCongestionReported = true;
+	}
+}
+
+FLiveBPPeerSendRate FLiveBPCongestionController::GetSendRate(const FGuid& PeerId) const
+{
+	FLiveBPPeerSendRate Rate;
+	if (const FPeerState* Peer = Peers.Find(PeerId))
+	{
+		Rate.RateHz = Peer->RateHz;
+		Rate.SmoothedRttMs = static_cast<float>(Peer->SmoothedRtt * 1000.0);
+		Rate.LossRate = Peer->LossRate;
+	}
+	return Rate;
+}
+
+void FLiveBPCongestionController::GetSendRates(TMap<FGuid, FLiveBPPeerSendRate>& OutRates) const
+{
+	OutRates.Reset();
+	for (const TPair<FGuid, FPeerState>& Pair : Peers)
+	{
+		OutRates.Add(Pair.Key, GetSendRate(Pair.Key));
+	}
+}
+
+float FLiveBPCongestionController::GetMaxRate() const
+{
+	if (Peers.Num() == 0)
+	{
+		return ClampRate(Bounds.InitialRateHz);
+	}
+
+	float MaxRate = 0.0f;
+	for (const TPair<FGuid, FPeerState>& Pair : Peers)
+	{
+		MaxRate = FMath::Max(MaxRate, Pair.Value.RateHz);
+	}
+	return MaxRate;
+}
+
+bool FLiveBPCongestionController::IsCongested(const FPeerState& Peer, float QueueFill) const
+{
+	return Peer.bCongestionReported || QueueFill > LiveBPCongestion::QueueFillThreshold;
+}
+
+float FLiveBPCongestionController::ClampRate(float RateHz) const
+{
+	return FMath::Clamp(RateHz, Bounds.MinRateHz, Bounds.MaxRateHz);
+}
@@ -0,0 +1,436 @@
+#include "LiveBPInboundPipeline.h"
+#include "LiveBPCore.h"
+#include "LiveBPUtils.h"
+#include "LiveBPOutboundBatcher.h"
+#include "LiveBPPerformanceMonitor.h"
+
+namespace LiveBPInbound
+{
+	/** The payload of a recycled message as a T, reusing the one already there (and its string capacity) when it is one */
+	template<typename T>
+	T& ResetData(FLiveBPInboundMessage::FData& Data)
+	{
+		if (!Data.IsType<T>())
+		{
+			Data.Emplace<T>();
+		}
+		return Data.Get<T>();
+	}
+}
+
+FLiveBPInboundPipeline::FLiveBPInboundPipeline()
+	: Pipe(TEXT("LiveBPInboundPipe"))
+	, Resolvable(MakeShared<FResolvableObjects, ESPMode::ThreadSafe>())
+{
+}
+
+FLiveBPInboundPipeline::~FLiveBPInboundPipeline()
+{
+	// Tasks still in the pipe reference this pipeline
+	WaitUntilIdle();
+}
+
+void FLiveBPInboundPipeline::Enqueue(const FGuid& SourceEndpointId, const TArray<uint8>& Batch)
+{
+	// Concert owns the event, so the batch is copied into a slot that keeps its capacity. A task is
+	// only launched when the queue was empty; it decodes everything queued by the time it runs.
+	const bool bWasEmpty = PendingBatches.Enqueue([&SourceEndpointId, &Batch](FPendingBatch& Slot)
+	{
+		Slot.SourceEndpointId = SourceEndpointId;
+		Slot.Data = Batch;
+	});
+
+	if (bWasEmpty)
+	{
+		Pipe.Launch(TEXT("LiveBPDecodeBatches"), [this]()
+		{
+			DecodePendingBatches();
+		});
+	}
+}
+
+void FLiveBPInboundPipeline::RemoveEndpoint(const FGuid& EndpointId)
+{
+	Pipe.Launch(TEXT("LiveBPRemoveEndpoint"), [this, EndpointId]()
+	{
+		RemoteNames.Remove(EndpointId);
+		RemoteSequences.Remove(EndpointId);
+		RemoteOperations.Remove(EndpointId);
+		UnreliableReceived.Remove(EndpointId);
+		RemoteWirePreviews.Remove(EndpointId);
+	});
+}
+
+void FLiveBPInboundPipeline::Reset()
+{
+	WaitUntilIdle();
+
+	RemoteNames.Empty();
+	RemoteSequences.Empty();
+	RemoteOperations.Empty();
+	UnreliableReceived.Empty();
+	RemoteWirePreviews.Empty();
+
+	PendingBatches.Reset();
+	Prepared.Reset();
+}
+
+void FLiveBPInboundPipeline::SetResolvableObjects(TMap<FGuid, TWeakObjectPtr<UObject>>&& Objects)
+{
+	// Batches already decoding keep the snapshot they started with
+	TSharedRef<const FResolvableObjects, ESPMode::ThreadSafe> Snapshot = MakeShared<FResolvableObjects, ESPMode::ThreadSafe>(MoveTemp(Objects));
+
+	FScopeLock Lock(&ResolvableLock);
+	Resolvable = Snapshot;
+}
+
+void FLiveBPInboundPipeline::Drain(TFunctionRef<void(FLiveBPInboundMessage& Message)> Apply)
+{
+	Prepared.Drain([&Apply](FLiveBPInboundMessage& Message)
+	{
+		Apply(Message);
+	});
+}
+
+void FLiveBPInboundPipeline::WaitUntilIdle()
+{
+	Pipe.WaitUntilEmpty();
+}
+
+void FLiveBPInboundPipeline::DecodePendingBatches()
+{
+	PendingBatches.Drain([this](FPendingBatch& Batch)
+	{
+		DecodeBatch(Batch.SourceEndpointId, Batch.Data);
+	});
+}
+
+void FLiveBPInboundPipeline::DecodeBatch(const FGuid& SourceEndpointId, TArrayView<const uint8> Batch)
+{
+	TSharedRef<FLiveBPNameTable, ESPMode::ThreadSafe>* Names = RemoteNames.Find(SourceEndpointId);
+	if (!Names)
+	{
+		Names = &RemoteNames.Add(SourceEndpointId, MakeShared<FLiveBPNameTable, ESPMode::ThreadSafe>());
+	}
+
+	if (!FLiveBPOutboundBatcher::SplitFrames(Batch, Frames))
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Dropped truncated LiveBP batch (%d bytes) from endpoint %s"),
+			Batch.Num(), *SourceEndpointId.ToString());
+		return;
+	}
+
+	TSharedPtr<const FResolvableObjects, ESPMode::ThreadSafe> Objects;
+	{
+		FScopeLock Lock(&ResolvableLock);
+		Objects = Resolvable;
+	}
+
+	for (const TArrayView<const uint8>& Frame : Frames)
+	{
+		// Stage 1: decode the envelope, which also records any definitions the frame carries
+		FLiveBPMessageView View;
+		bool bHasMessage = false;
+		FLiveBPBinaryCodec::EFrameError Error;
+		if (!FLiveBPBinaryCodec::DecodeFrame(Frame, Names->Get(), Arena, View, bHasMessage, &Error))
+		{
+			// Later frames may depend on definitions this one carried, so drop the rest of the batch too
+			if (FLiveBPBinaryCodec::HasFrameDefinitions(Frame))
+			{
+				UE_LOG(LogLiveBPCore, Warning, TEXT("Dropped malformed LiveBP frame (%d bytes) and the rest of its batch from endpoint %s"),
+					Frame.Num(), *SourceEndpointId.ToString());
+				break;
+			}
+
+			// Previews can overtake the reliable frame that defines their names, as the lanes aren't ordered against each other
+			if (Error == FLiveBPBinaryCodec::EFrameError::UndefinedHandle)
+			{
+				UE_LOG(LogLiveBPCore, Verbose, TEXT("Skipped LiveBP frame from endpoint %s that references names not defined yet"),
+					*SourceEndpointId.ToString());
+			}
+			else
+			{
+				UE_LOG(LogLiveBPCore, Warning, TEXT("Dropped malformed LiveBP frame (%d bytes) from endpoint %s"),
+					Frame.Num(), *SourceEndpointId.ToString());
+			}
+			continue;
+		}
+
+		// Definitions-only frames have nothing to deliver
+		if (!bHasMessage)
+		{
+			continue;
+		}
+
+		// Edits that were already applied must not be applied again
+		if (View.Sequence != 0 && FLiveBPOperationLog::IsLogged(View.MessageType))
+		{
+			int32 LostCount = 0;
+			const bool bDuplicate = RemoteOperations.FindOrAdd(SourceEndpointId).Accept(View.Sequence, LostCount)
+				== FLiveBPOperationLog::EAcceptResult::Duplicate;
+
+			if (LostCount > 0)
+			{
+				UE_LOG(LogLiveBPCore, Warning, TEXT("%d LiveBP operations from endpoint %s never arrived"),
+					LostCount, *SourceEndpointId.ToString());
+			}
+
+			LIVEBP_RECORD_OPERATION_RECEIVED(LostCount, bDuplicate);
+			if (bDuplicate)
+			{
+				UE_LOG(LogLiveBPCore, Verbose, TEXT("Dropped duplicate LiveBP operation %u from endpoint %s"),
+					View.Sequence, *SourceEndpointId.ToString());
+				continue;
+			}
+		}
+		// Unreliable messages that arrive behind a newer one on the same stream are already stale
+		else if (View.Sequence != 0)
+		{
+			UnreliableReceived.FindOrAdd(SourceEndpointId)++;
+
+			int32 LostCount = 0;
+			const bool bSuperseded = RemoteSequences.FindOrAdd(SourceEndpointId).Accept(
+				View.MessageType, View.BlueprintId, View.Sequence, LostCount) == FLiveBPSequenceTracker::EAcceptResult::Superseded;
+
+			LIVEBP_RECORD_UNRELIABLE_RECEIVED(LostCount, bSuperseded);
+			if (bSuperseded)
+			{
+				continue;
+			}
+		}
+
+		View.NameTable = *Names;
+
+		UE_LOG(LogLiveBPCore, VeryVerbose, TEXT("Received LiveBP message of type %d from user %s (%d byte frame)"),
+			static_cast<int32>(View.MessageType), *View.GetUserId(), Frame.Num());
+
+		if (Prepare(SourceEndpointId, View, *Objects, PreparedMessage))
+		{
+			Prepared.Enqueue([this](FLiveBPInboundMessage& Slot)
+			{
+				Swap(Slot, PreparedMessage);
+			});
+		}
+	}
+
+	// Everything decoded out of this batch is released in one go
+	Frames.Reset();
+	Arena.Reset();
+}
+
+bool FLiveBPInboundPipeline::Prepare(const FGuid& SourceEndpointId, const FLiveBPMessageView& View, const FResolvableObjects& Objects,
+	FLiveBPInboundMessage& OutMessage)
+{
+	OutMessage.MessageType = View.MessageType;
+	OutMessage.SourceEndpointId = SourceEndpointId;
+	OutMessage.BlueprintId = View.BlueprintId;
+	OutMessage.GraphId = View.GraphId;
+	OutMessage.UserId = View.GetUserId();
+	OutMessage.Timestamp = View.Timestamp;
+	OutMessage.Blueprint.Reset();
+	OutMessage.bWirePreviewEnded = false;
+
+	// Interest sets are about the sender, not a Blueprint, so they skip validation and resolution
+	if (View.MessageType == ELiveBPMessageType::Interest)
+	{
+		TArray<FGuid> BlueprintIds;
+		if (!FLiveBPBinaryCodec::DecodeInterest(View.Payload, BlueprintIds))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropped malformed interest set from %s"), *OutMessage.UserId);
+			return false;
+		}
+		OutMessage.Data.Set<TArray<FGuid>>(MoveTemp(BlueprintIds));
+		return true;
+	}
+
+	// So are heartbeats, which are about the link to the sender
+	if (View.MessageType == ELiveBPMessageType::Heartbeat)
+	{
+		FLiveBPHeartbeatReceipt Receipt;
+		if (!FLiveBPBinaryCodec::DecodeHeartbeat(View.Payload, Receipt.Heartbeat))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropped malformed heartbeat from %s"), *OutMessage.UserId);
+			return false;
+		}
+		Receipt.ReceivedTime = FPlatformTime::Seconds();
+		Receipt.UnreliableReceived = UnreliableReceived.FindRef(SourceEndpointId);
+		OutMessage.Data.Set<FLiveBPHeartbeatReceipt>(Receipt);
+		return true;
+	}
+
+	// Stage 2: validate
+	if (!FLiveBPUtils::IsValidMessage(View))
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Dropped invalid LiveBP message of type %d from %s"),
+			static_cast<int32>(View.MessageType), *OutMessage.UserId);
+		return false;
+	}
+
+	// Stage 3: resolve the Blueprint. Locks and presence are kept either way: locks are tracked by node,
+	// and a peer's view still steers what we send it.
+	const TWeakObjectPtr<UObject>* Blueprint = Objects.Find(View.BlueprintId);
+	if (Blueprint)
+	{
+		OutMessage.Blueprint = *Blueprint;
+	}
+
+	// Stage 4: decode the payload
+	switch (View.MessageType)
+	{
+	case ELiveBPMessageType::WirePreview:
+		return Blueprint && DecodeWirePreview(View, OutMessage);
+
+	case ELiveBPMessageType::NodeOperation:
+	{
+		if (!Blueprint)
+		{
+			return false;
+		}
+
+		FLiveBPNodeOperationData NodeOperation;
+		if (!FLiveBPUtils::DeserializeNodeOperation(View.Payload, NodeOperation, View.NameTable.Get()))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropping malformed node operation from %s"), *OutMessage.UserId);
+			return false;
+		}
+
+		// The binary codec leaves these to the envelope
+		NodeOperation.UserId = OutMessage.UserId;
+		NodeOperation.Timestamp = View.Timestamp;
+		OutMessage.Data.Set<FLiveBPNodeOperationData>(MoveTemp(NodeOperation));
+		return true;
+	}
+
+	case ELiveBPMessageType::NodeTransaction:
+	{
+		if (!Blueprint)
+		{
+			return false;
+		}
+
+		TArray<FLiveBPNodeOperationData> NodeOperations;
+		if (!FLiveBPBinaryCodec::DecodeNodeTransaction(View.Payload, NodeOperations, View.NameTable.Get()))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropping malformed node transaction from %s"), *OutMessage.UserId);
+			return false;
+		}
+
+		for (FLiveBPNodeOperationData& NodeOperation : NodeOperations)
+		{
+			NodeOperation.UserId = OutMessage.UserId;
+			NodeOperation.Timestamp = View.Timestamp;
+		}
+		OutMessage.Data.Set<TArray<FLiveBPNodeOperationData>>(MoveTemp(NodeOperations));
+		return true;
+	}
+
+	case ELiveBPMessageType::NodeMoves:
+	{
+		if (!Blueprint)
+		{
+			return false;
+		}
+
+		TArray<FLiveBPNodeMove> Moves;
+		if (!FLiveBPBinaryCodec::DecodeNodeMoves(View.Payload, Moves, View.NameTable.Get()))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropping malformed node moves from %s"), *OutMessage.UserId);
+			return false;
+		}
+		OutMessage.Data.Set<TArray<FLiveBPNodeMove>>(MoveTemp(Moves));
+		return true;
+	}
+
+	case ELiveBPMessageType::Presence:
+	{
+		FLiveBPPresence Presence;
+		if (!FLiveBPBinaryCodec::DecodePresence(View.Payload, Presence))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropping malformed presence update from %s"), *OutMessage.UserId);
+			return false;
+		}
+		OutMessage.Data.Set<FLiveBPPresence>(Presence);
+		return true;
+	}
+
+	case ELiveBPMessageType::LockRequest:
+	{
+		FLiveBPNodeLock LockRequest;
+		if (!FLiveBPUtils::DeserializeNodeLock(View.Payload, LockRequest, View.NameTable.Get()))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropping malformed lock message from %s"), *OutMessage.UserId);
+			return false;
+		}
+
+		if (LockRequest.UserId.IsEmpty())
+		{
+			LockRequest.UserId = OutMessage.UserId;
+		}
+		OutMessage.Data.Set<FLiveBPNodeLock>(MoveTemp(LockRequest));
+		return true;
+	}
+
+	case ELiveBPMessageType::LockSet:
+	{
+		FLiveBPNodeLockSet LockSet;
+		if (!FLiveBPBinaryCodec::DecodeNodeLockSet(View.Payload, LockSet, View.NameTable.Get()))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropping malformed lock set from %s"), *OutMessage.UserId);
+			return false;
+		}
+
+		LockSet.UserId = OutMessage.UserId;
+		OutMessage.Data.Set<FLiveBPNodeLockSet>(MoveTemp(LockSet));
+		return true;
+	}
+
+	default:
+		return false;
+	}
+}
+
+bool FLiveBPInboundPipeline::DecodeWirePreview(const FLiveBPMessageView& View, FLiveBPInboundMessage& OutMessage)
+{
+	const FString& UserId = OutMessage.UserId;
+
+	// Streamed previews are reconstructed in place from the sender's anchor and deltas
+	if (FLiveBPBinaryCodec::IsWirePreviewStreamPayload(View.Payload))
+	{
+		// Kept per endpoint like the rest of the sender's decode state, so it goes when the sender leaves
+		FLiveBPWirePreviewDecoder* Decoder = RemoteWirePreviews.Find(OutMessage.SourceEndpointId);
+		if (!Decoder)
+		{
+			Decoder = &RemoteWirePreviews.Add(OutMessage.SourceEndpointId);
+			Decoder->SetUserId(UserId);
+		}
+
+		switch (Decoder->Apply(View.Payload, View.NameTable.Get()))
+		{
+		case FLiveBPWirePreviewDecoder::EApplyResult::Invalid:
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Dropping malformed wire preview from %s"), *UserId);
+			return false;
+		case FLiveBPWirePreviewDecoder::EApplyResult::Stale:
+			return false;
+		case FLiveBPWirePreviewDecoder::EApplyResult::Ended:
+			OutMessage.bWirePreviewEnded = true;
+			break;
+		case FLiveBPWirePreviewDecoder::EApplyResult::Updated:
+			break;
+		}
+
+		LiveBPInbound::ResetData<FLiveBPWirePreview>(OutMessage.Data) = Decoder->GetWirePreview();
+		return true;
+	}
+
+	FLiveBPWirePreview WirePreview;
+	if (!FLiveBPUtils::DeserializeFromBinary(View.Payload, WirePreview, View.NameTable.Get()))
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Dropping malformed wire preview from %s"), *UserId);
+		return false;
+	}
+
+	WirePreview.UserId = UserId;
+	WirePreview.Timestamp = View.Timestamp;
+	OutMessage.Data.Set<FLiveBPWirePreview>(MoveTemp(WirePreview));
+	return true;
+}
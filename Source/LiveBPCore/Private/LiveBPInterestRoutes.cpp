@@ -0,0 +1,85 @@
+#include "LiveBPInterestRoutes.h"
+#include "LiveBPCore.h"
+
+void FLiveBPInterestRoutes::AddEndpoint(const FGuid& Endpoint)
+{
+	if (!Endpoints.Contains(Endpoint))
+	{
+		Endpoints.Add(Endpoint);
+		Rebuild();
+	}
+}
+
+void FLiveBPInterestRoutes::RemoveEndpoint(const FGuid& Endpoint)
+{
+	const int32 NumRemoved = Endpoints.Remove(Endpoint);
+	Interests.Remove(Endpoint);
+
+	if (NumRemoved > 0)
+	{
+		Rebuild();
+	}
+}
+
+void FLiveBPInterestRoutes::SetInterest(const FGuid& Endpoint, TArrayView<const FGuid> BlueprintIds)
+{
+	TArray<FGuid>& Interest = Interests.FindOrAdd(Endpoint);
+	Interest.Reset();
+	Interest.Append(BlueprintIds.GetData(), BlueprintIds.Num());
+
+	Rebuild();
+}
+
+const TArray<FGuid>& FLiveBPInterestRoutes::GetEndpoints(const FGuid& BlueprintId) const
+{
+	if (const TArray<FGuid>* Route = RoutesByBlueprint.Find(BlueprintId))
+	{
+		return *Route;
+	}
+
+	// Nobody declared interest in it, so only the undeclared peers might care
+	return UndeclaredEndpoints;
+}
+
+void FLiveBPInterestRoutes::Reset()
+{
+	Endpoints.Reset();
+	Interests.Reset();
+	RoutesByBlueprint.Reset();
+	UndeclaredEndpoints.Reset();
+}
+
+void FLiveBPInterestRoutes::Rebuild()
+{
+	// Interest changes are rare (a Blueprint opened or closed), so rebuild everything and keep
+	// lookups trivial
+	RoutesByBlueprint.Reset();
+	UndeclaredEndpoints.Reset();
+
+	for (const FGuid& Endpoint : Endpoints)
+	{
+		if (!Interests.Contains(Endpoint))
+		{
+			UndeclaredEndpoints.Add(Endpoint);
+		}
+	}
+
+	for (const FGuid& Endpoint : Endpoints)
+	{
+		const TArray<FGuid>* Interest = Interests.Find(Endpoint);
+		if (!Interest)
+		{
+			continue;
+		}
+
+		for (const FGuid& BlueprintId : *Interest)
+		{
+			TArray<FGuid>* Route = RoutesByBlueprint.Find(BlueprintId);
+			if (!Route)
+			{
+				Route = &RoutesByBlueprint.Add(BlueprintId, UndeclaredEndpoints);
+			}
+			Route->AddUnique(Endpoint);
+		}
+	}
+}
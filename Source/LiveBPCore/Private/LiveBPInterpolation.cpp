@@ -0,0 +1,91 @@
+#include "LiveBPInterpolation.h"
+
+namespace LiveBPInterpolation
+{
+	// Samples closer together than this are treated as one
+	static const double MinSampleSpacing = 0.001;
+}
+
+FLiveBPInterpolationBuffer::FLiveBPInterpolationBuffer()
+{
+}
+
+void FLiveBPInterpolationBuffer::AddSample(double Time, const FVector2D& Position, const FLiveBPPlayoutSettings& Settings)
+{
+	if (!Samples.IsEmpty() && Time - Samples.Last().Time < LiveBPInterpolation::MinSampleSpacing)
+	{
+		Samples.Last().Position = Position;
+		return;
+	}
+
+	// Playback already ran past the newest sample (the stream stood still, or an update was late), so
+	// continue from where it is drawn now rather than jumping back or crawling across the whole gap
+	const double PlayoutTime = Time - Settings.Delay;
+	if (!Samples.IsEmpty() && Settings.Delay > LiveBPInterpolation::MinSampleSpacing && PlayoutTime > Samples.Last().Time)
+	{
+		const FVector2D Drawn = Evaluate(Time, Settings);
+		Samples.Reset();
+		Samples.Add({ PlayoutTime, Drawn });
+	}
+
+	if (Samples.Num() >= MaxSamples)
+	{
+		Samples.PopFront();
+	}
+	Samples.Add({ Time, Position });
+}
+
+FVector2D FLiveBPInterpolationBuffer::Evaluate(double CurrentTime, const FLiveBPPlayoutSettings& Settings) const
+{
+	if (Samples.IsEmpty())
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const double PlayoutTime = CurrentTime - Settings.Delay;
+	const FSample& Newest = Samples.Last();
+
+	// Behind everything we still have (just started, or a long delay)
+	if (PlayoutTime <= Samples.First().Time)
+	{
+		return Samples.First().Position;
+	}
+
+	// Caught up with the newest sample: project along the last segment for a little while
+	if (PlayoutTime >= Newest.Time)
+	{
+		if (Samples.Num() < 2)
+		{
+			return Newest.Position;
+		}
+
+		const FSample& Previous = Samples[Samples.Num() - 2];
+		const FVector2D Velocity = (Newest.Position - Previous.Position) / (Newest.Time - Previous.Time);
+		const double Ahead = FMath::Min(PlayoutTime - Newest.Time, Settings.MaxExtrapolation);
+		return Newest.Position + Velocity * Ahead;
+	}
+
+	// Playout time is nearly always in the last few segments, so search from the newest end
+	for (int32 Index = Samples.Num() - 1; Index > 0; --Index)
+	{
+		const FSample& From = Samples[Index - 1];
+		if (From.Time <= PlayoutTime)
+		{
+			const FSample& To = Samples[Index];
+			const double Alpha = (PlayoutTime - From.Time) / (To.Time - From.Time);
+			return FMath::Lerp(From.Position, To.Position, Alpha);
+		}
+	}
+
+	return Samples.First().Position;
+}
+
+bool FLiveBPInterpolationBuffer::IsMoving(double CurrentTime, const FLiveBPPlayoutSettings& Settings) const
+{
+	return Samples.Num() > 1 && CurrentTime - Settings.Delay < GetLastSampleTime() + Settings.MaxExtrapolation;
+}
+
+void FLiveBPInterpolationBuffer::Reset()
+{
+	Samples.Reset();
+}
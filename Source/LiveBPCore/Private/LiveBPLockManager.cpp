@@ -1,18 +1,22 @@
 #include "LiveBPLockManager.h"
 #include "LiveBPCore.h"
+#include "Algo/Unique.h"
 
 ULiveBPLockManager::ULiveBPLockManager()
+	: CurrentTime(0.0)
 {
 }
 
-bool ULiveBPLockManager::RequestLock(const FGuid& NodeId, const FString& UserId, float LockDuration)
+bool ULiveBPLockManager::RequestLock(const FGuid& NodeId, const FString& UserId, float LockDuration,
+	const FGuid& BlueprintId, const FGuid& GraphId)
 {
 	if (NodeId.IsValid() == false || UserId.IsEmpty())
 	{
 		return false;
 	}
 
-	const float CurrentTime = FPlatformTime::Seconds();
+	RefreshClock();
+	SetScope(NodeId, BlueprintId, GraphId);
 	
 	// Check if node is already locked
 	if (FLiveBPNodeLock* ExistingLock = NodeLocks.Find(NodeId))
@@ -26,6 +30,7 @@ bool ULiveBPLockManager::RequestLock(const FGuid& NodeId, const FString& UserId,
 		else if (ExistingLock->UserId == UserId)
 		{
 			ExistingLock->ExpiryTime = CurrentTime + LockDuration;
+			ScheduleExpiry(*ExistingLock);
 			OnNodeLockStateChanged.Broadcast(NodeId, *ExistingLock);
 			return true;
 		}
@@ -39,7 +44,7 @@ bool ULiveBPLockManager::RequestLock(const FGuid& NodeId, const FString& UserId,
 			PendingRequest.LockTime = CurrentTime;
 			PendingRequest.ExpiryTime = CurrentTime + LockDuration;
 
-			PendingLockRequests.FindOrAdd(NodeId).Add(PendingRequest);
+			AddPendingRequest(PendingRequest);
 			return false; // Request is pending
 		}
 	}
@@ -64,19 +69,61 @@ bool ULiveBPLockManager::ReleaseLock(const FGuid& NodeId, const FString& UserId)
 		return false;
 	}
 
-	NodeLocks.Remove(NodeId);
-	
 	// Notify about lock release
-	FLiveBPNodeLock ReleasedLock = *ExistingLock;
+	FLiveBPNodeLock ReleasedLock;
+	RemoveLock(NodeId, ReleasedLock);
 	ReleasedLock.LockState = ELiveBPLockState::Unlocked;
 	OnNodeLockStateChanged.Broadcast(NodeId, ReleasedLock);
 
 	// Process pending requests
 	ProcessPendingRequests(NodeId);
+	ForgetIdleScope(NodeId);
 	
 	return true;
 }
 
+FLiveBPLockSetResult ULiveBPLockManager::RequestLocks(TArrayView<const FGuid> NodeIds, const FString& UserId, float LockDuration,
+	const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	FLiveBPLockSetResult Result;
+	if (UserId.IsEmpty())
+	{
+		return Result;
+	}
+
+	RefreshClock();
+	TArray<FGuid> OrderedIds = GetCanonicalOrder(NodeIds);
+
+	// Check the whole set before taking anything
+	for (const FGuid& NodeId : OrderedIds)
+	{
+		if (IsLocked(NodeId) && !IsLockedByUser(NodeId, UserId))
+		{
+			Result.Conflicts.Add(NodeId);
+		}
+	}
+
+	if (Result.Conflicts.Num() > 0)
+	{
+		return Result;
+	}
+
+	for (const FGuid& NodeId : OrderedIds)
+	{
+		RequestLock(NodeId, UserId, LockDuration, BlueprintId, GraphId);
+	}
+	Result.Granted = MoveTemp(OrderedIds);
+	return Result;
+}
+
+void ULiveBPLockManager::ReleaseLocks(TArrayView<const FGuid> NodeIds, const FString& UserId)
+{
+	for (const FGuid& NodeId : GetCanonicalOrder(NodeIds))
+	{
+		ReleaseLock(NodeId, UserId);
+	}
+}
+
 bool ULiveBPLockManager::IsLocked(const FGuid& NodeId) const
 {
 	const FLiveBPNodeLock* Lock = NodeLocks.Find(NodeId);
@@ -100,8 +147,8 @@ ELiveBPLockState ULiveBPLockManager::GetLockState(const FGuid& NodeId) const
 	if (!Lock)
 	{
 		// Check if there are pending requests
-		const TArray<FLiveBPNodeLock>* PendingRequests = PendingLockRequests.Find(NodeId);
-		if (PendingRequests && PendingRequests->Num() > 0)
+		const FWaitQueue* PendingRequests = PendingLockRequests.Find(NodeId);
+		if (PendingRequests && !PendingRequests->Requests.IsEmpty())
 		{
 			return ELiveBPLockState::Pending;
 		}
@@ -125,26 +172,58 @@ float ULiveBPLockManager::GetLockTimeRemaining(const FGuid& NodeId) const
 		return 0.0f;
 	}
 
-	return FMath::Max(0.0f, Lock->ExpiryTime - FPlatformTime::Seconds());
+	return static_cast<float>(FMath::Max(0.0, Lock->ExpiryTime - CurrentTime));
+}
+
+const FLiveBPNodeLock* ULiveBPLockManager::FindLock(const FGuid& NodeId) const
+{
+	const FLiveBPNodeLock* Lock = NodeLocks.Find(NodeId);
+	return Lock && !IsLockExpired(*Lock) ? Lock : nullptr;
+}
+
+void ULiveBPLockManager::GetUserLocks(const FString& UserId, TArray<FGuid>& OutNodeIds) const
+{
+	GetIndexed(LocksByUser.Find(UserId), OutNodeIds);
+}
+
+void ULiveBPLockManager::GetBlueprintLocks(const FGuid& BlueprintId, TArray<FGuid>& OutNodeIds) const
+{
+	GetIndexed(LocksByBlueprint.Find(BlueprintId), OutNodeIds);
+}
+
+void ULiveBPLockManager::GetGraphLocks(const FGuid& GraphId, TArray<FGuid>& OutNodeIds) const
+{
+	GetIndexed(LocksByGraph.Find(GraphId), OutNodeIds);
 }
 
-void ULiveBPLockManager::HandleRemoteLockRequest(const FLiveBPNodeLock& LockRequest)
+void ULiveBPLockManager::HandleRemoteLockRequest(const FLiveBPNodeLock& LockRequest, const FGuid& BlueprintId, const FGuid& GraphId)
 {
+	RefreshClock();
+	SetScope(LockRequest.NodeId, BlueprintId, GraphId);
+
 	if (LockRequest.LockState == ELiveBPLockState::Locked)
 	{
+		FLiveBPNodeLock LocalRequest = LockRequest;
+		LocalRequest.LockTime = CurrentTime;
+		LocalRequest.ExpiryTime = CurrentTime + FMath::Max(0.0, LockRequest.ExpiryTime - LockRequest.LockTime);
+
+		FLiveBPNodeLock* ExistingLock = NodeLocks.Find(LockRequest.NodeId);
+
 		// Try to grant the remote lock request
 		if (!IsLocked(LockRequest.NodeId))
 		{
-			GrantLock(LockRequest.NodeId, LockRequest);
+			GrantLock(LockRequest.NodeId, LocalRequest);
+		}
+		// The holder renewing its lock
+		else if (ExistingLock->UserId == LockRequest.UserId)
+		{
+			ExistingLock->ExpiryTime = LocalRequest.ExpiryTime;
+			ScheduleExpiry(*ExistingLock);
+			OnNodeLockStateChanged.Broadcast(LockRequest.NodeId, *ExistingLock);
 		}
 		else
 		{
-			// Add to pending if not already locked by same user
-			const FLiveBPNodeLock* ExistingLock = NodeLocks.Find(LockRequest.NodeId);
-			if (ExistingLock && ExistingLock->UserId != LockRequest.UserId)
-			{
-				PendingLockRequests.FindOrAdd(LockRequest.NodeId).Add(LockRequest);
-			}
+			AddPendingRequest(LocalRequest);
 		}
 	}
 	else if (LockRequest.LockState == ELiveBPLockState::Unlocked)
@@ -159,31 +238,105 @@ void ULiveBPLockManager::HandleRemoteLockRelease(const FLiveBPNodeLock& LockRele
 	ReleaseLock(LockRelease.NodeId, LockRelease.UserId);
 }
 
-void ULiveBPLockManager::UpdateLocks(float DeltaTime)
+FLiveBPLockSetResult ULiveBPLockManager::HandleRemoteLockSet(const FLiveBPNodeLockSet& LockSet, const FGuid& BlueprintId, const FGuid& GraphId)
 {
-	const float CurrentTime = FPlatformTime::Seconds();
-	TArray<FGuid> ExpiredLocks;
+	if (LockSet.LockState != ELiveBPLockState::Locked)
+	{
+		ReleaseLocks(LockSet.NodeIds, LockSet.UserId);
+		return FLiveBPLockSetResult();
+	}
+
+	FLiveBPLockSetResult Result = RequestLocks(LockSet.NodeIds, LockSet.UserId, LockSet.Duration, BlueprintId, GraphId);
+	if (Result.IsGranted())
+	{
+		return Result;
+	}
 
-	// Check for expired locks
-	for (auto& LockPair : NodeLocks)
+	// Refused when any holder sorts first; that holder's own set wins wherever it arrives
+	TSet<FString> Holders;
+	for (const FGuid& NodeId : Result.Conflicts)
 	{
-		if (IsLockExpired(LockPair.Value))
+		const FString Holder = GetLockOwner(NodeId);
+		if (Holder.Compare(LockSet.UserId, ESearchCase::CaseSensitive) < 0)
 		{
-			ExpiredLocks.Add(LockPair.Key);
+			ReleaseGraphLocks(LockSet.UserId, GraphId, Result.Preempted);
+			Result.Preempted.Sort();
+			return Result;
 		}
-		// Extend locks that are about to expire (if user is still active)
-		else if (GetLockTimeRemaining(LockPair.Key) < LOCK_EXTENSION_TIME)
+		Holders.Add(Holder);
+	}
+
+	// The contested nodes skip their wait queues, since the winner takes them next
+	TArray<FGuid> Preempted;
+	for (const FGuid& NodeId : Result.Conflicts)
+	{
+		FLiveBPNodeLock ReleasedLock;
+		RemoveLock(NodeId, ReleasedLock);
+		ReleasedLock.LockState = ELiveBPLockState::Unlocked;
+		OnNodeLockStateChanged.Broadcast(NodeId, ReleasedLock);
+		Preempted.Add(NodeId);
+	}
+	for (const FString& Holder : Holders)
+	{
+		ReleaseGraphLocks(Holder, GraphId, Preempted);
+	}
+
+	Result = RequestLocks(LockSet.NodeIds, LockSet.UserId, LockSet.Duration, BlueprintId, GraphId);
+	Preempted.Sort();
+	Result.Preempted = MoveTemp(Preempted);
+	return Result;
+}
+
+void ULiveBPLockManager::ReleaseGraphLocks(const FString& UserId, const FGuid& GraphId, TArray<FGuid>& OutNodeIds)
+{
+	if (!GraphId.IsValid())
+	{
+		return;
+	}
+
+	TArray<FGuid> HeldIds;
+	GetUserLocks(UserId, HeldIds);
+	for (const FGuid& NodeId : HeldIds)
+	{
+		const FLockScope* Scope = LockScopes.Find(NodeId);
+		if (Scope && Scope->GraphId == GraphId && ReleaseLock(NodeId, UserId))
 		{
-			// Here you could implement logic to check if user is still active
-			// For now, we'll let locks expire naturally
+			OutNodeIds.Add(NodeId);
 		}
 	}
+}
+
+void ULiveBPLockManager::UpdateLocks(float DeltaTime)
+{
+	RefreshClock();
+
+	// Only the locks that are due come off the heap
+	while (ExpiryHeap.Num() > 0 && CurrentTime > ExpiryHeap.HeapTop().ExpiryTime)
+	{
+		FLockExpiry Expiry;
+		ExpiryHeap.HeapPop(Expiry, EAllowShrinking::No);
+
+		// Released, extended or granted again since this entry was pushed
+		const FLiveBPNodeLock* Lock = NodeLocks.Find(Expiry.NodeId);
+		if (!Lock || Lock->ExpiryTime != Expiry.ExpiryTime)
+		{
+			continue;
+		}
+
+		ExpireLock(Expiry.NodeId);
+		ProcessPendingRequests(Expiry.NodeId);
+		ForgetIdleScope(Expiry.NodeId);
+	}
 
-	// Remove expired locks
-	for (const FGuid& NodeId : ExpiredLocks)
+	// Locks extended over and over would otherwise grow the heap without bound
+	if (ExpiryHeap.Num() > 2 * NodeLocks.Num() + 64)
 	{
-		ExpireLock(NodeId);
-		ProcessPendingRequests(NodeId);
+		ExpiryHeap.Reset();
+		for (const TPair<FGuid, FLiveBPNodeLock>& LockPair : NodeLocks)
+		{
+			ExpiryHeap.Add({ LockPair.Value.ExpiryTime, LockPair.Key });
+		}
+		ExpiryHeap.Heapify();
 	}
 }
 
@@ -194,6 +347,12 @@ void ULiveBPLockManager::ClearAllLocks()
 
 	NodeLocks.Empty();
 	PendingLockRequests.Empty();
+	ExpiryHeap.Empty();
+	LockScopes.Empty();
+	LocksByUser.Empty();
+	LocksByBlueprint.Empty();
+	LocksByGraph.Empty();
+	WaitingByUser.Empty();
 
 	// Notify about all lock releases
 	for (const FGuid& NodeId : AllNodeIds)
@@ -207,67 +366,248 @@ void ULiveBPLockManager::ClearAllLocks()
 
 void ULiveBPLockManager::ClearUserLocks(const FString& UserId)
 {
-	TArray<FGuid> UserLockedNodes;
-	
-	// Find all nodes locked by this user
-	for (const auto& LockPair : NodeLocks)
+	// Leave the queues first, so none of the user's locks is handed straight back to them
+	TSet<FGuid> WaitingNodes;
+	if (WaitingByUser.RemoveAndCopyValue(UserId, WaitingNodes))
 	{
-		if (LockPair.Value.UserId == UserId)
+		for (const FGuid& NodeId : WaitingNodes)
 		{
-			UserLockedNodes.Add(LockPair.Key);
+			FWaitQueue* Queue = PendingLockRequests.Find(NodeId);
+			if (!Queue || Queue->Users.Remove(UserId) == 0)
+			{
+				continue;
+			}
+
+			// Keeping everyone else's order
+			TRingBuffer<FLiveBPNodeLock> Remaining;
+			for (FLiveBPNodeLock& Request : Queue->Requests)
+			{
+				if (Request.UserId != UserId)
+				{
+					Remaining.Add(MoveTemp(Request));
+				}
+			}
+			Queue->Requests = MoveTemp(Remaining);
+
+			if (Queue->Requests.IsEmpty())
+			{
+				PendingLockRequests.Remove(NodeId);
+			}
 		}
 	}
 
 	// Release all user's locks
+	TArray<FGuid> UserLockedNodes;
+	GetUserLocks(UserId, UserLockedNodes);
 	for (const FGuid& NodeId : UserLockedNodes)
 	{
 		ReleaseLock(NodeId, UserId);
 	}
+}
+
+void ULiveBPLockManager::ClearBlueprintLocks(const FGuid& BlueprintId)
+{
+	TArray<FGuid> BlueprintLockedNodes;
+	GetBlueprintLocks(BlueprintId, BlueprintLockedNodes);
+	for (const FGuid& NodeId : BlueprintLockedNodes)
+	{
+		ClearNodeLock(NodeId);
+	}
+}
+
+void ULiveBPLockManager::ClearNodeLock(const FGuid& NodeId)
+{
+	// Nobody gets to wait for a node that is gone
+	RemoveWaitQueue(NodeId);
 
-	// Remove user's pending requests
-	for (auto& PendingPair : PendingLockRequests)
+	FLiveBPNodeLock ReleasedLock;
+	if (RemoveLock(NodeId, ReleasedLock))
 	{
-		PendingPair.Value.RemoveAll([&UserId](const FLiveBPNodeLock& Lock) {
-			return Lock.UserId == UserId;
-		});
+		ReleasedLock.LockState = ELiveBPLockState::Unlocked;
+		OnNodeLockStateChanged.Broadcast(NodeId, ReleasedLock);
 	}
+	LockScopes.Remove(NodeId);
 }
 
 void ULiveBPLockManager::ProcessPendingRequests(const FGuid& NodeId)
 {
-	TArray<FLiveBPNodeLock>* PendingRequests = PendingLockRequests.Find(NodeId);
-	if (!PendingRequests || PendingRequests->Num() == 0)
+	FWaitQueue* PendingRequests = PendingLockRequests.Find(NodeId);
+	if (!PendingRequests || PendingRequests->Requests.IsEmpty())
 	{
 		return;
 	}
 
 	// Grant lock to first pending request (FIFO)
-	FLiveBPNodeLock NextLock = (*PendingRequests)[0];
-	PendingRequests->RemoveAt(0);
+	FLiveBPNodeLock NextLock = PendingRequests->Requests.PopFrontValue();
+	PendingRequests->Users.Remove(NextLock.UserId);
+	if (TSet<FGuid>* WaitingNodes = WaitingByUser.Find(NextLock.UserId))
+	{
+		WaitingNodes->Remove(NodeId);
+		if (WaitingNodes->Num() == 0)
+		{
+			WaitingByUser.Remove(NextLock.UserId);
+		}
+	}
 
-	// Clean up empty pending arrays
-	if (PendingRequests->Num() == 0)
+	// Clean up empty queues
+	if (PendingRequests->Requests.IsEmpty())
 	{
 		PendingLockRequests.Remove(NodeId);
 	}
 
+	// The requested duration runs from now, not from when the user started waiting
+	const double LockDuration = NextLock.ExpiryTime - NextLock.LockTime;
+	NextLock.LockTime = CurrentTime;
+	NextLock.ExpiryTime = CurrentTime + LockDuration;
+
 	// Grant the lock
 	GrantLock(NodeId, NextLock);
 }
 
+void ULiveBPLockManager::RefreshClock()
+{
+	CurrentTime = FPlatformTime::Seconds();
+}
+
+void ULiveBPLockManager::AddPendingRequest(const FLiveBPNodeLock& LockRequest)
+{
+	// Asking again while waiting keeps the original place in the queue
+	FWaitQueue& Queue = PendingLockRequests.FindOrAdd(LockRequest.NodeId);
+	bool bAlreadyWaiting = false;
+	Queue.Users.Add(LockRequest.UserId, &bAlreadyWaiting);
+	if (!bAlreadyWaiting)
+	{
+		Queue.Requests.Add(LockRequest);
+		WaitingByUser.FindOrAdd(LockRequest.UserId).Add(LockRequest.NodeId);
+	}
+}
+
+void ULiveBPLockManager::SetScope(const FGuid& NodeId, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	// A node stays where it is, and a lock may be indexed under its scope already
+	if (BlueprintId.IsValid() && !LockScopes.Contains(NodeId))
+	{
+		LockScopes.Add(NodeId, { BlueprintId, GraphId });
+	}
+}
+
+void ULiveBPLockManager::ForgetIdleScope(const FGuid& NodeId)
+{
+	if (!NodeLocks.Contains(NodeId) && !PendingLockRequests.Contains(NodeId))
+	{
+		LockScopes.Remove(NodeId);
+	}
+}
+
+void ULiveBPLockManager::AddLock(const FGuid& NodeId, const FLiveBPNodeLock& Lock)
+{
+	// An expired lock that nobody cleaned up yet is replaced
+	FLiveBPNodeLock Replaced;
+	RemoveLock(NodeId, Replaced);
+
+	NodeLocks.Add(NodeId, Lock);
+	LocksByUser.FindOrAdd(Lock.UserId).Add(NodeId);
+	if (const FLockScope* Scope = LockScopes.Find(NodeId))
+	{
+		LocksByBlueprint.FindOrAdd(Scope->BlueprintId).Add(NodeId);
+		if (Scope->GraphId.IsValid())
+		{
+			LocksByGraph.FindOrAdd(Scope->GraphId).Add(NodeId);
+		}
+	}
+}
+
+bool ULiveBPLockManager::RemoveLock(const FGuid& NodeId, FLiveBPNodeLock& OutLock)
+{
+	if (!NodeLocks.RemoveAndCopyValue(NodeId, OutLock))
+	{
+		return false;
+	}
+
+	auto RemoveFromIndex = [&NodeId](auto& Index, const auto& Key)
+	{
+		if (auto* NodeIds = Index.Find(Key))
+		{
+			NodeIds->Remove(NodeId);
+			if (NodeIds->Num() == 0)
+			{
+				Index.Remove(Key);
+			}
+		}
+	};
+
+	RemoveFromIndex(LocksByUser, OutLock.UserId);
+	if (const FLockScope* Scope = LockScopes.Find(NodeId))
+	{
+		RemoveFromIndex(LocksByBlueprint, Scope->BlueprintId);
+		RemoveFromIndex(LocksByGraph, Scope->GraphId);
+	}
+	return true;
+}
+
+void ULiveBPLockManager::RemoveWaitQueue(const FGuid& NodeId)
+{
+	FWaitQueue Queue;
+	if (!PendingLockRequests.RemoveAndCopyValue(NodeId, Queue))
+	{
+		return;
+	}
+
+	for (const FString& UserId : Queue.Users)
+	{
+		if (TSet<FGuid>* WaitingNodes = WaitingByUser.Find(UserId))
+		{
+			WaitingNodes->Remove(NodeId);
+			if (WaitingNodes->Num() == 0)
+			{
+				WaitingByUser.Remove(UserId);
+			}
+		}
+	}
+}
+
+void ULiveBPLockManager::GetIndexed(const TSet<FGuid>* NodeIds, TArray<FGuid>& OutNodeIds)
+{
+	OutNodeIds.Reset();
+	if (NodeIds)
+	{
+		OutNodeIds = NodeIds->Array();
+	}
+}
+
+TArray<FGuid> ULiveBPLockManager::GetCanonicalOrder(TArrayView<const FGuid> NodeIds)
+{
+	TArray<FGuid> OrderedIds;
+	OrderedIds.Reserve(NodeIds.Num());
+	for (const FGuid& NodeId : NodeIds)
+	{
+		if (NodeId.IsValid())
+		{
+			OrderedIds.Add(NodeId);
+		}
+	}
+
+	OrderedIds.Sort();
+	OrderedIds.SetNum(Algo::Unique(OrderedIds), EAllowShrinking::No);
+	return OrderedIds;
+}
+
+void ULiveBPLockManager::ScheduleExpiry(const FLiveBPNodeLock& Lock)
+{
+	ExpiryHeap.HeapPush({ Lock.ExpiryTime, Lock.NodeId });
+}
+
 bool ULiveBPLockManager::IsLockExpired(const FLiveBPNodeLock& Lock) const
 {
-	return FPlatformTime::Seconds() > Lock.ExpiryTime;
+	return CurrentTime > Lock.ExpiryTime;
 }
 
 void ULiveBPLockManager::ExpireLock(const FGuid& NodeId)
 {
-	if (FLiveBPNodeLock* Lock = NodeLocks.Find(NodeId))
+	FLiveBPNodeLock ExpiredLock;
+	if (RemoveLock(NodeId, ExpiredLock))
 	{
-		FLiveBPNodeLock ExpiredLock = *Lock;
 		ExpiredLock.LockState = ELiveBPLockState::Unlocked;
-		
-		NodeLocks.Remove(NodeId);
 		OnNodeLockStateChanged.Broadcast(NodeId, ExpiredLock);
 		
 		UE_LOG(LogLiveBPCore, Log, TEXT("Lock expired for node %s (user: %s)"), 
@@ -280,7 +620,8 @@ void ULiveBPLockManager::GrantLock(const FGuid& NodeId, const FLiveBPNodeLock& L
 	FLiveBPNodeLock GrantedLock = LockRequest;
 	GrantedLock.LockState = ELiveBPLockState::Locked;
 	
-	NodeLocks.Add(NodeId, GrantedLock);
+	AddLock(NodeId, GrantedLock);
+	ScheduleExpiry(GrantedLock);
 	OnNodeLockStateChanged.Broadcast(NodeId, GrantedLock);
 	
 	UE_LOG(LogLiveBPCore, Log, TEXT("Lock granted for node %s to user %s"), 
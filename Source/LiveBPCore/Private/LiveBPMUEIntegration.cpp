@@ -1,58 +1,27 @@
 #include "LiveBPMUEIntegration.h"
 #include "LiveBPCore.h"
+#include "LiveBPUtils.h"
+#include "LiveBPPerformanceMonitor.h"
+#include "LiveBPMessageThrottler.h"
 #include "IConcertSyncClientModule.h"
 #include "IConcertSyncClient.h"
 #include "IConcertClientSession.h"
 #include "ConcertMessages.h"
 #include "ConcertSessionMessages.h"
-#include "Serialization/MemoryWriter.h"
-#include "Serialization/MemoryReader.h"
-#include "Dom/JsonObject.h"
-#include "Serialization/JsonSerializer.h"
-#include "Serialization/JsonWriter.h"
 #include "Engine/Engine.h"
 #include "Misc/DateTime.h"
+#include "Misc/CoreDelegates.h"
 // Additional headers required for UE 5.5
 #include "Modules/ModuleManager.h"
 #include "HAL/PlatformFileManager.h"
 #include "Misc/Paths.h"
 #include "Templates/SharedPointer.h"
 
-// Define the static channel constants
-const FString ULiveBPMUEIntegration::LiveBPWirePreviewChannel = TEXT("LiveBP.WirePreview");
-const FString ULiveBPMUEIntegration::LiveBPNodeOperationChannel = TEXT("LiveBP.NodeOperation");
-const FString ULiveBPMUEIntegration::LiveBPLockRequestChannel = TEXT("LiveBP.LockRequest");
-
-// Custom Concert event structure for LiveBP messages
-USTRUCT()
-struct FLiveBPConcertEvent
-{
-	GENERATED_BODY()
-
-	UPROPERTY()
-	FString Channel;
-
-	UPROPERTY()
-	FLiveBPMessage Message;
-
-	FLiveBPConcertEvent()
-	{
-	}
-
-	FLiveBPConcertEvent(const FString& InChannel, const FLiveBPMessage& InMessage)
-		: Channel(InChannel), Message(InMessage)
-	{
-	}
-};
-
-template<>
-struct TStructOpsTypeTraits<FLiveBPConcertEvent> : public TStructOpsTypeTraitsBase2<FLiveBPConcertEvent>
-{
-	enum { WithSerializer = true };
-};
-
 ULiveBPMUEIntegration::ULiveBPMUEIntegration()
 	: ConcertSyncClient(nullptr)
+	, bUseOutboundWorker(true)
+	, bWirePreviewStreamActive(false)
+	, GameThreadSendCycles(0)
 	, bIsInitialized(false)
 	, CurrentUserId(TEXT(""))
 {
@@ -86,10 +55,18 @@ bool ULiveBPMUEIntegration::InitializeConcertIntegration()
 		return false;
 	}
 
+	InboundPipeline = MakeUnique<FLiveBPInboundPipeline>();
+	OutboundWorker = MakeUnique<FLiveBPOutboundWorker>();
+	OutboundWorker->SetThreaded(bUseOutboundWorker);
+	PushOutboundSettings();
+
 	// Set up session event handlers
 	ConcertSyncClient->OnSessionStartup().AddUObject(this, &ULiveBPMUEIntegration::OnSessionStartup);
 	ConcertSyncClient->OnSessionShutdown().AddUObject(this, &ULiveBPMUEIntegration::OnSessionShutdown);
 
+	// Messages produced during a tick leave together once it ends
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &ULiveBPMUEIntegration::OnEndFrame);
+
 	// Check if we already have an active session
 	if (TSharedPtr<IConcertClientSession> ExistingSession = ConcertSyncClient->GetCurrentSession())
 	{
@@ -106,6 +83,15 @@ void ULiveBPMUEIntegration::ShutdownConcertIntegration()
 {
 	if (bIsInitialized && ConcertSyncClient)
 	{
+		if (ActiveSession.IsValid())
+		{
+			EnqueueOutbound({ FLiveBPOutboundCommand::EKind::EndSession });
+			FlushOutgoingMessages();
+		}
+
+		FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+		EndFrameHandle.Reset();
+
 		// Unregister from session events
 		ConcertSyncClient->OnSessionStartup().RemoveAll(this);
 		ConcertSyncClient->OnSessionShutdown().RemoveAll(this);
@@ -114,11 +100,16 @@ void ULiveBPMUEIntegration::ShutdownConcertIntegration()
 		if (ActiveSession.IsValid())
 		{
 			ActiveSession->UnregisterCustomEventHandler<FLiveBPConcertEvent>();
+			ActiveSession->OnSessionClientChanged().RemoveAll(this);
 		}
 
 		ActiveSession.Reset();
+		RemoteUserNames.Reset();
+		InboundPipeline.Reset();
+		OutboundWorker.Reset();
 		ConcertSyncClient = nullptr;
 		bIsInitialized = false;
+		bWirePreviewStreamActive = false;
 		CurrentUserId.Empty();
 
 		UE_LOG(LogLiveBPCore, Log, TEXT("LiveBP Concert integration shutdown"));
@@ -138,8 +129,21 @@ void ULiveBPMUEIntegration::OnSessionStartup(TSharedRef<IConcertClientSession> I
 		CurrentUserId = FString::Printf(TEXT("User_%s"), *FGuid::NewGuid().ToString());
 	}
 
+	// Handles are only meaningful within one session
+	InboundPipeline->Reset();
+	RebuildRemoteUsers();
+	bWirePreviewStreamActive = false;
+
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::StartSession };
+	FLiveBPOutboundSession Session;
+	Session.UserId = CurrentUserId;
+	RemoteUserNames.GenerateKeyArray(Session.Endpoints);
+	Command.Data.Set<FLiveBPOutboundSession>(MoveTemp(Session));
+	EnqueueOutbound(MoveTemp(Command));
+
 	// Register custom event handler for LiveBP messages
 	InSession->RegisterCustomEventHandler<FLiveBPConcertEvent>(this, &ULiveBPMUEIntegration::OnCustomEventReceived);
+	InSession->OnSessionClientChanged().AddUObject(this, &ULiveBPMUEIntegration::OnSessionClientChanged);
 
 	UE_LOG(LogLiveBPCore, Log, TEXT("LiveBP joined Concert session as user: %s"), *CurrentUserId);
 }
@@ -148,57 +152,314 @@ void ULiveBPMUEIntegration::OnSessionShutdown(TSharedRef<IConcertClientSession>
 {
 	if (ActiveSession.IsValid() && ActiveSession.Get() == &InSession.Get())
 	{
+		// The pipeline hands over what it still holds before it forgets the session
+		EnqueueOutbound({ FLiveBPOutboundCommand::EKind::EndSession });
+		FlushOutgoingMessages();
+
 		// Unregister custom event handler
 		InSession->UnregisterCustomEventHandler<FLiveBPConcertEvent>();
+		InSession->OnSessionClientChanged().RemoveAll(this);
 		
 		ActiveSession.Reset();
+		InboundPipeline->Reset();
+		RebuildRemoteUsers();
+		bWirePreviewStreamActive = false;
 		CurrentUserId.Empty();
 
 		UE_LOG(LogLiveBPCore, Log, TEXT("LiveBP left Concert session"));
 	}
 }
 
-void ULiveBPMUEIntegration::OnCustomEventReceived(const FConcertSessionContext& Context, const FLiveBPConcertEvent& Event)
+void ULiveBPMUEIntegration::OnSessionClientChanged(IConcertClientSession& InSession, EConcertClientStatus ClientStatus, const FConcertSessionClientInfo& ClientInfo)
 {
-	// Don't process our own messages
-	if (Event.Message.UserId == CurrentUserId)
+	const FGuid& EndpointId = ClientInfo.ClientEndpointId;
+	if (EndpointId == InSession.GetSessionClientEndpointId())
 	{
 		return;
 	}
 
-	UE_LOG(LogLiveBPCore, VeryVerbose, TEXT("Received LiveBP message of type %d from user %s on channel %s"), 
-		static_cast<int32>(Event.Message.MessageType), *Event.Message.UserId, *Event.Channel);
+	if (ClientStatus == EConcertClientStatus::Connected)
+	{
+		// The pipeline sends the joiner our dictionary snapshot and interest set before anything else
+		RemoteUserNames.Add(EndpointId, ClientInfo.ClientInfo.UserName);
+		EnqueueOutbound({ FLiveBPOutboundCommand::EKind::AddEndpoint, EndpointId });
+	}
+	else if (ClientStatus == EConcertClientStatus::Disconnected)
+	{
+		FString UserName;
+		RemoteUserNames.RemoveAndCopyValue(EndpointId, UserName);
+		InboundPipeline->RemoveEndpoint(EndpointId);
+		EnqueueOutbound({ FLiveBPOutboundCommand::EKind::RemoveEndpoint, EndpointId });
 
-	// Broadcast the received message to listeners
-	OnMessageReceived.Broadcast(Event.Message);
+		if (!UserName.IsEmpty())
+		{
+			OnUserLeft.Broadcast(UserName);
+		}
+	}
+	else if (ClientStatus == EConcertClientStatus::Updated)
+	{
+		if (FString* UserName = RemoteUserNames.Find(EndpointId))
+		{
+			*UserName = ClientInfo.ClientInfo.UserName;
+		}
+	}
 }
 
-bool ULiveBPMUEIntegration::SendCustomEvent(const FString& Channel, const TArray<uint8>& EventData)
+void ULiveBPMUEIntegration::RebuildRemoteUsers()
 {
-	if (!IsConnected())
+	RemoteUserNames.Reset();
+
+	if (!ActiveSession.IsValid())
 	{
-		UE_LOG(LogLiveBPCore, Warning, TEXT("Cannot send custom event: not connected to Concert session"));
-		return false;
+		return;
 	}
 
-	// Create LiveBP message from the event data
-	FLiveBPMessage Message;
-	if (!DeserializeMessage(Channel, EventData, Message))
+	// Our own endpoint is left out, so nothing we send echoes back
+	const FGuid LocalEndpointId = ActiveSession->GetSessionClientEndpointId();
+	for (const FConcertSessionClientInfo& ClientInfo : ActiveSession->GetSessionClients())
 	{
-		UE_LOG(LogLiveBPCore, Error, TEXT("Failed to deserialize message for channel: %s"), *Channel);
-		return false;
+		if (ClientInfo.ClientEndpointId != LocalEndpointId)
+		{
+			RemoteUserNames.Add(ClientInfo.ClientEndpointId, ClientInfo.ClientInfo.UserName);
+		}
 	}
+}
+
+void ULiveBPMUEIntegration::OnCustomEventReceived(const FConcertSessionContext& Context, const FLiveBPConcertEvent& Event)
+{
+	InboundPipeline->Enqueue(Context.SourceEndpointId, Event.Frames);
+}
 
-	// Create Concert event wrapper
-	FLiveBPConcertEvent ConcertEvent(Channel, Message);
+void ULiveBPMUEIntegration::ApplyInboundMessages()
+{
+	InboundPipeline->Drain([this](FLiveBPInboundMessage& Message)
+	{
+		// Interest sets only feed the outbound routing table
+		if (Message.MessageType == ELiveBPMessageType::Interest)
+		{
+			FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::SetRemoteInterest, Message.SourceEndpointId };
+			Command.Data.Set<TArray<FGuid>>(MoveTemp(Message.Data.Get<TArray<FGuid>>()));
+			EnqueueOutbound(MoveTemp(Command));
+			return;
+		}
 
-	// Send the event to all session participants
-	ActiveSession->SendCustomEvent(ConcertEvent, ActiveSession->GetSessionServerEndpointId(), EConcertMessageFlags::ReliableOrdered);
+		// So do heartbeats, for the send rate to their sender
+		if (Message.MessageType == ELiveBPMessageType::Heartbeat)
+		{
+			FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::Heartbeat, Message.SourceEndpointId };
+			Command.Data.Set<FLiveBPHeartbeatReceipt>(Message.Data.Get<FLiveBPHeartbeatReceipt>());
+			EnqueueOutbound(MoveTemp(Command));
+			return;
+		}
 
-	UE_LOG(LogLiveBPCore, Verbose, TEXT("Sent LiveBP message of type %d on channel %s"), 
-		static_cast<int32>(Message.MessageType), *Channel);
+		// A peer's view decides which of our previews it gets; its cursor is for the editor
+		if (Message.MessageType == ELiveBPMessageType::Presence)
+		{
+			FLiveBPRemoteView View;
+			View.BlueprintId = Message.BlueprintId;
+			View.GraphId = Message.GraphId;
+			View.View = Message.Data.Get<FLiveBPPresence>().View;
+
+			FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::SetRemoteView, Message.SourceEndpointId };
+			Command.Data.Set<FLiveBPRemoteView>(View);
+			EnqueueOutbound(MoveTemp(Command));
+		}
 
-	return true;
+		OnInboundMessage.Broadcast(Message);
+	});
+}
+
+void ULiveBPMUEIntegration::SetResolvableBlueprints(TMap<FGuid, TWeakObjectPtr<UObject>>&& Blueprints)
+{
+	if (InboundPipeline)
+	{
+		InboundPipeline->SetResolvableObjects(MoveTemp(Blueprints));
+	}
+}
+
+namespace
+{
+	// Adds the game thread time of a send call to the frame's total
+	struct FScopedSendTime
+	{
+		explicit FScopedSendTime(uint64& InTotalCycles)
+			: TotalCycles(InTotalCycles)
+			, StartCycles(FPlatformTime::Cycles64())
+		{
+		}
+
+		~FScopedSendTime()
+		{
+			TotalCycles += FPlatformTime::Cycles64() - StartCycles;
+		}
+
+	private:
+		uint64& TotalCycles;
+		uint64 StartCycles;
+	};
+}
+
+void ULiveBPMUEIntegration::EnqueueOutbound(FLiveBPOutboundCommand&& Command)
+{
+	if (OutboundWorker)
+	{
+		OutboundWorker->Enqueue(MoveTemp(Command));
+	}
+}
+
+void ULiveBPMUEIntegration::PushOutboundSettings()
+{
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::ApplySettings };
+	Command.Data.Set<FLiveBPOutboundSettings>(OutboundSettings);
+	EnqueueOutbound(MoveTemp(Command));
+}
+
+void ULiveBPMUEIntegration::OnEndFrame()
+{
+	if (!OutboundWorker)
+	{
+		return;
+	}
+
+	// Whatever the workers have prepared so far is applied now; the rest waits for the next frame
+	ApplyInboundMessages();
+
+	{
+		FScopedSendTime SendTime(GameThreadSendCycles);
+
+		// The worker frames this tick's messages, highest priority first, and batches whatever is due.
+		// Batches it has finished by now go out here; the rest leave next frame.
+		EnqueueOutbound({ FLiveBPOutboundCommand::EKind::EndTick });
+		SendReadyBatches();
+	}
+
+	// Inline processing is already part of the game thread time; on a thread it is what the worker saved us
+	const double WorkerSeconds = OutboundWorker->ConsumeProcessingTime();
+	if (ActiveSession.IsValid())
+	{
+		LIVEBP_RECORD_OUTBOUND_FRAME(
+			static_cast<float>(FPlatformTime::ToMilliseconds64(GameThreadSendCycles)),
+			OutboundWorker->IsThreaded() ? static_cast<float>(WorkerSeconds * 1000.0) : 0.0f);
+	}
+	GameThreadSendCycles = 0;
+
+	// Anything still pacing previews through the shared throttle table follows the adaptive rate too
+	FLiveBPGlobalThrottler::Get().SetThrottleInterval(ELiveBPMessageType::WirePreview, 1.0f / GetEphemeralSendRate());
+}
+
+void ULiveBPMUEIntegration::FlushOutgoingMessages()
+{
+	if (!OutboundWorker)
+	{
+		return;
+	}
+
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	EnqueueOutbound({ FLiveBPOutboundCommand::EKind::Flush });
+	OutboundWorker->WaitUntilIdle();
+	SendReadyBatches();
+}
+
+void ULiveBPMUEIntegration::SendReadyBatches()
+{
+	OutboundWorker->SendReadyBatches([this](FLiveBPOutboundBatcher::FBatch& Batch)
+	{
+		// Batches framed for a session that has since ended are dropped
+		if (!ActiveSession.IsValid())
+		{
+			return;
+		}
+
+		// Lend the batch storage to the event for the send instead of copying it
+		Swap(OutgoingEvent.Frames, Batch.Data);
+		ActiveSession->SendCustomEvent(OutgoingEvent, Batch.Destinations,
+			Batch.Delivery == ELiveBPDelivery::Reliable ? EConcertMessageFlags::ReliableOrdered : EConcertMessageFlags::None);
+		Swap(OutgoingEvent.Frames, Batch.Data);
+
+		UE_LOG(LogLiveBPCore, VeryVerbose, TEXT("Sent %s LiveBP batch of %d frames (%d bytes) to %d endpoints"),
+			Batch.Delivery == ELiveBPDelivery::Reliable ? TEXT("reliable") : TEXT("unreliable"),
+			Batch.FrameCount, Batch.Data.Num(), Batch.Destinations.Num());
+	});
+}
+
+void ULiveBPMUEIntegration::SetLocalInterest(TArrayView<const FGuid> BlueprintIds)
+{
+	// The pipeline skips unchanged sets and only sends while in a session
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::SetLocalInterest };
+	Command.Data.Set<TArray<FGuid>>(TArray<FGuid>(BlueprintIds.GetData(), BlueprintIds.Num()));
+	EnqueueOutbound(MoveTemp(Command));
+}
+
+void ULiveBPMUEIntegration::SetWirePreviewMovementThreshold(float InThreshold)
+{
+	OutboundSettings.WirePreviewMovementThreshold = InThreshold;
+	PushOutboundSettings();
+}
+
+void ULiveBPMUEIntegration::SetPresenceMovementThreshold(float InThreshold)
+{
+	OutboundSettings.PresenceMovementThreshold = InThreshold;
+	PushOutboundSettings();
+}
+
+void ULiveBPMUEIntegration::SetBatchPolicy(const FLiveBPBatchPolicy& InPolicy)
+{
+	OutboundSettings.BatchPolicy = InPolicy;
+	PushOutboundSettings();
+}
+
+void ULiveBPMUEIntegration::SetCompressionPolicy(const FLiveBPCompressionPolicy& InPolicy)
+{
+	OutboundSettings.CompressionPolicy = InPolicy;
+	PushOutboundSettings();
+}
+
+void ULiveBPMUEIntegration::SetOutgoingQueueDepth(int32 InMaxDepth)
+{
+	OutboundSettings.MaxQueueDepth = InMaxDepth;
+	PushOutboundSettings();
+}
+
+void ULiveBPMUEIntegration::SetSendRateBounds(const FLiveBPRateBounds& InBounds)
+{
+	OutboundSettings.RateBounds = InBounds;
+	PushOutboundSettings();
+}
+
+float ULiveBPMUEIntegration::GetEphemeralSendRate() const
+{
+	return OutboundWorker ? OutboundWorker->GetMaxSendRate() : OutboundSettings.RateBounds.InitialRateHz;
+}
+
+void ULiveBPMUEIntegration::GetPeerSendRates(TMap<FGuid, FLiveBPPeerSendRate>& OutRates) const
+{
+	if (OutboundWorker)
+	{
+		OutboundWorker->GetSendRates(OutRates);
+	}
+	else
+	{
+		OutRates.Reset();
+	}
+}
+
+int32 ULiveBPMUEIntegration::GetOutgoingQueueDepth() const
+{
+	return OutboundWorker ? OutboundWorker->GetQueueDepth() : 0;
+}
+
+int32 ULiveBPMUEIntegration::ConsumePeakOutgoingQueueDepth()
+{
+	return OutboundWorker ? OutboundWorker->ConsumePeakQueueDepth() : 0;
+}
+
+void ULiveBPMUEIntegration::SetUseOutboundWorker(bool bInUseWorker)
+{
+	bUseOutboundWorker = bInUseWorker;
+	if (OutboundWorker)
+	{
+		OutboundWorker->SetThreaded(bUseOutboundWorker);
+	}
 }
 
 bool ULiveBPMUEIntegration::SendWirePreview(const FLiveBPWirePreview& WirePreview, const FGuid& BlueprintId, const FGuid& GraphId)
@@ -209,114 +470,149 @@ bool ULiveBPMUEIntegration::SendWirePreview(const FLiveBPWirePreview& WirePrevie
 		return false;
 	}
 
-	// Create message
-	FLiveBPMessage Message;
-	Message.MessageType = ELiveBPMessageType::WirePreview;
-	Message.BlueprintId = BlueprintId;
-	Message.GraphId = GraphId;
-	Message.UserId = CurrentUserId;
-	Message.Timestamp = FPlatformTime::Seconds();
-	Message.PayloadData = SerializeWirePreview(WirePreview);
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::WirePreview, BlueprintId, GraphId };
+	Command.Data.Set<FLiveBPWirePreview>(WirePreview);
+	EnqueueOutbound(MoveTemp(Command));
 
-	// Create Concert event
-	FLiveBPConcertEvent ConcertEvent(LiveBPWirePreviewChannel, Message);
+	UE_LOG(LogLiveBPCore, VeryVerbose, TEXT("Sent wire preview for Blueprint %s"), *BlueprintId.ToString());
+
+	return true;
+}
 
-	// Send to all participants using the correct API
-	TArray<FGuid> AllEndpoints;
-	TArray<FConcertClientInfo> ClientInfos = ActiveSession->GetSessionClients();
-	for (const FConcertClientInfo& ClientInfo : ClientInfos)
+bool ULiveBPMUEIntegration::BeginWirePreviewStream(const FLiveBPWirePreview& WirePreview, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	if (!IsConnected())
 	{
-		AllEndpoints.Add(ClientInfo.ClientEndpointId);
+		return false;
 	}
-	
-	if (AllEndpoints.Num() > 0)
+
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::BeginWirePreview, BlueprintId, GraphId };
+	Command.Data.Set<FLiveBPWirePreview>(WirePreview);
+	EnqueueOutbound(MoveTemp(Command));
+
+	bWirePreviewStreamActive = true;
+	return true;
+}
+
+bool ULiveBPMUEIntegration::UpdatePresence(const FLiveBPPresence& Presence, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	if (!IsConnected())
 	{
-		ActiveSession->SendCustomEvent(ConcertEvent, AllEndpoints, EConcertMessageFlags::ReliableOrdered);
+		return false;
 	}
 
-	UE_LOG(LogLiveBPCore, VeryVerbose, TEXT("Sent wire preview for Blueprint %s"), *BlueprintId.ToString());
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::Presence, BlueprintId, GraphId };
+	Command.Data.Set<FLiveBPPresence>(Presence);
+	EnqueueOutbound(MoveTemp(Command));
 
 	return true;
 }
 
-bool ULiveBPMUEIntegration::SendNodeOperation(const FLiveBPNodeOperationData& NodeOperation, const FGuid& BlueprintId, const FGuid& GraphId)
+bool ULiveBPMUEIntegration::UpdateWirePreviewStream(const FVector2D& EndPosition)
 {
-	if (!IsConnected())
+	if (!IsConnected() || !bWirePreviewStreamActive)
 	{
-		UE_LOG(LogLiveBPCore, Warning, TEXT("Cannot send node operation: not connected to Concert session"));
 		return false;
 	}
 
-	// Create message
-	FLiveBPMessage Message;
-	Message.MessageType = ELiveBPMessageType::NodeOperation;
-	Message.BlueprintId = BlueprintId;
-	Message.GraphId = GraphId;
-	Message.UserId = CurrentUserId;
-	Message.Timestamp = FPlatformTime::Seconds();
-	Message.PayloadData = SerializeNodeOperation(NodeOperation);
+	// Small movements are suppressed by the worker, so this only reports that the update was accepted
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::UpdateWirePreview };
+	Command.Data.Set<FVector2D>(EndPosition);
+	EnqueueOutbound(MoveTemp(Command));
 
-	// Create Concert event
-	FLiveBPConcertEvent ConcertEvent(LiveBPNodeOperationChannel, Message);
+	return true;
+}
 
-	// Send to all participants using the correct API
-	TArray<FGuid> AllEndpoints;
-	TArray<FConcertClientInfo> ClientInfos = ActiveSession->GetSessionClients();
-	for (const FConcertClientInfo& ClientInfo : ClientInfos)
+bool ULiveBPMUEIntegration::EndWirePreviewStream()
+{
+	if (!bWirePreviewStreamActive)
 	{
-		AllEndpoints.Add(ClientInfo.ClientEndpointId);
+		return false;
 	}
-	
-	if (AllEndpoints.Num() > 0)
+
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	EnqueueOutbound({ FLiveBPOutboundCommand::EKind::EndWirePreview });
+	bWirePreviewStreamActive = false;
+
+	return IsConnected();
+}
+
+bool ULiveBPMUEIntegration::SendNodeOperation(const FLiveBPNodeOperationData& NodeOperation, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	if (!IsConnected())
 	{
-		ActiveSession->SendCustomEvent(ConcertEvent, AllEndpoints, EConcertMessageFlags::ReliableOrdered);
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Cannot send node operation: not connected to Concert session"));
+		return false;
 	}
 
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::NodeOperation, BlueprintId, GraphId };
+	Command.Data.Set<FLiveBPNodeOperationData>(NodeOperation);
+	EnqueueOutbound(MoveTemp(Command));
+
 	UE_LOG(LogLiveBPCore, Verbose, TEXT("Sent node operation %d for Blueprint %s"), 
 		static_cast<int32>(NodeOperation.Operation), *BlueprintId.ToString());
 
 	return true;
 }
 
-bool ULiveBPMUEIntegration::SendLockRequest(const FLiveBPNodeLock& LockRequest, const FGuid& BlueprintId, const FGuid& GraphId)
+bool ULiveBPMUEIntegration::SendNodeMove(const FGuid& NodeId, const FIntPoint& Position, const FGuid& BlueprintId, const FGuid& GraphId)
 {
 	if (!IsConnected())
 	{
-		UE_LOG(LogLiveBPCore, Warning, TEXT("Cannot send lock request: not connected to Concert session"));
 		return false;
 	}
 
-	// Create message
-	FLiveBPMessage Message;
-	Message.MessageType = ELiveBPMessageType::LockRequest;
-	Message.BlueprintId = BlueprintId;
-	Message.GraphId = GraphId;
-	Message.UserId = CurrentUserId;
-	Message.Timestamp = FPlatformTime::Seconds();
-	Message.PayloadData = SerializeLockRequest(LockRequest);
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::NodeMove, BlueprintId, GraphId };
+	Command.Data.Set<FLiveBPNodeMove>({ NodeId, Position });
+	EnqueueOutbound(MoveTemp(Command));
 
-	// Create Concert event
-	FLiveBPConcertEvent ConcertEvent(LiveBPLockRequestChannel, Message);
+	return true;
+}
 
-	// Send to all participants using the correct API
-	TArray<FGuid> AllEndpoints;
-	TArray<FConcertClientInfo> ClientInfos = ActiveSession->GetSessionClients();
-	for (const FConcertClientInfo& ClientInfo : ClientInfos)
-	{
-		AllEndpoints.Add(ClientInfo.ClientEndpointId);
-	}
-	
-	if (AllEndpoints.Num() > 0)
+bool ULiveBPMUEIntegration::SendLockRequest(const FLiveBPNodeLock& LockRequest, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	if (!IsConnected())
 	{
-		ActiveSession->SendCustomEvent(ConcertEvent, AllEndpoints, EConcertMessageFlags::ReliableOrdered);
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Cannot send lock request: not connected to Concert session"));
+		return false;
 	}
 
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::LockRequest, BlueprintId, GraphId };
+	Command.Data.Set<FLiveBPNodeLock>(LockRequest);
+	EnqueueOutbound(MoveTemp(Command));
+
 	UE_LOG(LogLiveBPCore, Verbose, TEXT("Sent lock request for node %s in Blueprint %s"), 
 		*LockRequest.NodeId.ToString(), *BlueprintId.ToString());
 
 	return true;
 }
 
+bool ULiveBPMUEIntegration::SendLockSet(const FLiveBPNodeLockSet& LockSet, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	if (!IsConnected())
+	{
+		UE_LOG(LogLiveBPCore, Warning, TEXT("Cannot send lock set: not connected to Concert session"));
+		return false;
+	}
+
+	FScopedSendTime SendTime(GameThreadSendCycles);
+	FLiveBPOutboundCommand Command{ FLiveBPOutboundCommand::EKind::LockSet, BlueprintId, GraphId };
+	Command.Data.Set<FLiveBPNodeLockSet>(LockSet);
+	EnqueueOutbound(MoveTemp(Command));
+
+	UE_LOG(LogLiveBPCore, Verbose, TEXT("Sent lock set of %d nodes in Blueprint %s"), 
+		LockSet.NodeIds.Num(), *BlueprintId.ToString());
+
+	return true;
+}
+
 bool ULiveBPMUEIntegration::IsConnected() const
 {
 	return bIsInitialized && ConcertSyncClient && ActiveSession.IsValid();
@@ -332,91 +628,28 @@ FString ULiveBPMUEIntegration::GetCurrentUserId() const
 	return CurrentUserId;
 }
 
-TArray<FString> ULiveBPMUEIntegration::GetConnectedUsers() const
-{
-	TArray<FString> ConnectedUsers;
-	
-	if (!ActiveSession.IsValid())
-	{
-		return ConnectedUsers;
-	}
-
-	TArray<FConcertClientInfo> ClientInfos = ActiveSession->GetSessionClients();
-	for (const FConcertClientInfo& ClientInfo : ClientInfos)
-	{
-		ConnectedUsers.Add(ClientInfo.UserName);
-	}
-
-	return ConnectedUsers;
-}
-
-TArray<uint8> ULiveBPMUEIntegration::SerializeWirePreview(const FLiveBPWirePreview& WirePreview) const
-{
-	TArray<uint8> Result;
-	FMemoryWriter Writer(Result);
-	
-	// Binary serialization for performance - wire previews are high frequency
-	Writer << const_cast<FGuid&>(WirePreview.NodeId);
-	Writer << const_cast<FString&>(WirePreview.PinName);
-	Writer << const_cast<FVector2D&>(WirePreview.StartPosition);
-	Writer << const_cast<FVector2D&>(WirePreview.EndPosition);
-	Writer << const_cast<FString&>(WirePreview.UserId);
-	Writer << const_cast<float&>(WirePreview.Timestamp);
-	
-	return Result;
-}
-
-TArray<uint8> ULiveBPMUEIntegration::SerializeNodeOperation(const FLiveBPNodeOperationData& NodeOperation) const
+int32 ULiveBPMUEIntegration::GetConnectedUserCount() const
 {
-	// Use JSON for structural changes to maintain readability and debuggability
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	
-	JsonObject->SetNumberField(TEXT("Operation"), static_cast<int32>(NodeOperation.Operation));
-	JsonObject->SetStringField(TEXT("NodeId"), NodeOperation.NodeId.ToString());
-	JsonObject->SetStringField(TEXT("TargetNodeId"), NodeOperation.TargetNodeId.ToString());
-	JsonObject->SetStringField(TEXT("PinName"), NodeOperation.PinName);
-	JsonObject->SetStringField(TEXT("TargetPinName"), NodeOperation.TargetPinName);
-	JsonObject->SetNumberField(TEXT("PositionX"), NodeOperation.Position.X);
-	JsonObject->SetNumberField(TEXT("PositionY"), NodeOperation.Position.Y);
-	JsonObject->SetStringField(TEXT("NodeClass"), NodeOperation.NodeClass);
-	JsonObject->SetStringField(TEXT("PropertyData"), NodeOperation.PropertyData);
-	JsonObject->SetStringField(TEXT("UserId"), NodeOperation.UserId);
-	JsonObject->SetNumberField(TEXT("Timestamp"), NodeOperation.Timestamp);
-	
-	FString JsonString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-	
-	TArray<uint8> Result;
-	Result.Append(reinterpret_cast<const uint8*>(TCHAR_TO_UTF8(*JsonString)), JsonString.Len());
-	
-	return Result;
+	return RemoteUserNames.Num();
 }
 
-TArray<uint8> ULiveBPMUEIntegration::SerializeLockRequest(const FLiveBPNodeLock& LockRequest) const
+void ULiveBPMUEIntegration::SetPayloadEncoding(ELiveBPPayloadEncoding InEncoding)
 {
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-	
-	JsonObject->SetStringField(TEXT("NodeId"), LockRequest.NodeId.ToString());
-	JsonObject->SetNumberField(TEXT("LockState"), static_cast<int32>(LockRequest.LockState));
-	JsonObject->SetStringField(TEXT("UserId"), LockRequest.UserId);
-	JsonObject->SetNumberField(TEXT("LockTime"), LockRequest.LockTime);
-	JsonObject->SetNumberField(TEXT("ExpiryTime"), LockRequest.ExpiryTime);
-	
-	FString JsonString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-	
-	TArray<uint8> Result;
-	Result.Append(reinterpret_cast<const uint8*>(TCHAR_TO_UTF8(*JsonString)), JsonString.Len());
-	
-	return Result;
+#if UE_BUILD_DEBUG || UE_BUILD_DEVELOPMENT
+	OutboundSettings.PayloadEncoding = InEncoding;
+#else
+	// Shipping and test builds always use the binary codec
+	OutboundSettings.PayloadEncoding = ELiveBPPayloadEncoding::Binary;
+#endif
+	PushOutboundSettings();
+
+	UE_LOG(LogLiveBPCore, Log, TEXT("LiveBP payload encoding: %s"),
+		OutboundSettings.PayloadEncoding == ELiveBPPayloadEncoding::Json ? TEXT("JSON (debug)") : TEXT("Binary"));
 }
 
-bool ULiveBPMUEIntegration::DeserializeMessage(const FString& Channel, const TArray<uint8>& Data, FLiveBPMessage& OutMessage) const
+TArray<FString> ULiveBPMUEIntegration::GetConnectedUsers() const
 {
-	// For this implementation, we're creating the message structure directly in the Send methods
-	// This function would be used if we were deserializing raw event data
-	// For now, we'll return true as we're handling this differently
-	return true;
+	TArray<FString> ConnectedUsers;
+	RemoteUserNames.GenerateValueArray(ConnectedUsers);
+	return ConnectedUsers;
 }
@@ -0,0 +1,135 @@
+#include "LiveBPMessageBuffers.h"
+#include "LiveBPCore.h"
+
+// FLiveBPPooledBuffer implementation
+FLiveBPPooledBuffer::FLiveBPPooledBuffer()
+	: Pool(nullptr)
+{
+}
+
+FLiveBPPooledBuffer::FLiveBPPooledBuffer(FLiveBPPooledBuffer&& Other)
+	: Buffer(MoveTemp(Other.Buffer))
+	, Pool(Other.Pool)
+{
+	Other.Pool = nullptr;
+}
+
+FLiveBPPooledBuffer& FLiveBPPooledBuffer::operator=(FLiveBPPooledBuffer&& Other)
+{
+	if (this != &Other)
+	{
+		Release();
+		Buffer = MoveTemp(Other.Buffer);
+		Pool = Other.Pool;
+		Other.Pool = nullptr;
+	}
+	return *this;
+}
+
+FLiveBPPooledBuffer::~FLiveBPPooledBuffer()
+{
+	Release();
+}
+
+void FLiveBPPooledBuffer::Release()
+{
+	if (Pool)
+	{
+		Pool->Release(Buffer);
+		Pool = nullptr;
+	}
+	Buffer.Empty();
+}
+
+// FLiveBPBufferPool implementation
+FLiveBPBufferPool::FLiveBPBufferPool(int32 InMaxPooledBuffers, int32 InMaxPooledCapacity)
+	: MaxPooledBuffers(InMaxPooledBuffers)
+	, MaxPooledCapacity(InMaxPooledCapacity)
+	, NumCreated(0)
+	, NumOutstanding(0)
+{
+}
+
+FLiveBPBufferPool::~FLiveBPBufferPool()
+{
+	ensureMsgf(NumOutstanding == 0, TEXT("LiveBP buffer pool destroyed with %d buffers still in use"), NumOutstanding);
+}
+
+FLiveBPPooledBuffer FLiveBPBufferPool::Acquire()
+{
+	FLiveBPPooledBuffer Result;
+	Result.Pool = this;
+	NumOutstanding++;
+
+	if (FreeBuffers.Num() > 0)
+	{
+		Result.Buffer = FreeBuffers.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		NumCreated++;
+	}
+
+	return Result;
+}
+
+void FLiveBPBufferPool::Release(TArray<uint8>& Buffer)
+{
+	NumOutstanding--;
+
+	if (FreeBuffers.Num() < MaxPooledBuffers && Buffer.Max() <= MaxPooledCapacity)
+	{
+		Buffer.Reset();
+		FreeBuffers.Add(MoveTemp(Buffer));
+	}
+}
+
+// FLiveBPDecodeArena implementation
+FLiveBPDecodeArena::FLiveBPDecodeArena(int32 InBlockSize)
+	: BlockSize(InBlockSize)
+	, CurrentBlock(0)
+	, CurrentOffset(0)
+	, NumBlockAllocations(0)
+{
+}
+
+TArrayView<uint8> FLiveBPDecodeArena::Allocate(int32 NumBytes)
+{
+	check(NumBytes >= 0);
+
+	// Skip blocks without enough room left; requests bigger than a block get one of their own
+	while (CurrentBlock < Blocks.Num() && CurrentOffset + NumBytes > Blocks[CurrentBlock].Num())
+	{
+		++CurrentBlock;
+		CurrentOffset = 0;
+	}
+
+	if (CurrentBlock == Blocks.Num())
+	{
+		Blocks.AddDefaulted_GetRef().SetNumUninitialized(FMath::Max(BlockSize, NumBytes));
+		NumBlockAllocations++;
+	}
+
+	uint8* Result = Blocks[CurrentBlock].GetData() + CurrentOffset;
+	CurrentOffset += NumBytes;
+	return TArrayView<uint8>(Result, NumBytes);
+}
+
+void FLiveBPDecodeArena::Reset()
+{
+	// Oversized blocks were for one unusually large payload; don't keep them around
+	Blocks.RemoveAll([this](const TArray<uint8>& Block) { return Block.Num() > BlockSize; });
+
+	CurrentBlock = 0;
+	CurrentOffset = 0;
+}
+
+int32 FLiveBPDecodeArena::GetBytesUsed() const
+{
+	int32 Total = CurrentOffset;
+	for (int32 Index = 0; Index < CurrentBlock && Index < Blocks.Num(); ++Index)
+	{
+		Total += Blocks[Index].Num();
+	}
+	return Total;
+}
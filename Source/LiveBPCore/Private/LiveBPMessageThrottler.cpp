@@ -1,5 +1,6 @@
 #include "LiveBPMessageThrottler.h"
 #include "LiveBPCore.h"
+#include "LiveBPCongestionControl.h"
 #include "Engine/Engine.h"
 
 // Static constants
@@ -75,16 +76,24 @@ void FLiveBPMessageThrottler::CleanupOldRecords(float CurrentTime)
 	});
 }
 
-float FLiveBPMessageThrottler::GetThrottleInterval(ELiveBPMessageType MessageType)
+float FLiveBPMessageThrottler::GetThrottleInterval(ELiveBPMessageType MessageType) const
 {
+	if (const float* CustomInterval = CustomThrottleIntervals.Find(MessageType))
+	{
+		return *CustomInterval;
+	}
+
 	switch (MessageType)
 	{
 	case ELiveBPMessageType::WirePreview:
-		return 0.1f; // 10Hz
+		return 1.0f / FLiveBPRateBounds().InitialRateHz; // Until the congestion controller has a rate
 	case ELiveBPMessageType::NodeOperation:
+	case ELiveBPMessageType::NodeMoves:
+	case ELiveBPMessageType::NodeTransaction:
 		return 0.0f; // No throttling for structural changes
 	case ELiveBPMessageType::LockRequest:
 	case ELiveBPMessageType::LockRelease:
+	case ELiveBPMessageType::LockSet:
 		return 0.0f; // No throttling for locks
 	case ELiveBPMessageType::Heartbeat:
 		return 1.0f; // 1 second heartbeat
@@ -0,0 +1,78 @@
+#include "LiveBPNodeMoves.h"
+
+void FLiveBPNodeMoveCoalescer::Add(const FGuid& BlueprintId, const FGuid& GraphId, const FGuid& NodeId, const FIntPoint& Position)
+{
+	FGroup* Group = Groups.FindByPredicate([&](const FGroup& Candidate)
+	{
+		return Candidate.BlueprintId == BlueprintId && Candidate.GraphId == GraphId;
+	});
+	if (!Group)
+	{
+		Group = &Groups.AddDefaulted_GetRef();
+		Group->BlueprintId = BlueprintId;
+		Group->GraphId = GraphId;
+	}
+
+	if (const int32* MoveIndex = Group->MoveIndices.Find(NodeId))
+	{
+		Group->Moves[*MoveIndex].Position = Position;
+		return;
+	}
+
+	Group->MoveIndices.Add(NodeId, Group->Moves.Num());
+	Group->Moves.Add({ NodeId, Position });
+	NumPending++;
+}
+
+void FLiveBPNodeMoveCoalescer::Flush(FEmitFunc Emit)
+{
+	if (NumPending == 0)
+	{
+		return;
+	}
+
+	// Emit may add moves or flush again (e.g. when it fills the send queue), so this tick's groups
+	// are taken out before any of them is emitted; whatever arrives meanwhile waits for the next flush
+	TArray<FGroup> Flushing;
+	Swap(Groups, Flushing);
+	NumPending = 0;
+
+	// Graphs without moves this tick are dropped; the others keep their storage for the next drag step
+	for (int32 Index = Flushing.Num() - 1; Index >= 0; --Index)
+	{
+		FGroup& Group = Flushing[Index];
+		if (Group.Moves.Num() == 0)
+		{
+			Flushing.RemoveAtSwap(Index);
+			continue;
+		}
+
+		Emit(Group.BlueprintId, Group.GraphId, Group.Moves);
+		Group.Moves.Reset();
+		Group.MoveIndices.Reset();
+	}
+
+	if (Groups.Num() == 0)
+	{
+		Swap(Groups, Flushing);
+		return;
+	}
+
+	for (FGroup& Group : Flushing)
+	{
+		const bool bReopened = Groups.ContainsByPredicate([&Group](const FGroup& Candidate)
+		{
+			return Candidate.BlueprintId == Group.BlueprintId && Candidate.GraphId == Group.GraphId;
+		});
+		if (!bReopened)
+		{
+			Groups.Add(MoveTemp(Group));
+		}
+	}
+}
+
+void FLiveBPNodeMoveCoalescer::Reset()
+{
+	Groups.Empty();
+	NumPending = 0;
+}
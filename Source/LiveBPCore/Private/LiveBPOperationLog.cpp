@@ -0,0 +1,91 @@
+#include "LiveBPOperationLog.h"
+
+FLiveBPOperationLog::FLiveBPOperationLog()
+	: LastSent(0)
+	, Highest(0)
+	, Received(0)
+	, bHasReceived(false)
+{
+}
+
+bool FLiveBPOperationLog::IsLogged(ELiveBPMessageType MessageType)
+{
+	switch (MessageType)
+	{
+	case ELiveBPMessageType::NodeOperation:
+	case ELiveBPMessageType::NodeMoves:
+	case ELiveBPMessageType::NodeTransaction:
+	case ELiveBPMessageType::LockRequest:
+	case ELiveBPMessageType::LockRelease:
+	case ELiveBPMessageType::LockSet:
+		return true;
+	default:
+		return false;
+	}
+}
+
+uint32 FLiveBPOperationLog::Next()
+{
+	if (++LastSent == 0)
+	{
+		++LastSent;
+	}
+	return LastSent;
+}
+
+FLiveBPOperationLog::EAcceptResult FLiveBPOperationLog::Accept(uint32 Sequence, int32& OutLostCount)
+{
+	OutLostCount = 0;
+
+	if (!bHasReceived)
+	{
+		// Anything before the first number we see predates our joining, so counts as received
+		bHasReceived = true;
+		Highest = Sequence;
+		Received = MAX_uint64;
+		return EAcceptResult::Accepted;
+	}
+
+	// Serial number arithmetic, so the comparison survives wrap-around
+	const int32 Distance = static_cast<int32>(Sequence - Highest);
+	if (Distance > 0)
+	{
+		// Numbers shifted out of the window without arriving are lost
+		if (Distance >= WindowSize)
+		{
+			OutLostCount = (WindowSize - FMath::CountBits(Received)) + (Distance - WindowSize);
+			Received = 1;
+		}
+		else
+		{
+			const uint64 ShiftedOut = Received & (MAX_uint64 << (WindowSize - Distance));
+			OutLostCount = Distance - FMath::CountBits(ShiftedOut);
+			Received = (Received << Distance) | 1;
+		}
+		Highest = Sequence;
+		return EAcceptResult::Accepted;
+	}
+
+	// Late arrivals fill their gap once; anything older than the window can't be told apart from a replay
+	const int32 Age = -Distance;
+	if (Age >= WindowSize || (Received & (1ull << Age)) != 0)
+	{
+		return EAcceptResult::Duplicate;
+	}
+
+	Received |= 1ull << Age;
+	return EAcceptResult::Accepted;
+}
+
+int32 FLiveBPOperationLog::GetPendingGapCount() const
+{
+	return bHasReceived ? WindowSize - FMath::CountBits(Received) : 0;
+}
+
+void FLiveBPOperationLog::Reset()
+{
+	LastSent = 0;
+	Highest = 0;
+	Received = 0;
+	bHasReceived = false;
+}
@@ -0,0 +1,103 @@
+#include "LiveBPOutboundBatcher.h"
+#include "LiveBPCore.h"
+#include "LiveBPBinaryCodec.h"
+
+FLiveBPOutboundBatcher::FLiveBPOutboundBatcher()
+	: NumActiveBatches(0)
+	, PendingBytes(0)
+	, OldestFrameTime(0.0)
+{
+	LastBatchIndex[0] = LastBatchIndex[1] = INDEX_NONE;
+}
+
+bool FLiveBPOutboundBatcher::Enqueue(const TArray<FGuid>& Destinations, TArrayView<const uint8> Frame, double CurrentTime, ELiveBPDelivery Delivery)
+{
+	if (NumActiveBatches == 0)
+	{
+		OldestFrameTime = CurrentTime;
+	}
+
+	// Only the lane's most recent batch may grow; appending to an older one would reorder frames
+	int32& LaneBatch = LastBatchIndex[static_cast<int32>(Delivery)];
+	if (LaneBatch == INDEX_NONE || Batches[LaneBatch].Destinations != Destinations)
+	{
+		if (NumActiveBatches == Batches.Num())
+		{
+			Batches.AddDefaulted();
+		}
+
+		// Reuse a spare batch's storage rather than copy-assigning, which may reallocate
+		LaneBatch = NumActiveBatches++;
+		FBatch& NewBatch = Batches[LaneBatch];
+		NewBatch.Destinations.Reset();
+		NewBatch.Destinations.Append(Destinations);
+		NewBatch.Data.Reset();
+		NewBatch.FrameCount = 0;
+		NewBatch.Delivery = Delivery;
+	}
+
+	FBatch& Batch = Batches[LaneBatch];
+	const int32 PreviousNum = Batch.Data.Num();
+	AppendFrame(Batch.Data, Frame);
+	Batch.FrameCount++;
+	PendingBytes += Batch.Data.Num() - PreviousNum;
+
+	return PendingBytes >= Policy.MaxBatchBytes;
+}
+
+bool FLiveBPOutboundBatcher::IsFlushDue(double CurrentTime) const
+{
+	if (NumActiveBatches == 0)
+	{
+		return false;
+	}
+
+	return Policy.MaxDelaySeconds <= 0.0
+		|| PendingBytes >= Policy.MaxBatchBytes
+		|| CurrentTime - OldestFrameTime >= Policy.MaxDelaySeconds;
+}
+
+void FLiveBPOutboundBatcher::Flush(TFunctionRef<void(FBatch& Batch)> Send)
+{
+	for (int32 Index = 0; Index < NumActiveBatches; ++Index)
+	{
+		Send(Batches[Index]);
+	}
+
+	Reset();
+}
+
+void FLiveBPOutboundBatcher::Reset()
+{
+	NumActiveBatches = 0;
+	LastBatchIndex[0] = LastBatchIndex[1] = INDEX_NONE;
+	PendingBytes = 0;
+}
+
+void FLiveBPOutboundBatcher::AppendFrame(TArray<uint8>& BatchData, TArrayView<const uint8> Frame)
+{
+	FLiveBPBinaryWriter Writer(BatchData);
+	Writer.WriteVarUInt(Frame.Num());
+	Writer.WriteBytes(Frame.GetData(), Frame.Num());
+}
+
+bool FLiveBPOutboundBatcher::SplitFrames(TArrayView<const uint8> BatchData, TArray<TArrayView<const uint8>>& OutFrames)
+{
+	OutFrames.Reset();
+
+	FLiveBPBinaryReader Reader(BatchData);
+	while (!Reader.IsAtEnd())
+	{
+		const uint64 Length = Reader.ReadVarUInt();
+		const TArrayView<const uint8> Remaining = Reader.GetRemaining();
+		if (Reader.IsError() || Length == 0 || Length > static_cast<uint64>(Remaining.Num()))
+		{
+			return false;
+		}
+
+		OutFrames.Add(Remaining.Left(static_cast<int32>(Length)));
+		Reader.Skip(static_cast<int32>(Length));
+	}
+
+	return true;
+}
@@ -0,0 +1,582 @@
+#include "LiveBPOutboundPipeline.h"
+#include "LiveBPCore.h"
+#include "LiveBPUtils.h"
+#include "LiveBPPerformanceMonitor.h"
+
+FLiveBPOutboundPipeline::FLiveBPOutboundPipeline(FBatchSink InBatchSink)
+	: BatchSink(MoveTemp(InBatchSink))
+	, bInSession(false)
+	, bHasLocalInterest(false)
+	, WirePreviewBounds(ForceInit)
+{
+	ApplySettings(Settings);
+}
+
+void FLiveBPOutboundPipeline::ApplySettings(const FLiveBPOutboundSettings& InSettings)
+{
+	Settings = InSettings;
+	OutboundBatcher.SetPolicy(Settings.BatchPolicy);
+	OutgoingQueue.SetMaxDepth(Settings.MaxQueueDepth);
+	Congestion.SetBounds(Settings.RateBounds);
+}
+
+void FLiveBPOutboundPipeline::StartSession(const FString& InUserId, TArrayView<const FGuid> Endpoints)
+{
+	// Handles and sequences are only meaningful within one session
+	UserId = InUserId;
+	bInSession = true;
+	LocalNames.Reset();
+	OutgoingSequences.Reset();
+	OutgoingOperations.Reset();
+	OutgoingQueue.Reset();
+	OutboundBatcher.Reset();
+
+	RemoteEndpoints.Reset();
+	RemoteViews.Reset();
+	Congestion.Reset();
+	PresenceEncoder.Reset();
+	NodeMoves.Reset();
+	PendingNodeOperations.Reset();
+	for (const FGuid& EndpointId : Endpoints)
+	{
+		RemoteEndpoints.AddEndpoint(EndpointId);
+		Congestion.AddPeer(EndpointId);
+	}
+
+	// Peers already in the session need our interest set before they route previews to us
+	if (bHasLocalInterest)
+	{
+		SendLocalInterest(RemoteEndpoints.GetAllEndpoints());
+	}
+}
+
+void FLiveBPOutboundPipeline::EndSession()
+{
+	Flush();
+
+	UserId.Empty();
+	bInSession = false;
+	LocalNames.Reset();
+	OutgoingSequences.Reset();
+	OutgoingOperations.Reset();
+	RemoteEndpoints.Reset();
+	RemoteViews.Reset();
+	Congestion.Reset();
+	PresenceEncoder.Reset();
+	NodeMoves.Reset();
+	PendingNodeOperations.Reset();
+}
+
+void FLiveBPOutboundPipeline::AddEndpoint(const FGuid& EndpointId)
+{
+	// Late joiners never saw our earlier definitions; send them the whole dictionary first.
+	// The reliable ordered channel and the batcher's queue order guarantee it arrives before anything that uses it.
+	if (LocalNames.NumDefinitions() > 0)
+	{
+		FLiveBPBinaryCodec::EncodeSnapshotFrame(LocalNames, FrameBuffer);
+		QueueFrame({ EndpointId }, FrameBuffer);
+
+		UE_LOG(LogLiveBPCore, Verbose, TEXT("Queued session dictionary snapshot (%d entries, %d bytes) for endpoint %s"),
+			LocalNames.NumDefinitions(), FrameBuffer.Num(), *EndpointId.ToString());
+	}
+
+	// Only start fanning out to the joiner once its snapshot is queued
+	RemoteEndpoints.AddEndpoint(EndpointId);
+	Congestion.AddPeer(EndpointId);
+
+	if (bHasLocalInterest)
+	{
+		SendLocalInterest({ EndpointId });
+	}
+}
+
+void FLiveBPOutboundPipeline::RemoveEndpoint(const FGuid& EndpointId)
+{
+	RemoteEndpoints.RemoveEndpoint(EndpointId);
+	RemoteViews.Remove(EndpointId);
+	Congestion.RemovePeer(EndpointId);
+	OutgoingSequences.Remove(EndpointId);
+}
+
+void FLiveBPOutboundPipeline::SetRemoteInterest(const FGuid& EndpointId, TArrayView<const FGuid> BlueprintIds)
+{
+	RemoteEndpoints.SetInterest(EndpointId, BlueprintIds);
+}
+
+void FLiveBPOutboundPipeline::SetLocalInterest(TArrayView<const FGuid> BlueprintIds)
+{
+	TArray<FGuid> NewInterest(BlueprintIds.GetData(), BlueprintIds.Num());
+	NewInterest.Sort();
+	if (bHasLocalInterest && NewInterest == LocalInterest)
+	{
+		return;
+	}
+
+	LocalInterest = MoveTemp(NewInterest);
+	bHasLocalInterest = true;
+
+	if (bInSession)
+	{
+		SendLocalInterest(RemoteEndpoints.GetAllEndpoints());
+	}
+}
+
+void FLiveBPOutboundPipeline::SendLocalInterest(const TArray<FGuid>& Endpoints)
+{
+	FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+	FLiveBPBinaryWriter Writer(Payload.Get());
+	FLiveBPBinaryCodec::EncodeInterest(LocalInterest, Writer);
+
+	SendMessageTo(Endpoints, ELiveBPMessageType::Interest, FGuid(), FGuid(), MoveTemp(Payload));
+
+	UE_LOG(LogLiveBPCore, Verbose, TEXT("Published interest in %d Blueprints to %d endpoints"), LocalInterest.Num(), Endpoints.Num());
+}
+
+void FLiveBPOutboundPipeline::OnHeartbeat(const FGuid& EndpointId, const FLiveBPHeartbeatReceipt& Receipt)
+{
+	Congestion.OnHeartbeat(EndpointId, Receipt);
+}
+
+void FLiveBPOutboundPipeline::SendHeartbeats(double CurrentTime)
+{
+	if (!bInSession)
+	{
+		return;
+	}
+
+	for (const FGuid& EndpointId : RemoteEndpoints.GetAllEndpoints())
+	{
+		FLiveBPHeartbeat Heartbeat;
+		if (!Congestion.MakeHeartbeat(EndpointId, CurrentTime, Heartbeat))
+		{
+			continue;
+		}
+
+		FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+		FLiveBPBinaryWriter Writer(Payload.Get());
+		FLiveBPBinaryCodec::EncodeHeartbeat(Heartbeat, Writer);
+
+		// Reliable, so the round trip also covers any retransmission and queueing the link adds
+		PacedEndpoints.Reset();
+		PacedEndpoints.Add(EndpointId);
+		SendMessageTo(PacedEndpoints, ELiveBPMessageType::Heartbeat, FGuid(), FGuid(), MoveTemp(Payload));
+	}
+}
+
+void FLiveBPOutboundPipeline::SetRemoteView(const FGuid& EndpointId, const FLiveBPRemoteView& View)
+{
+	RemoteViews.Add(EndpointId, View);
+}
+
+void FLiveBPOutboundPipeline::SendPresence(const FLiveBPPresence& Presence, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	if (PresenceEncoder.Update(Presence, BlueprintId, GraphId, Settings.PresenceMovementThreshold, FPlatformTime::Seconds()))
+	{
+		QueuePresence();
+	}
+}
+
+void FLiveBPOutboundPipeline::QueuePresence()
+{
+	FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+	FLiveBPBinaryWriter Writer(Payload.Get());
+	FLiveBPBinaryCodec::EncodePresence(PresenceEncoder.GetLastSent(), Writer);
+
+	// Every update carries the whole state, so a lost one is healed by the next or the keep-alive
+	SendMessage(ELiveBPMessageType::Presence, PresenceEncoder.GetBlueprintId(), PresenceEncoder.GetGraphId(), MoveTemp(Payload),
+		ELiveBPDelivery::Unreliable);
+}
+
+void FLiveBPOutboundPipeline::SendWirePreview(const FLiveBPWirePreview& WirePreview, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	WirePreviewBounds = FBox2D(ForceInit);
+	WirePreviewBounds += WirePreview.StartPosition;
+	WirePreviewBounds += WirePreview.EndPosition;
+
+	// Each preview replaces the last, so a lost one is not worth retransmitting
+	SendMessage(ELiveBPMessageType::WirePreview, BlueprintId, GraphId, SerializeWirePreview(WirePreview), ELiveBPDelivery::Unreliable);
+}
+
+void FLiveBPOutboundPipeline::SendNodeOperation(const FLiveBPNodeOperationData& NodeOperation, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	// A transaction covers one graph, and moves reported since it started must arrive between it and this operation
+	const bool bOtherGraph = BlueprintId != PendingNodeOperationsBlueprintId || GraphId != PendingNodeOperationsGraphId;
+	if (!NodeMoves.IsEmpty() || (PendingNodeOperations.Num() > 0 && bOtherGraph))
+	{
+		QueueNodeOperations();
+		QueueNodeMoves();
+	}
+
+	if (PendingNodeOperations.Num() == 0)
+	{
+		PendingNodeOperationsBlueprintId = BlueprintId;
+		PendingNodeOperationsGraphId = GraphId;
+	}
+	PendingNodeOperations.Add(NodeOperation);
+}
+
+void FLiveBPOutboundPipeline::QueueNodeOperations()
+{
+	if (PendingNodeOperations.Num() == 0)
+	{
+		return;
+	}
+
+	// Taken out before anything is sent, so a send that drains a full queue never sees them half queued
+	TArray<FLiveBPNodeOperationData> Operations;
+	Swap(Operations, PendingNodeOperations);
+	const FGuid BlueprintId = PendingNodeOperationsBlueprintId;
+	const FGuid GraphId = PendingNodeOperationsGraphId;
+
+	// A lone operation, and anything in the debug JSON encoding, goes out on its own
+	if (Operations.Num() == 1 || Settings.PayloadEncoding == ELiveBPPayloadEncoding::Json)
+	{
+		for (const FLiveBPNodeOperationData& NodeOperation : Operations)
+		{
+			SendMessage(ELiveBPMessageType::NodeOperation, BlueprintId, GraphId, SerializeNodeOperation(NodeOperation));
+		}
+	}
+	else
+	{
+		// One payload for the whole editor action, so it is compressed as a unit and applied as one
+		FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+		FLiveBPBinaryWriter Writer(Payload.Get());
+		Writer.SetNameInterner(&LocalNames);
+		FLiveBPBinaryCodec::EncodeNodeTransaction(Operations, Writer);
+		SendMessage(ELiveBPMessageType::NodeTransaction, BlueprintId, GraphId, MoveTemp(Payload));
+	}
+
+	// Keep the storage for the next action unless one was started meanwhile
+	if (PendingNodeOperations.Num() == 0)
+	{
+		Operations.Reset();
+		Swap(Operations, PendingNodeOperations);
+	}
+}
+
+void FLiveBPOutboundPipeline::SendNodeMove(const FGuid& NodeId, const FIntPoint& Position, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	NodeMoves.Add(BlueprintId, GraphId, NodeId, Position);
+}
+
+void FLiveBPOutboundPipeline::QueueNodeMoves()
+{
+	NodeMoves.Flush([this](const FGuid& BlueprintId, const FGuid& GraphId, TArrayView<const FLiveBPNodeMove> Moves)
+	{
+		FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+		FLiveBPBinaryWriter Writer(Payload.Get());
+		Writer.SetNameInterner(&LocalNames);
+		FLiveBPBinaryCodec::EncodeNodeMoves(Moves, Writer);
+		SendMessage(ELiveBPMessageType::NodeMoves, BlueprintId, GraphId, MoveTemp(Payload));
+	});
+}
+
+void FLiveBPOutboundPipeline::SendLockRequest(const FLiveBPNodeLock& LockRequest, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	SendMessage(ELiveBPMessageType::LockRequest, BlueprintId, GraphId, SerializeLockRequest(LockRequest));
+}
+
+void FLiveBPOutboundPipeline::SendLockSet(const FLiveBPNodeLockSet& LockSet, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	// Always binary, even with JSON payloads for debugging: sent as single lock requests, the set would
+	// miss the settlement that keeps every client agreeing on who holds its nodes
+	FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+	FLiveBPBinaryWriter Writer(Payload.Get());
+	Writer.SetNameInterner(&LocalNames);
+	FLiveBPBinaryCodec::EncodeNodeLockSet(LockSet, Writer);
+	SendMessage(ELiveBPMessageType::LockSet, BlueprintId, GraphId, MoveTemp(Payload));
+}
+
+void FLiveBPOutboundPipeline::BeginWirePreviewStream(const FLiveBPWirePreview& WirePreview, const FGuid& BlueprintId, const FGuid& GraphId)
+{
+	WirePreviewBlueprintId = BlueprintId;
+	WirePreviewGraphId = GraphId;
+	WirePreviewBounds = FBox2D(ForceInit);
+	WirePreviewBounds += WirePreview.StartPosition;
+	WirePreviewBounds += WirePreview.EndPosition;
+
+	FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+	FLiveBPBinaryWriter Writer(Payload.Get());
+	Writer.SetNameInterner(&LocalNames);
+	WirePreviewEncoder.Begin(WirePreview, Writer);
+
+	SendMessage(ELiveBPMessageType::WirePreview, BlueprintId, GraphId, MoveTemp(Payload));
+}
+
+void FLiveBPOutboundPipeline::UpdateWirePreviewStream(const FVector2D& EndPosition)
+{
+	if (!WirePreviewEncoder.IsActive())
+	{
+		return;
+	}
+
+	FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+	FLiveBPBinaryWriter Writer(Payload.Get());
+	const FLiveBPWirePreviewEncoder::EUpdateResult Result = WirePreviewEncoder.Update(EndPosition, Settings.WirePreviewMovementThreshold, Writer);
+	if (Result == FLiveBPWirePreviewEncoder::EUpdateResult::Suppressed)
+	{
+		return;
+	}
+	WirePreviewBounds += EndPosition;
+
+	// Deltas are disposable; keyframes (like Begin and End) stay reliable so later deltas have a base
+	const ELiveBPDelivery Delivery = Result == FLiveBPWirePreviewEncoder::EUpdateResult::Delta ? ELiveBPDelivery::Unreliable : ELiveBPDelivery::Reliable;
+	SendMessage(ELiveBPMessageType::WirePreview, WirePreviewBlueprintId, WirePreviewGraphId, MoveTemp(Payload), Delivery);
+}
+
+void FLiveBPOutboundPipeline::EndWirePreviewStream()
+{
+	if (!WirePreviewEncoder.IsActive())
+	{
+		return;
+	}
+
+	FLiveBPPooledBuffer Payload = PayloadPool.Acquire();
+	FLiveBPBinaryWriter Writer(Payload.Get());
+	WirePreviewEncoder.End(Writer);
+
+	if (bInSession)
+	{
+		SendMessage(ELiveBPMessageType::WirePreview, WirePreviewBlueprintId, WirePreviewGraphId, MoveTemp(Payload));
+	}
+}
+
+void FLiveBPOutboundPipeline::SendMessage(ELiveBPMessageType MessageType, const FGuid& BlueprintId, const FGuid& GraphId, FLiveBPPooledBuffer&& Payload,
+	ELiveBPDelivery Delivery)
+{
+	FLiveBPOutgoingMessage Message;
+	Message.MessageType = MessageType;
+	Message.BlueprintId = BlueprintId;
+	Message.GraphId = GraphId;
+	Message.Payload = MoveTemp(Payload);
+	Message.Delivery = Delivery;
+
+	// Only what is already queued goes out early. Pending node operations and moves stay where they
+	// are, since this may be called while they are being queued.
+	if (OutgoingQueue.Enqueue(MoveTemp(Message)))
+	{
+		DrainOutgoingQueue();
+		SendBatches();
+	}
+}
+
+void FLiveBPOutboundPipeline::DispatchMessage(FLiveBPOutgoingMessage& Message)
+{
+	// Routed when framed rather than when queued, so peers that joined or changed interest meanwhile are honored
+	const TArray<FGuid>& Endpoints = IsInterestRouted(Message.MessageType)
+		? RemoteEndpoints.GetEndpoints(Message.BlueprintId)
+		: RemoteEndpoints.GetAllEndpoints();
+
+	// Each peer gets unreliable updates it can see at its own rate; the ones it skips are superseded by the next
+	if (Message.Delivery == ELiveBPDelivery::Unreliable)
+	{
+		const double CurrentTime = FPlatformTime::Seconds();
+		PacedEndpoints.Reset();
+		for (const FGuid& EndpointId : Endpoints)
+		{
+			if (IsVisibleTo(EndpointId, Message) && Congestion.ShouldSend(EndpointId, CurrentTime))
+			{
+				PacedEndpoints.Add(EndpointId);
+			}
+		}
+
+		SendMessageTo(PacedEndpoints, Message.MessageType, Message.BlueprintId, Message.GraphId, MoveTemp(Message.Payload), Message.Delivery);
+		return;
+	}
+
+	SendMessageTo(Endpoints, Message.MessageType, Message.BlueprintId, Message.GraphId, MoveTemp(Message.Payload), Message.Delivery);
+}
+
+void FLiveBPOutboundPipeline::SendMessageTo(const TArray<FGuid>& Endpoints, ELiveBPMessageType MessageType, const FGuid& BlueprintId, const FGuid& GraphId,
+	FLiveBPPooledBuffer&& Payload, ELiveBPDelivery Delivery)
+{
+	// Every peer has to see every definition, or later messages to it would use handles it never
+	// learned. When only some peers get this message, or it may be lost, send its new definitions
+	// to all of them on the reliable lane first.
+	const bool bUnreliable = Delivery == ELiveBPDelivery::Unreliable;
+	if (bUnreliable || Endpoints.Num() < RemoteEndpoints.GetAllEndpoints().Num())
+	{
+		LocalNames.Intern(ELiveBPNameKind::User, UserId);
+		LocalNames.Intern(ELiveBPNameKind::Blueprint, BlueprintId);
+		LocalNames.Intern(ELiveBPNameKind::Graph, GraphId);
+		if (FLiveBPBinaryCodec::EncodePendingDefinitionsFrame(LocalNames, FrameBuffer))
+		{
+			QueueFrame(RemoteEndpoints.GetAllEndpoints(), FrameBuffer);
+		}
+	}
+
+	// Unreliable messages are numbered per peer, and only for the peers they actually go to, so a
+	// peer that pacing or culling left out sees no gap for it. Peers that got everything so far
+	// share a number, and so a frame.
+	if (bUnreliable && Endpoints.Num() > 0)
+	{
+		SequencedEndpoints.Reset();
+		for (const FGuid& EndpointId : Endpoints)
+		{
+			SequencedEndpoints.Emplace(OutgoingSequences.FindOrAdd(EndpointId).Next(MessageType, BlueprintId), EndpointId);
+		}
+		SequencedEndpoints.Sort([](const TPair<uint32, FGuid>& A, const TPair<uint32, FGuid>& B) { return A.Key < B.Key; });
+
+		for (int32 First = 0; First < SequencedEndpoints.Num();)
+		{
+			const uint32 Sequence = SequencedEndpoints[First].Key;
+			FrameEndpoints.Reset();
+			int32 Next = First;
+			for (; Next < SequencedEndpoints.Num() && SequencedEndpoints[Next].Key == Sequence; ++Next)
+			{
+				FrameEndpoints.Add(SequencedEndpoints[Next].Value);
+			}
+			First = Next;
+
+			FLiveBPBinaryCodec::EncodeFrame(MessageType, UserId, BlueprintId, GraphId, Payload.Get(), LocalNames, FrameBuffer, &Settings.CompressionPolicy, Sequence);
+			QueueFrame(FrameEndpoints, FrameBuffer, Delivery);
+		}
+		Payload.Release();
+
+		LIVEBP_RECORD_UNRELIABLE_SENT();
+		return;
+	}
+
+	// Build the frame even without peers so new definitions are recorded for the next joiner's snapshot
+	const uint32 Sequence = FLiveBPOperationLog::IsLogged(MessageType) ? OutgoingOperations.Next() : 0;
+	FLiveBPBinaryCodec::EncodeFrame(MessageType, UserId, BlueprintId, GraphId, Payload.Get(), LocalNames, FrameBuffer, &Settings.CompressionPolicy, Sequence);
+	Payload.Release();
+
+	QueueFrame(Endpoints, FrameBuffer, Delivery);
+}
+
+bool FLiveBPOutboundPipeline::IsVisibleTo(const FGuid& EndpointId, const FLiveBPOutgoingMessage& Message) const
+{
+	// Presence is what peers cull with, so it always goes out
+	if (Message.MessageType != ELiveBPMessageType::WirePreview)
+	{
+		return true;
+	}
+
+	// Until a peer has told us its view, assume it sees everything
+	const FLiveBPRemoteView* View = RemoteViews.Find(EndpointId);
+	return !View || FLiveBPPresenceEncoder::IsVisible(*View, Message.BlueprintId, Message.GraphId, WirePreviewBounds);
+}
+
+bool FLiveBPOutboundPipeline::IsInterestRouted(ELiveBPMessageType MessageType)
+{
+	return MessageType == ELiveBPMessageType::WirePreview || MessageType == ELiveBPMessageType::Presence;
+}
+
+void FLiveBPOutboundPipeline::QueueFrame(const TArray<FGuid>& Endpoints, TArrayView<const uint8> Frame, ELiveBPDelivery Delivery)
+{
+	if (Endpoints.Num() == 0)
+	{
+		return;
+	}
+
+	if (OutboundBatcher.Enqueue(Endpoints, Frame, FPlatformTime::Seconds(), Delivery))
+	{
+		SendBatches();
+	}
+}
+
+void FLiveBPOutboundPipeline::EndTick(double CurrentTime)
+{
+	// A queue that filled up this tick is congestion on our side, whatever the peers report
+	Congestion.Update(CurrentTime, static_cast<float>(OutgoingQueue.Num()) / OutgoingQueue.GetMaxDepth());
+	SendHeartbeats(CurrentTime);
+
+	if (bInSession && PresenceEncoder.ConsumeKeepAlive(CurrentTime))
+	{
+		QueuePresence();
+	}
+
+	QueueNodeOperations();
+	QueueNodeMoves();
+
+	// Everything queued this tick is framed now, highest priority first
+	DrainOutgoingQueue();
+
+	if (OutboundBatcher.IsFlushDue(CurrentTime))
+	{
+		SendBatches();
+	}
+}
+
+void FLiveBPOutboundPipeline::Flush()
+{
+	QueueNodeOperations();
+	QueueNodeMoves();
+	DrainOutgoingQueue();
+	SendBatches();
+}
+
+void FLiveBPOutboundPipeline::DrainOutgoingQueue()
+{
+	if (OutgoingQueue.Num() == 0)
+	{
+		return;
+	}
+
+	OutgoingQueue.Drain([this](FLiveBPOutgoingMessage& Message)
+	{
+		DispatchMessage(Message);
+	});
+}
+
+void FLiveBPOutboundPipeline::SendBatches()
+{
+	if (!OutboundBatcher.HasPendingFrames())
+	{
+		return;
+	}
+
+	if (!bInSession)
+	{
+		OutboundBatcher.Reset();
+		return;
+	}
+
+	OutboundBatcher.Flush([this](FLiveBPOutboundBatcher::FBatch& Batch)
+	{
+		LIVEBP_RECORD_BATCH_SENT(Batch.FrameCount, Batch.Data.Num());
+		BatchSink(Batch);
+	});
+}
+
+FLiveBPPooledBuffer FLiveBPOutboundPipeline::SerializeWirePreview(const FLiveBPWirePreview& WirePreview)
+{
+	// Binary serialization for performance - wire previews are high frequency
+	FLiveBPPooledBuffer Result = PayloadPool.Acquire();
+	FLiveBPBinaryWriter Writer(Result.Get());
+	Writer.SetNameInterner(&LocalNames);
+	FLiveBPBinaryCodec::EncodeWirePreview(WirePreview, Writer);
+	return Result;
+}
+
+FLiveBPPooledBuffer FLiveBPOutboundPipeline::SerializeNodeOperation(const FLiveBPNodeOperationData& NodeOperation)
+{
+	FLiveBPPooledBuffer Result = PayloadPool.Acquire();
+	if (Settings.PayloadEncoding == ELiveBPPayloadEncoding::Json)
+	{
+		Result.Get() = FLiveBPUtils::SerializeToJson(NodeOperation);
+		return Result;
+	}
+
+	// Compact binary by default - UserId and Timestamp travel in the message envelope
+	FLiveBPBinaryWriter Writer(Result.Get());
+	Writer.SetNameInterner(&LocalNames);
+	FLiveBPBinaryCodec::EncodeNodeOperation(NodeOperation, Writer);
+	return Result;
+}
+
+FLiveBPPooledBuffer FLiveBPOutboundPipeline::SerializeLockRequest(const FLiveBPNodeLock& LockRequest)
+{
+	FLiveBPPooledBuffer Result = PayloadPool.Acquire();
+	if (Settings.PayloadEncoding == ELiveBPPayloadEncoding::Json)
+	{
+		Result.Get() = FLiveBPUtils::SerializeToJson(LockRequest);
+		return Result;
+	}
+
+	FLiveBPBinaryWriter Writer(Result.Get());
+	Writer.SetNameInterner(&LocalNames);
+	FLiveBPBinaryCodec::EncodeNodeLock(LockRequest, Writer);
+	return Result;
+}
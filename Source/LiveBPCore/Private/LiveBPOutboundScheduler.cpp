@@ -0,0 +1,101 @@
+#include "LiveBPOutboundScheduler.h"
+#include "LiveBPCore.h"
+
+FLiveBPOutboundScheduler::FLiveBPOutboundScheduler()
+	: MaxDepth(100)
+	, PeakDepth(0)
+	, NumCoalesced(0)
+	, bDraining(false)
+{
+}
+
+ELiveBPSendPriority FLiveBPOutboundScheduler::GetPriority(ELiveBPMessageType MessageType, ELiveBPDelivery Delivery)
+{
+	if (Delivery == ELiveBPDelivery::Unreliable)
+	{
+		return ELiveBPSendPriority::Ephemeral;
+	}
+
+	switch (MessageType)
+	{
+	case ELiveBPMessageType::LockRequest:
+	case ELiveBPMessageType::LockRelease:
+	case ELiveBPMessageType::LockSet:
+		return ELiveBPSendPriority::Ownership;
+	default:
+		return ELiveBPSendPriority::Structural;
+	}
+}
+
+bool FLiveBPOutboundScheduler::Enqueue(FLiveBPOutgoingMessage&& Message)
+{
+	checkf(!bDraining, TEXT("LiveBP messages can't be queued while the outbound queue is draining"));
+
+	const ELiveBPSendPriority Priority = GetPriority(Message.MessageType, Message.Delivery);
+	TArray<FLiveBPOutgoingMessage>& Queue = Queues[static_cast<int32>(Priority)];
+
+	if (Priority == ELiveBPSendPriority::Ephemeral && Queue.Num() >= MaxDepth)
+	{
+		NumCoalesced++;
+
+		// Only the latest value of a stream matters, so overwrite it where it already waits
+		for (FLiveBPOutgoingMessage& Queued : Queue)
+		{
+			if (Queued.MessageType == Message.MessageType && Queued.BlueprintId == Message.BlueprintId)
+			{
+				Queued = MoveTemp(Message);
+				return false;
+			}
+		}
+
+		Queue.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	Queue.Add(MoveTemp(Message));
+	PeakDepth = FMath::Max(PeakDepth, Num());
+
+	return Priority != ELiveBPSendPriority::Ephemeral && Queue.Num() >= MaxDepth;
+}
+
+void FLiveBPOutboundScheduler::Drain(TFunctionRef<void(FLiveBPOutgoingMessage& Message)> Send)
+{
+	TGuardValue<bool> DrainingGuard(bDraining, true);
+
+	for (TArray<FLiveBPOutgoingMessage>& Queue : Queues)
+	{
+		for (FLiveBPOutgoingMessage& Message : Queue)
+		{
+			Send(Message);
+		}
+
+		// Releases the payloads back to their pool but keeps the queue's capacity
+		Queue.Reset();
+	}
+}
+
+int32 FLiveBPOutboundScheduler::Num() const
+{
+	int32 Total = 0;
+	for (const TArray<FLiveBPOutgoingMessage>& Queue : Queues)
+	{
+		Total += Queue.Num();
+	}
+	return Total;
+}
+
+int32 FLiveBPOutboundScheduler::ConsumePeakDepth()
+{
+	const int32 Result = FMath::Max(PeakDepth, Num());
+	PeakDepth = Num();
+	return Result;
+}
+
+void FLiveBPOutboundScheduler::Reset()
+{
+	for (TArray<FLiveBPOutgoingMessage>& Queue : Queues)
+	{
+		Queue.Reset();
+	}
+	PeakDepth = 0;
+	NumCoalesced = 0;
+}
@@ -0,0 +1,243 @@
+#include "LiveBPOutboundWorker.h"
+#include "LiveBPCore.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+FLiveBPOutboundWorker::FLiveBPOutboundWorker()
+	: Pipeline([this](FLiveBPOutboundBatcher::FBatch& Batch) { OnBatchReady(Batch); })
+	, Thread(nullptr)
+	, WorkEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, bStopRequested(false)
+	, NumEnqueued(0)
+	, NumProcessed(0)
+	, ProcessingCycles(0)
+	, QueueDepth(0)
+	, PeakQueueDepth(0)
+	, MaxSendRate(FLiveBPRateBounds().InitialRateHz)
+{
+}
+
+FLiveBPOutboundWorker::~FLiveBPOutboundWorker()
+{
+	SetThreaded(false);
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+	WorkEvent = nullptr;
+}
+
+void FLiveBPOutboundWorker::SetThreaded(bool bInThreaded)
+{
+	bInThreaded = bInThreaded && FPlatformProcess::SupportsMultithreading();
+	if (bInThreaded == IsThreaded())
+	{
+		return;
+	}
+
+	if (bInThreaded)
+	{
+		bStopRequested = false;
+		Thread = FRunnableThread::Create(this, TEXT("LiveBPOutboundWorker"), 0, TPri_Normal);
+		if (!Thread)
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Could not start the LiveBP outbound worker; sending on the game thread"));
+		}
+		return;
+	}
+
+	// Run() drains whatever is left before it returns, so nothing queued is lost
+	Thread->Kill(true);
+	delete Thread;
+	Thread = nullptr;
+}
+
+void FLiveBPOutboundWorker::Enqueue(FLiveBPOutboundCommand&& Command)
+{
+	NumEnqueued.fetch_add(1, std::memory_order_relaxed);
+	Commands.Enqueue([&Command](FLiveBPOutboundCommand& Slot)
+	{
+		Slot = MoveTemp(Command);
+	});
+
+	if (IsThreaded())
+	{
+		WorkEvent->Trigger();
+	}
+	else
+	{
+		ProcessCommands();
+	}
+}
+
+void FLiveBPOutboundWorker::WaitUntilIdle()
+{
+	const uint64 Target = NumEnqueued.load(std::memory_order_relaxed);
+	while (NumProcessed.load(std::memory_order_acquire) < Target)
+	{
+		FPlatformProcess::Sleep(0.0f);
+	}
+}
+
+void FLiveBPOutboundWorker::SendReadyBatches(TFunctionRef<void(FLiveBPOutboundBatcher::FBatch& Batch)> Send)
+{
+	FLiveBPOutboundBatcher::FBatch Batch;
+	while (ReadyBatches.Dequeue(Batch))
+	{
+		Send(Batch);
+		SpareBatches.Enqueue(MoveTemp(Batch));
+	}
+}
+
+double FLiveBPOutboundWorker::ConsumeProcessingTime()
+{
+	return FPlatformTime::ToSeconds64(ProcessingCycles.exchange(0, std::memory_order_relaxed));
+}
+
+void FLiveBPOutboundWorker::GetSendRates(TMap<FGuid, FLiveBPPeerSendRate>& OutRates) const
+{
+	FScopeLock Lock(&SendRatesLock);
+	OutRates = SendRates;
+}
+
+uint32 FLiveBPOutboundWorker::Run()
+{
+	while (!bStopRequested)
+	{
+		WorkEvent->Wait();
+		ProcessCommands();
+	}
+
+	ProcessCommands();
+	return 0;
+}
+
+void FLiveBPOutboundWorker::Stop()
+{
+	bStopRequested = true;
+	WorkEvent->Trigger();
+}
+
+void FLiveBPOutboundWorker::ProcessCommands()
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	auto Process = [this](FLiveBPOutboundCommand& Command)
+	{
+		ProcessCommand(Command);
+		NumProcessed.fetch_add(1, std::memory_order_release);
+	};
+	while (Commands.Drain(Process) > 0)
+	{
+	}
+
+	const int32 Depth = Pipeline.GetQueueDepth();
+	QueueDepth.store(Depth, std::memory_order_relaxed);
+	const int32 Peak = Pipeline.ConsumePeakQueueDepth();
+	int32 PreviousPeak = PeakQueueDepth.load(std::memory_order_relaxed);
+	while (Peak > PreviousPeak && !PeakQueueDepth.compare_exchange_weak(PreviousPeak, Peak, std::memory_order_relaxed))
+	{
+	}
+
+	PublishSendRates();
+
+	ProcessingCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+}
+
+void FLiveBPOutboundWorker::ProcessCommand(FLiveBPOutboundCommand& Command)
+{
+	using EKind = FLiveBPOutboundCommand::EKind;
+
+	switch (Command.Kind)
+	{
+	case EKind::ApplySettings:
+		Pipeline.ApplySettings(Command.Data.Get<FLiveBPOutboundSettings>());
+		break;
+	case EKind::StartSession:
+	{
+		const FLiveBPOutboundSession& Session = Command.Data.Get<FLiveBPOutboundSession>();
+		Pipeline.StartSession(Session.UserId, Session.Endpoints);
+		break;
+	}
+	case EKind::EndSession:
+		Pipeline.EndSession();
+		break;
+	case EKind::AddEndpoint:
+		Pipeline.AddEndpoint(Command.Id);
+		break;
+	case EKind::RemoveEndpoint:
+		Pipeline.RemoveEndpoint(Command.Id);
+		break;
+	case EKind::SetRemoteInterest:
+		Pipeline.SetRemoteInterest(Command.Id, Command.Data.Get<TArray<FGuid>>());
+		break;
+	case EKind::SetLocalInterest:
+		Pipeline.SetLocalInterest(Command.Data.Get<TArray<FGuid>>());
+		break;
+	case EKind::Heartbeat:
+		Pipeline.OnHeartbeat(Command.Id, Command.Data.Get<FLiveBPHeartbeatReceipt>());
+		break;
+	case EKind::SetRemoteView:
+		Pipeline.SetRemoteView(Command.Id, Command.Data.Get<FLiveBPRemoteView>());
+		break;
+	case EKind::WirePreview:
+		Pipeline.SendWirePreview(Command.Data.Get<FLiveBPWirePreview>(), Command.Id, Command.GraphId);
+		break;
+	case EKind::BeginWirePreview:
+		Pipeline.BeginWirePreviewStream(Command.Data.Get<FLiveBPWirePreview>(), Command.Id, Command.GraphId);
+		break;
+	case EKind::UpdateWirePreview:
+		Pipeline.UpdateWirePreviewStream(Command.Data.Get<FVector2D>());
+		break;
+	case EKind::EndWirePreview:
+		Pipeline.EndWirePreviewStream();
+		break;
+	case EKind::NodeOperation:
+		Pipeline.SendNodeOperation(Command.Data.Get<FLiveBPNodeOperationData>(), Command.Id, Command.GraphId);
+		break;
+	case EKind::NodeMove:
+	{
+		const FLiveBPNodeMove& Move = Command.Data.Get<FLiveBPNodeMove>();
+		Pipeline.SendNodeMove(Move.NodeId, Move.Position, Command.Id, Command.GraphId);
+		break;
+	}
+	case EKind::LockRequest:
+		Pipeline.SendLockRequest(Command.Data.Get<FLiveBPNodeLock>(), Command.Id, Command.GraphId);
+		break;
+	case EKind::LockSet:
+		Pipeline.SendLockSet(Command.Data.Get<FLiveBPNodeLockSet>(), Command.Id, Command.GraphId);
+		break;
+	case EKind::Presence:
+		Pipeline.SendPresence(Command.Data.Get<FLiveBPPresence>(), Command.Id, Command.GraphId);
+		break;
+	case EKind::EndTick:
+		Pipeline.EndTick(FPlatformTime::Seconds());
+		break;
+	case EKind::Flush:
+		Pipeline.Flush();
+		break;
+	}
+}
+
+void FLiveBPOutboundWorker::OnBatchReady(FLiveBPOutboundBatcher::FBatch& Batch)
+{
+	// Trade the batch's storage for a spare that has already been sent; the batcher keeps the spare's capacity
+	FLiveBPOutboundBatcher::FBatch Ready;
+	SpareBatches.Dequeue(Ready);
+
+	Swap(Ready.Data, Batch.Data);
+	Ready.Destinations.Reset();
+	Ready.Destinations.Append(Batch.Destinations);
+	Ready.FrameCount = Batch.FrameCount;
+	Ready.Delivery = Batch.Delivery;
+
+	ReadyBatches.Enqueue(MoveTemp(Ready));
+}
+
+void FLiveBPOutboundWorker::PublishSendRates()
+{
+	const FLiveBPCongestionController& Congestion = Pipeline.GetCongestionController();
+	MaxSendRate.store(Congestion.GetMaxRate(), std::memory_order_relaxed);
+
+	FScopeLock Lock(&SendRatesLock);
+	Congestion.GetSendRates(SendRates);
+}
@@ -28,6 +28,17 @@ FLiveBPPerformanceMonitor::FScopeTimer::~FScopeTimer()
 FLiveBPPerformanceMonitor::FLiveBPPerformanceMonitor()
 	: bIsMonitoring(false)
 	, SessionStartTime(0.0f)
+	, BatchCount(0)
+	, BatchedFrameCount(0)
+	, BatchedBytes(0)
+	, PeakFramesPerBatch(0)
+	, UnreliableSentCount(0)
+	, UnreliableReceivedCount(0)
+	, UnreliableLostCount(0)
+	, UnreliableDroppedCount(0)
+	, OperationReceivedCount(0)
+	, OperationLostCount(0)
+	, OperationDuplicateCount(0)
 	, LatencyHistory()
 	, TotalErrorCount(0)
 	, NetworkErrorCount(0)
@@ -35,6 +46,10 @@ FLiveBPPerformanceMonitor::FLiveBPPerformanceMonitor()
 	, TimingHistory()
 	, FrameTimeHistory()
 	, CollaborationOverheadHistory()
+	, OutboundGameThreadHistory()
+	, OutboundOffloadedHistory()
+	, CurrentRemoteApplyBacklog(0)
+	, PeakRemoteApplyBacklog(0)
 	, CurrentConnectedUsers(0)
 	, bIsSessionActive(false)
 	, CurrentMessageQueueSize(0)
@@ -93,6 +108,34 @@ FLiveBPPerformanceMonitor::FPerformanceMetrics FLiveBPPerformanceMonitor::GetCur
 	Metrics.TotalMessagesSent = SentMessages.Count;
 	Metrics.TotalMessagesReceived = ReceivedMessages.Count;
 	
+	// Batching
+	Metrics.TotalBatchesSent = BatchCount;
+	if (BatchCount > 0)
+	{
+		Metrics.AverageFramesPerBatch = static_cast<float>(BatchedFrameCount) / BatchCount;
+		Metrics.AverageBatchBytes = static_cast<float>(BatchedBytes) / BatchCount;
+	}
+	Metrics.PeakFramesPerBatch = PeakFramesPerBatch;
+	
+	// Unreliable lane
+	Metrics.UnreliableMessagesSent = UnreliableSentCount;
+	Metrics.UnreliableMessagesReceived = UnreliableReceivedCount;
+	Metrics.UnreliableMessagesLost = UnreliableLostCount;
+	Metrics.UnreliableMessagesDropped = UnreliableDroppedCount;
+	if (UnreliableReceivedCount + UnreliableLostCount > 0)
+	{
+		Metrics.UnreliableLossRate = static_cast<float>(UnreliableLostCount) / (UnreliableReceivedCount + UnreliableLostCount);
+	}
+	
+	// Operation log
+	Metrics.OperationsReceived = OperationReceivedCount;
+	Metrics.OperationsLost = OperationLostCount;
+	Metrics.DuplicateOperationsDropped = OperationDuplicateCount;
+	
+	// Outbound worker
+	Metrics.OutboundGameThreadMs = CalculateAverage(OutboundGameThreadHistory);
+	Metrics.OutboundOffloadedMs = CalculateAverage(OutboundOffloadedHistory);
+	
 	// Calculate latency statistics
 	if (LatencyHistory.Num() > 0)
 	{
@@ -129,6 +172,8 @@ FLiveBPPerformanceMonitor::FPerformanceMetrics FLiveBPPerformanceMonitor::GetCur
 	// Frame performance
 	Metrics.AverageFrameTimeMs = CalculateAverage(FrameTimeHistory);
 	Metrics.CollaborationOverheadMs = CalculateAverage(CollaborationOverheadHistory);
+	Metrics.RemoteApplyBacklog = CurrentRemoteApplyBacklog;
+	Metrics.PeakRemoteApplyBacklog = PeakRemoteApplyBacklog;
 	
 	// Session info
 	Metrics.ConnectedUserCount = CurrentConnectedUsers;
@@ -174,6 +219,121 @@ void FLiveBPPerformanceMonitor::RecordMessageReceived(ELiveBPMessageType Message
 	TypeStats.LastTime = ReceivedMessages.LastTime;
 }
 
+void FLiveBPPerformanceMonitor::RecordBatchSent(int32 FrameCount, int32 BatchSize)
+{
+	if (!bIsMonitoring)
+		return;
+	
+	FScopeLock Lock(&StatsMutex);
+	
+	BatchCount++;
+	BatchedFrameCount += FrameCount;
+	BatchedBytes += BatchSize;
+	PeakFramesPerBatch = FMath::Max(PeakFramesPerBatch, FrameCount);
+}
+
+void FLiveBPPerformanceMonitor::RecordUnreliableSent()
+{
+	if (!bIsMonitoring)
+		return;
+	
+	FScopeLock Lock(&StatsMutex);
+	
+	UnreliableSentCount++;
+}
+
+void FLiveBPPerformanceMonitor::RecordUnreliableReceived(int32 LostCount, bool bDropped)
+{
+	if (!bIsMonitoring)
+		return;
+	
+	FScopeLock Lock(&StatsMutex);
+	
+	UnreliableReceivedCount++;
+	UnreliableLostCount += LostCount;
+	if (bDropped)
+	{
+		UnreliableDroppedCount++;
+	}
+}
+
+void FLiveBPPerformanceMonitor::RecordOperationReceived(int32 LostCount, bool bDuplicate)
+{
+	if (!bIsMonitoring)
+		return;
+	
+	FScopeLock Lock(&StatsMutex);
+	
+	OperationReceivedCount++;
+	OperationLostCount += LostCount;
+	if (bDuplicate)
+	{
+		OperationDuplicateCount++;
+	}
+}
+
+void FLiveBPPerformanceMonitor::RecordCompression(ELiveBPMessageType MessageType, int32 RawSize, int32 SentSize, float DurationMs)
+{
+	if (!bIsMonitoring)
+		return;
+	
+	FScopeLock Lock(&StatsMutex);
+	
+	FCompressionStats& Stats = CompressionStats.FindOrAdd(MessageType);
+	Stats.Attempts++;
+	Stats.RawBytes += RawSize;
+	Stats.SentBytes += SentSize;
+	Stats.CompressTimeMs += DurationMs;
+	if (SentSize < RawSize)
+	{
+		Stats.CompressedCount++;
+	}
+}
+
+void FLiveBPPerformanceMonitor::RecordDecompression(ELiveBPMessageType MessageType, float DurationMs)
+{
+	if (!bIsMonitoring)
+		return;
+	
+	FScopeLock Lock(&StatsMutex);
+	
+	FCompressionStats& Stats = CompressionStats.FindOrAdd(MessageType);
+	Stats.Decompressions++;
+	Stats.DecompressTimeMs += DurationMs;
+}
+
+TMap<ELiveBPMessageType, FLiveBPPerformanceMonitor::FCompressionMetrics> FLiveBPPerformanceMonitor::GetCompressionMetrics() const
+{
+	FScopeLock Lock(&StatsMutex);
+	
+	TMap<ELiveBPMessageType, FCompressionMetrics> Result;
+	
+	for (const auto& Pair : CompressionStats)
+	{
+		const FCompressionStats& Stats = Pair.Value;
+		FCompressionMetrics& Metrics = Result.Add(Pair.Key);
+		Metrics.Attempts = Stats.Attempts;
+		Metrics.CompressedCount = Stats.CompressedCount;
+		Metrics.RawBytes = Stats.RawBytes;
+		Metrics.SentBytes = Stats.SentBytes;
+		if (Stats.RawBytes > 0)
+		{
+			Metrics.CompressionRatio = static_cast<float>(static_cast<double>(Stats.SentBytes) / Stats.RawBytes);
+		}
+		if (Stats.Attempts > 0)
+		{
+			Metrics.AverageCompressTimeMs = static_cast<float>(Stats.CompressTimeMs / Stats.Attempts);
+		}
+		Metrics.Decompressions = Stats.Decompressions;
+		if (Stats.Decompressions > 0)
+		{
+			Metrics.AverageDecompressTimeMs = static_cast<float>(Stats.DecompressTimeMs / Stats.Decompressions);
+		}
+	}
+	
+	return Result;
+}
+
 void FLiveBPPerformanceMonitor::RecordError(const FString& ErrorType, bool bIsNetworkError)
 {
 	if (!bIsMonitoring)
@@ -216,7 +376,7 @@ void FLiveBPPerformanceMonitor::UpdateMemoryStats(int32 MessageQueueSize, int32
 	CurrentCachedUserCount = CachedUserCount;
 }
 
-void FLiveBPPerformanceMonitor::RecordFramePerformance(float FrameTimeMs, float CollaborationOverheadMs)
+void FLiveBPPerformanceMonitor::RecordFramePerformance(float FrameTimeMs, float CollaborationOverheadMs, int32 RemoteApplyBacklog)
 {
 	if (!bIsMonitoring)
 		return;
@@ -225,6 +385,19 @@ void FLiveBPPerformanceMonitor::RecordFramePerformance(float FrameTimeMs, float
 	
 	FrameTimeHistory.Add(FrameTimeMs);
 	CollaborationOverheadHistory.Add(CollaborationOverheadMs);
+	CurrentRemoteApplyBacklog = RemoteApplyBacklog;
+	PeakRemoteApplyBacklog = FMath::Max(PeakRemoteApplyBacklog, RemoteApplyBacklog);
+}
+
+void FLiveBPPerformanceMonitor::RecordOutboundFrame(float GameThreadMs, float OffloadedMs)
+{
+	if (!bIsMonitoring)
+		return;
+	
+	FScopeLock Lock(&StatsMutex);
+	
+	OutboundGameThreadHistory.Add(GameThreadMs);
+	OutboundOffloadedHistory.Add(OffloadedMs);
 }
 
 void FLiveBPPerformanceMonitor::AddTimerMeasurement(const FString& Name, float DurationMs)
@@ -278,6 +451,30 @@ void FLiveBPPerformanceMonitor::ResetStats()
 	ReceivedMessages = FMessageStats();
 	MessageTypeStats.Empty();
 	
+	// Reset compression stats
+	CompressionStats.Empty();
+	
+	// Reset batch stats
+	BatchCount = 0;
+	BatchedFrameCount = 0;
+	BatchedBytes = 0;
+	PeakFramesPerBatch = 0;
+	
+	// Reset unreliable lane stats
+	UnreliableSentCount = 0;
+	UnreliableReceivedCount = 0;
+	UnreliableLostCount = 0;
+	UnreliableDroppedCount = 0;
+	
+	// Reset operation log stats
+	OperationReceivedCount = 0;
+	OperationLostCount = 0;
+	OperationDuplicateCount = 0;
+	
+	// Reset outbound worker stats
+	OutboundGameThreadHistory.Reset();
+	OutboundOffloadedHistory.Reset();
+	
 	// Reset latency tracking
 	LatencyHistory.Reset();
 	
@@ -294,6 +491,8 @@ void FLiveBPPerformanceMonitor::ResetStats()
 	// Reset frame performance
 	FrameTimeHistory.Reset();
 	CollaborationOverheadHistory.Reset();
+	CurrentRemoteApplyBacklog = 0;
+	PeakRemoteApplyBacklog = 0;
 }
 
 void FLiveBPPerformanceMonitor::SetMonitoringEnabled(bool bEnabled)
@@ -317,6 +516,7 @@ FString FLiveBPPerformanceMonitor::GetPerformanceReport() const
 {
 	FPerformanceMetrics Metrics = GetCurrentMetrics();
 	TMap<FString, float> DetailedTimingsMap = GetDetailedTimings();
+	TMap<ELiveBPMessageType, FCompressionMetrics> CompressionMetricsMap = GetCompressionMetrics();
 	
 	FString Report;
 	Report += TEXT("=== LiveBP Performance Report ===\n");
@@ -331,6 +531,44 @@ FString FLiveBPPerformanceMonitor::GetPerformanceReport() const
 	Report += FString::Printf(TEXT("Messages Per Second: %.1f\n"), Metrics.MessagesPerSecond);
 	Report += TEXT("\n");
 	
+	Report += TEXT("--- Outbound Batching ---\n");
+	Report += FString::Printf(TEXT("Batches Sent: %d\n"), Metrics.TotalBatchesSent);
+	Report += FString::Printf(TEXT("Average Frames Per Batch: %.1f\n"), Metrics.AverageFramesPerBatch);
+	Report += FString::Printf(TEXT("Peak Frames Per Batch: %d\n"), Metrics.PeakFramesPerBatch);
+	Report += FString::Printf(TEXT("Average Batch Size: %.0f bytes\n"), Metrics.AverageBatchBytes);
+	Report += TEXT("\n");
+	
+	Report += TEXT("--- Unreliable Lane ---\n");
+	Report += FString::Printf(TEXT("Sent: %d\n"), Metrics.UnreliableMessagesSent);
+	Report += FString::Printf(TEXT("Received: %d\n"), Metrics.UnreliableMessagesReceived);
+	Report += FString::Printf(TEXT("Lost: %d (%.1f%%)\n"), Metrics.UnreliableMessagesLost, Metrics.UnreliableLossRate * 100.0f);
+	Report += FString::Printf(TEXT("Dropped Out Of Order: %d\n"), Metrics.UnreliableMessagesDropped);
+	Report += TEXT("\n");
+	
+	Report += TEXT("--- Operation Log ---\n");
+	Report += FString::Printf(TEXT("Received: %d\n"), Metrics.OperationsReceived);
+	Report += FString::Printf(TEXT("Lost: %d\n"), Metrics.OperationsLost);
+	Report += FString::Printf(TEXT("Duplicates Dropped: %d\n"), Metrics.DuplicateOperationsDropped);
+	Report += TEXT("\n");
+	
+	Report += TEXT("--- Outbound Worker ---\n");
+	Report += FString::Printf(TEXT("Game Thread Send Time: %.3f ms/frame\n"), Metrics.OutboundGameThreadMs);
+	Report += FString::Printf(TEXT("Saved By Worker: %.3f ms/frame\n"), Metrics.OutboundOffloadedMs);
+	Report += TEXT("\n");
+	
+	if (CompressionMetricsMap.Num() > 0)
+	{
+		Report += TEXT("--- Payload Compression ---\n");
+		for (const auto& Pair : CompressionMetricsMap)
+		{
+			const FCompressionMetrics& Compression = Pair.Value;
+			Report += FString::Printf(TEXT("%s: %d/%d compressed, ratio %.2f, compress %.3f ms, decompress %.3f ms\n"),
+				*UEnum::GetValueAsString(Pair.Key), Compression.CompressedCount, Compression.Attempts,
+				Compression.CompressionRatio, Compression.AverageCompressTimeMs, Compression.AverageDecompressTimeMs);
+		}
+		Report += TEXT("\n");
+	}
+	
 	Report += TEXT("--- Network Performance ---\n");
 	Report += FString::Printf(TEXT("Average Latency: %.1f ms\n"), Metrics.AverageLatencyMs);
 	Report += FString::Printf(TEXT("Peak Latency: %.1f ms\n"), Metrics.PeakLatencyMs);
@@ -354,6 +592,7 @@ FString FLiveBPPerformanceMonitor::GetPerformanceReport() const
 	Report += TEXT("--- Frame Performance ---\n");
 	Report += FString::Printf(TEXT("Average Frame Time: %.1f ms\n"), Metrics.AverageFrameTimeMs);
 	Report += FString::Printf(TEXT("Collaboration Overhead: %.1f ms\n"), Metrics.CollaborationOverheadMs);
+	Report += FString::Printf(TEXT("Remote Apply Backlog: %d (peak %d)\n"), Metrics.RemoteApplyBacklog, Metrics.PeakRemoteApplyBacklog);
 	Report += TEXT("\n");
 	
 	if (DetailedTimingsMap.Num() > 0)
@@ -428,7 +667,7 @@ float FLiveBPPerformanceMonitor::EstimateMemoryUsage() const
 	// History buffers
 	EstimatedBytes += LatencyHistory.Num() * sizeof(FLatencyMeasurement);
 	EstimatedBytes += TimingHistory.Num() * sizeof(FTimingMeasurement);
-	EstimatedBytes += FrameTimeHistory.Num() * sizeof(float) * 2; // Frame time + overhead
+	EstimatedBytes += FrameTimeHistory.Num() * sizeof(float) * 4; // Frame time, overhead and outbound send times
 	
 	return EstimatedBytes / (1024.0f * 1024.0f); // Convert to MB
 }
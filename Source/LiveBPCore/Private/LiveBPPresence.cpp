@@ -0,0 +1,96 @@
+#include "LiveBPPresence.h"
+
+namespace LiveBPPresence
+{
+	// Fraction of the view size added on every side when culling against it
+	static const float ViewMargin = 0.25f;
+
+	int32 ToCell(double Value)
+	{
+		return FMath::FloorToInt32(Value / FLiveBPPresenceEncoder::GridSize);
+	}
+
+	bool HasMoved(const FIntPoint& From, const FIntPoint& To, float ThresholdCells)
+	{
+		return FVector2D::DistSquared(FVector2D(From), FVector2D(To)) >= FMath::Square(ThresholdCells);
+	}
+}
+
+FLiveBPPresenceEncoder::FLiveBPPresenceEncoder()
+	: bHasSent(false)
+	, LastSendTime(0.0)
+{
+}
+
+FLiveBPPresence FLiveBPPresenceEncoder::Quantize(const FVector2D* Cursor, const FBox2D& View)
+{
+	FLiveBPPresence Presence;
+	if (Cursor)
+	{
+		Presence.bHasCursor = true;
+		Presence.Cursor = FIntPoint(FMath::RoundToInt32(Cursor->X / GridSize), FMath::RoundToInt32(Cursor->Y / GridSize));
+	}
+
+	// Rounded outwards, so the quantized view always covers the real one
+	Presence.View.Min = FIntPoint(LiveBPPresence::ToCell(View.Min.X), LiveBPPresence::ToCell(View.Min.Y));
+	Presence.View.Max = FIntPoint(LiveBPPresence::ToCell(View.Max.X) + 1, LiveBPPresence::ToCell(View.Max.Y) + 1);
+	return Presence;
+}
+
+bool FLiveBPPresenceEncoder::Update(const FLiveBPPresence& Presence, const FGuid& InBlueprintId, const FGuid& InGraphId, float MovementThreshold,
+	double CurrentTime)
+{
+	// Quantization already hides anything below one cell
+	const float ThresholdCells = FMath::Max(MovementThreshold / GridSize, 1.0f);
+
+	const bool bChanged = !bHasSent
+		|| InBlueprintId != BlueprintId
+		|| InGraphId != GraphId
+		|| Presence.bHasCursor != LastSent.bHasCursor
+		|| (Presence.bHasCursor && LiveBPPresence::HasMoved(LastSent.Cursor, Presence.Cursor, ThresholdCells))
+		|| LiveBPPresence::HasMoved(LastSent.View.Min, Presence.View.Min, ThresholdCells)
+		|| LiveBPPresence::HasMoved(LastSent.View.Max, Presence.View.Max, ThresholdCells);
+	if (!bChanged)
+	{
+		return false;
+	}
+
+	bHasSent = true;
+	LastSendTime = CurrentTime;
+	LastSent = Presence;
+	BlueprintId = InBlueprintId;
+	GraphId = InGraphId;
+	return true;
+}
+
+bool FLiveBPPresenceEncoder::ConsumeKeepAlive(double CurrentTime)
+{
+	if (!bHasSent || CurrentTime - LastSendTime < KeepAliveInterval)
+	{
+		return false;
+	}
+
+	LastSendTime = CurrentTime;
+	return true;
+}
+
+void FLiveBPPresenceEncoder::Reset()
+{
+	bHasSent = false;
+	LastSendTime = 0.0;
+	LastSent = FLiveBPPresence();
+	BlueprintId.Invalidate();
+	GraphId.Invalidate();
+}
+
+bool FLiveBPPresenceEncoder::IsVisible(const FLiveBPRemoteView& RemoteView, const FGuid& InBlueprintId, const FGuid& InGraphId, const FBox2D& Bounds)
+{
+	if (RemoteView.BlueprintId != InBlueprintId || RemoteView.GraphId != InGraphId)
+	{
+		return false;
+	}
+
+	const FBox2D View = ToGraph(RemoteView.View);
+	const FVector2D Margin = View.GetSize() * LiveBPPresence::ViewMargin;
+	return FBox2D(View.Min - Margin, View.Max + Margin).Intersect(Bounds);
+}
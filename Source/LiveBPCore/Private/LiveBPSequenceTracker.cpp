@@ -0,0 +1,36 @@
+#include "LiveBPSequenceTracker.h"
+#include "LiveBPCore.h"
+
+uint32 FLiveBPSequenceTracker::Next(ELiveBPMessageType MessageType, const FGuid& BlueprintId)
+{
+	uint32& Sequence = Streams.FindOrAdd(MakeTuple(MessageType, BlueprintId), 0);
+	if (++Sequence == 0)
+	{
+		++Sequence;
+	}
+	return Sequence;
+}
+
+FLiveBPSequenceTracker::EAcceptResult FLiveBPSequenceTracker::Accept(ELiveBPMessageType MessageType, const FGuid& BlueprintId, uint32 Sequence, int32& OutLostCount)
+{
+	OutLostCount = 0;
+
+	uint32* Last = Streams.Find(MakeTuple(MessageType, BlueprintId));
+	if (!Last)
+	{
+		// First message we see on this stream; earlier ones predate our interest, not losses
+		Streams.Add(MakeTuple(MessageType, BlueprintId), Sequence);
+		return EAcceptResult::Accepted;
+	}
+
+	// Serial number arithmetic, so the comparison survives wrap-around
+	const int32 Distance = static_cast<int32>(Sequence - *Last);
+	if (Distance <= 0)
+	{
+		return EAcceptResult::Superseded;
+	}
+
+	OutLostCount = Distance - 1;
+	*Last = Sequence;
+	return EAcceptResult::Accepted;
+}
@@ -0,0 +1,186 @@
+#include "LiveBPSessionDictionary.h"
+#include "LiveBPCore.h"
+#include "LiveBPBinaryCodec.h"
+
+// Upper bound on handles per kind accepted from a peer
+static const int32 MAX_NAMES_PER_KIND = 1 << 20;
+
+// FLiveBPNameInterner implementation
+uint32 FLiveBPNameInterner::Intern(ELiveBPNameKind Kind, const FString& Value)
+{
+	check(!IsGuidNameKind(Kind));
+	const int32 KindIndex = static_cast<int32>(Kind);
+
+	if (const uint32* Existing = StringHandles[KindIndex].Find(Value))
+	{
+		return *Existing;
+	}
+
+	const uint32 Handle = Strings[KindIndex].Add(Value);
+	StringHandles[KindIndex].Add(Value, Handle);
+	PendingDefinitions.Add({ Kind, Handle });
+	return Handle;
+}
+
+uint32 FLiveBPNameInterner::Intern(ELiveBPNameKind Kind, const FGuid& Value)
+{
+	check(IsGuidNameKind(Kind));
+	const int32 KindIndex = static_cast<int32>(Kind);
+
+	if (const uint32* Existing = GuidHandles[KindIndex].Find(Value))
+	{
+		return *Existing;
+	}
+
+	const uint32 Handle = Guids[KindIndex].Add(Value);
+	GuidHandles[KindIndex].Add(Value, Handle);
+	PendingDefinitions.Add({ Kind, Handle });
+	return Handle;
+}
+
+void FLiveBPNameInterner::WritePendingDefinitions(FLiveBPBinaryWriter& Writer)
+{
+	Writer.WriteVarUInt(PendingDefinitions.Num());
+	for (const FDefinition& Definition : PendingDefinitions)
+	{
+		WriteDefinition(Writer, Definition);
+	}
+	PendingDefinitions.Reset();
+}
+
+void FLiveBPNameInterner::WriteSnapshot(FLiveBPBinaryWriter& Writer) const
+{
+	Writer.WriteVarUInt(NumDefinitions());
+	for (int32 KindIndex = 0; KindIndex < static_cast<int32>(ELiveBPNameKind::Count); ++KindIndex)
+	{
+		const ELiveBPNameKind Kind = static_cast<ELiveBPNameKind>(KindIndex);
+		const int32 Count = IsGuidNameKind(Kind) ? Guids[KindIndex].Num() : Strings[KindIndex].Num();
+		for (int32 Handle = 0; Handle < Count; ++Handle)
+		{
+			WriteDefinition(Writer, { Kind, static_cast<uint32>(Handle) });
+		}
+	}
+}
+
+int32 FLiveBPNameInterner::NumDefinitions() const
+{
+	int32 Total = 0;
+	for (int32 KindIndex = 0; KindIndex < static_cast<int32>(ELiveBPNameKind::Count); ++KindIndex)
+	{
+		Total += Strings[KindIndex].Num() + Guids[KindIndex].Num();
+	}
+	return Total;
+}
+
+void FLiveBPNameInterner::Reset()
+{
+	for (int32 KindIndex = 0; KindIndex < static_cast<int32>(ELiveBPNameKind::Count); ++KindIndex)
+	{
+		StringHandles[KindIndex].Reset();
+		GuidHandles[KindIndex].Reset();
+		Strings[KindIndex].Reset();
+		Guids[KindIndex].Reset();
+	}
+	PendingDefinitions.Reset();
+}
+
+void FLiveBPNameInterner::WriteDefinition(FLiveBPBinaryWriter& Writer, const FDefinition& Definition) const
+{
+	const int32 KindIndex = static_cast<int32>(Definition.Kind);
+
+	Writer.WriteByte(static_cast<uint8>(Definition.Kind));
+	Writer.WriteVarUInt(Definition.Handle);
+	if (IsGuidNameKind(Definition.Kind))
+	{
+		Writer.WriteGuid(Guids[KindIndex][Definition.Handle]);
+	}
+	else
+	{
+		Writer.WriteString(Strings[KindIndex][Definition.Handle]);
+	}
+}
+
+// FLiveBPNameTable implementation
+bool FLiveBPNameTable::ReadDefinitions(FLiveBPBinaryReader& Reader)
+{
+	const uint64 Count = Reader.ReadVarUInt();
+	for (uint64 Index = 0; Index < Count && !Reader.IsError(); ++Index)
+	{
+		const uint8 KindValue = Reader.ReadByte();
+		if (KindValue >= static_cast<uint8>(ELiveBPNameKind::Count))
+		{
+			UE_LOG(LogLiveBPCore, Warning, TEXT("Session dictionary definition has unknown kind %d"), KindValue);
+			return false;
+		}
+
+		const ELiveBPNameKind Kind = static_cast<ELiveBPNameKind>(KindValue);
+		const int32 KindIndex = static_cast<int32>(Kind);
+		const uint64 Handle = Reader.ReadVarUInt();
+
+		// Handles are dense, so a definition either repeats a known handle (snapshots) or appends the next one
+		if (IsGuidNameKind(Kind))
+		{
+			TArray<FGuid>& Values = Guids[KindIndex];
+			const FGuid Value = Reader.ReadGuid();
+			if (Handle < static_cast<uint64>(Values.Num()))
+			{
+				if (Values[Handle] != Value)
+				{
+					return false;
+				}
+			}
+			else if (Handle == static_cast<uint64>(Values.Num()) && Values.Num() < MAX_NAMES_PER_KIND)
+			{
+				Values.Add(Value);
+			}
+			else
+			{
+				return false;
+			}
+		}
+		else
+		{
+			TArray<FString>& Values = Strings[KindIndex];
+			FString Value = Reader.ReadString();
+			if (Handle < static_cast<uint64>(Values.Num()))
+			{
+				if (!Values[Handle].Equals(Value, ESearchCase::CaseSensitive))
+				{
+					return false;
+				}
+			}
+			else if (Handle == static_cast<uint64>(Values.Num()) && Values.Num() < MAX_NAMES_PER_KIND)
+			{
+				Values.Add(MoveTemp(Value));
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+
+	return !Reader.IsError();
+}
+
+const FString* FLiveBPNameTable::FindString(ELiveBPNameKind Kind, uint64 Handle) const
+{
+	const TArray<FString>& Values = Strings[static_cast<int32>(Kind)];
+	return Handle < static_cast<uint64>(Values.Num()) ? &Values[Handle] : nullptr;
+}
+
+const FGuid* FLiveBPNameTable::FindGuid(ELiveBPNameKind Kind, uint64 Handle) const
+{
+	const TArray<FGuid>& Values = Guids[static_cast<int32>(Kind)];
+	return Handle < static_cast<uint64>(Values.Num()) ? &Values[Handle] : nullptr;
+}
+
+int32 FLiveBPNameTable::NumDefinitions() const
+{
+	int32 Total = 0;
+	for (int32 KindIndex = 0; KindIndex < static_cast<int32>(ELiveBPNameKind::Count); ++KindIndex)
+	{
+		Total += Strings[KindIndex].Num() + Guids[KindIndex].Num();
+	}
+	return Total;
+}
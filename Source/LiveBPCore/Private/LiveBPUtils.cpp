@@ -1,16 +1,11 @@
 #include "LiveBPUtils.h"
 #include "LiveBPCore.h"
+#include "LiveBPBinaryCodec.h"
+#include "LiveBPMessageThrottler.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonReader.h"
-#include "Serialization/MemoryWriter.h"
-#include "Serialization/MemoryReader.h"
-
-// Message throttle intervals (in seconds)
-static const float WIRE_PREVIEW_THROTTLE = 0.1f;  // 10Hz
-static const float NODE_OPERATION_THROTTLE = 0.0f; // No throttling for structural changes
-static const float LOCK_MESSAGE_THROTTLE = 0.0f;   // No throttling for locks
 
 TArray<uint8> FLiveBPUtils::SerializeToJson(const FLiveBPNodeOperationData& NodeOperation)
 {
@@ -20,8 +15,9 @@ TArray<uint8> FLiveBPUtils::SerializeToJson(const FLiveBPNodeOperationData& Node
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
 	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
 	
+	FTCHARToUTF8 Utf8(*JsonString, JsonString.Len());
 	TArray<uint8> Result;
-	Result.Append(reinterpret_cast<const uint8*>(TCHAR_TO_UTF8(*JsonString)), JsonString.Len());
+	Result.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
 	return Result;
 }
 
@@ -33,15 +29,16 @@ TArray<uint8> FLiveBPUtils::SerializeToJson(const FLiveBPNodeLock& NodeLock)
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
 	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
 	
+	FTCHARToUTF8 Utf8(*JsonString, JsonString.Len());
 	TArray<uint8> Result;
-	Result.Append(reinterpret_cast<const uint8*>(TCHAR_TO_UTF8(*JsonString)), JsonString.Len());
+	Result.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
 	return Result;
 }
 
-bool FLiveBPUtils::DeserializeFromJson(const TArray<uint8>& Data, FLiveBPNodeOperationData& OutNodeOperation)
+bool FLiveBPUtils::DeserializeFromJson(TArrayView<const uint8> Data, FLiveBPNodeOperationData& OutNodeOperation)
 {
-	FString JsonString;
-	JsonString.AppendChars(reinterpret_cast<const TCHAR*>(Data.GetData()), Data.Num() / sizeof(TCHAR));
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData()), Data.Num());
+	FString JsonString(Converted.Length(), Converted.Get());
 	
 	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
@@ -54,10 +51,10 @@ bool FLiveBPUtils::DeserializeFromJson(const TArray<uint8>& Data, FLiveBPNodeOpe
 	return false;
 }
 
-bool FLiveBPUtils::DeserializeFromJson(const TArray<uint8>& Data, FLiveBPNodeLock& OutNodeLock)
+bool FLiveBPUtils::DeserializeFromJson(TArrayView<const uint8> Data, FLiveBPNodeLock& OutNodeLock)
 {
-	FString JsonString;
-	JsonString.AppendChars(reinterpret_cast<const TCHAR*>(Data.GetData()), Data.Num() / sizeof(TCHAR));
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData()), Data.Num());
+	FString JsonString(Converted.Length(), Converted.Get());
 	
 	TSharedPtr<FJsonObject> JsonObject;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
@@ -70,48 +67,54 @@ bool FLiveBPUtils::DeserializeFromJson(const TArray<uint8>& Data, FLiveBPNodeLoc
 	return false;
 }
 
+bool FLiveBPUtils::DeserializeNodeOperation(TArrayView<const uint8> Data, FLiveBPNodeOperationData& OutNodeOperation, const FLiveBPNameTable* Names)
+{
+	if (FLiveBPBinaryCodec::IsBinaryPayload(Data))
+	{
+		return FLiveBPBinaryCodec::DecodeNodeOperation(Data, OutNodeOperation, Names);
+	}
+	return DeserializeFromJson(Data, OutNodeOperation);
+}
+
+bool FLiveBPUtils::DeserializeNodeLock(TArrayView<const uint8> Data, FLiveBPNodeLock& OutNodeLock, const FLiveBPNameTable* Names)
+{
+	if (FLiveBPBinaryCodec::IsBinaryPayload(Data))
+	{
+		return FLiveBPBinaryCodec::DecodeNodeLock(Data, OutNodeLock, Names);
+	}
+	return DeserializeFromJson(Data, OutNodeLock);
+}
+
 TArray<uint8> FLiveBPUtils::SerializeToBinary(const FLiveBPWirePreview& WirePreview)
 {
 	TArray<uint8> Result;
-	FMemoryWriter Writer(Result);
-	
-	Writer << const_cast<FGuid&>(WirePreview.NodeId);
-	Writer << const_cast<FString&>(WirePreview.PinName);
-	Writer << const_cast<FVector2D&>(WirePreview.StartPosition);
-	Writer << const_cast<FVector2D&>(WirePreview.EndPosition);
-	Writer << const_cast<FString&>(WirePreview.UserId);
-	Writer << const_cast<float&>(WirePreview.Timestamp);
-	
+	FLiveBPBinaryCodec::EncodeWirePreview(WirePreview, Result);
 	return Result;
 }
 
-bool FLiveBPUtils::DeserializeFromBinary(const TArray<uint8>& Data, FLiveBPWirePreview& OutWirePreview)
+bool FLiveBPUtils::DeserializeFromBinary(TArrayView<const uint8> Data, FLiveBPWirePreview& OutWirePreview, const FLiveBPNameTable* Names)
 {
-	if (Data.Num() == 0)
-	{
-		return false;
-	}
-	
-	FMemoryReader Reader(Data);
-	
-	try
-	{
-		Reader << OutWirePreview.NodeId;
-		Reader << OutWirePreview.PinName;
-		Reader << OutWirePreview.StartPosition;
-		Reader << OutWirePreview.EndPosition;
-		Reader << OutWirePreview.UserId;
-		Reader << OutWirePreview.Timestamp;
-		return true;
-	}
-	catch (...)
+	if (!FLiveBPBinaryCodec::DecodeWirePreview(Data, OutWirePreview, Names))
 	{
 		UE_LOG(LogLiveBPCore, Warning, TEXT("Failed to deserialize wire preview data"));
 		return false;
 	}
+	return true;
 }
 
 bool FLiveBPUtils::IsValidMessage(const FLiveBPMessage& Message)
+{
+	FLiveBPMessageView View;
+	View.MessageType = Message.MessageType;
+	View.UserId = &Message.UserId;
+	View.BlueprintId = Message.BlueprintId;
+	View.GraphId = Message.GraphId;
+	View.Timestamp = Message.Timestamp;
+	View.Payload = Message.PayloadData;
+	return IsValidMessage(View);
+}
+
+bool FLiveBPUtils::IsValidMessage(const FLiveBPMessageView& Message)
 {
 	// Basic validation
 	if (!Message.BlueprintId.IsValid() || !Message.GraphId.IsValid())
@@ -119,7 +122,7 @@ bool FLiveBPUtils::IsValidMessage(const FLiveBPMessage& Message)
 		return false;
 	}
 	
-	if (Message.UserId.IsEmpty() || Message.Timestamp <= 0.0f)
+	if (!Message.UserId || Message.UserId->IsEmpty() || Message.Timestamp <= 0.0f)
 	{
 		return false;
 	}
@@ -128,14 +131,20 @@ bool FLiveBPUtils::IsValidMessage(const FLiveBPMessage& Message)
 	switch (Message.MessageType)
 	{
 	case ELiveBPMessageType::WirePreview:
-		return Message.PayloadData.Num() > 0;
+		return Message.Payload.Num() > 0;
 	case ELiveBPMessageType::NodeOperation:
-		return Message.PayloadData.Num() > 0;
+	case ELiveBPMessageType::NodeMoves:
+	case ELiveBPMessageType::NodeTransaction:
+		return Message.Payload.Num() > 0;
 	case ELiveBPMessageType::LockRequest:
 	case ELiveBPMessageType::LockRelease:
-		return Message.PayloadData.Num() > 0;
+	case ELiveBPMessageType::LockSet:
+		return Message.Payload.Num() > 0;
 	case ELiveBPMessageType::Heartbeat:
 		return true; // Heartbeat doesn't need payload
+	case ELiveBPMessageType::Interest:
+	case ELiveBPMessageType::Presence:
+		return Message.Payload.Num() > 0;
 	default:
 		return false;
 	}
@@ -196,20 +205,8 @@ bool FLiveBPUtils::ShouldThrottleMessage(ELiveBPMessageType MessageType, float L
 
 float FLiveBPUtils::GetThrottleInterval(ELiveBPMessageType MessageType)
 {
-	switch (MessageType)
-	{
-	case ELiveBPMessageType::WirePreview:
-		return WIRE_PREVIEW_THROTTLE;
-	case ELiveBPMessageType::NodeOperation:
-		return NODE_OPERATION_THROTTLE;
-	case ELiveBPMessageType::LockRequest:
-	case ELiveBPMessageType::LockRelease:
-		return LOCK_MESSAGE_THROTTLE;
-	case ELiveBPMessageType::Heartbeat:
-		return 1.0f; // 1 second heartbeat
-	default:
-		return 0.0f;
-	}
+	// One table for the whole plugin; the preview interval follows the congestion-controlled send rate
+	return FLiveBPGlobalThrottler::Get().GetThrottleInterval(MessageType);
 }
 
 FString FLiveBPUtils::NodeOperationToString(ELiveBPNodeOperation Operation)
@@ -246,6 +243,11 @@ FString FLiveBPUtils::MessageTypeToString(ELiveBPMessageType MessageType)
 	case ELiveBPMessageType::LockRequest: return TEXT("LockRequest");
 	case ELiveBPMessageType::LockRelease: return TEXT("LockRelease");
 	case ELiveBPMessageType::Heartbeat: return TEXT("Heartbeat");
+	case ELiveBPMessageType::Interest: return TEXT("Interest");
+	case ELiveBPMessageType::Presence: return TEXT("Presence");
+	case ELiveBPMessageType::NodeMoves: return TEXT("NodeMoves");
+	case ELiveBPMessageType::NodeTransaction: return TEXT("NodeTransaction");
+	case ELiveBPMessageType::LockSet: return TEXT("LockSet");
 	default: return TEXT("Unknown");
 	}
 }
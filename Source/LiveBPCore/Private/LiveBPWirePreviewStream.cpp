@@ -0,0 +1,163 @@
+#include "LiveBPWirePreviewStream.h"
+#include "LiveBPCore.h"
+
+namespace LiveBPWirePreviewStream
+{
+	FIntPoint Quantize(const FVector2D& Position)
+	{
+		return FIntPoint(FMath::RoundToInt(Position.X), FMath::RoundToInt(Position.Y));
+	}
+
+	bool FitsInt16(const FIntPoint& Offset)
+	{
+		return Offset.X >= MIN_int16 && Offset.X <= MAX_int16 && Offset.Y >= MIN_int16 && Offset.Y <= MAX_int16;
+	}
+}
+
+// FLiveBPWirePreviewEncoder implementation
+FLiveBPWirePreviewEncoder::FLiveBPWirePreviewEncoder()
+	: bActive(false)
+	, KeyframeId(0)
+	, KeyframeEnd(FIntPoint::ZeroValue)
+	, LastSentEnd(FIntPoint::ZeroValue)
+	, LastSentPosition(FVector2D::ZeroVector)
+{
+}
+
+void FLiveBPWirePreviewEncoder::Begin(const FLiveBPWirePreview& WirePreview, FLiveBPBinaryWriter& Writer)
+{
+	bActive = true;
+	KeyframeId = (KeyframeId + 1) & FLiveBPBinaryCodec::WirePreviewKeyframeIdMask;
+	KeyframeEnd = LiveBPWirePreviewStream::Quantize(WirePreview.EndPosition);
+	LastSentEnd = KeyframeEnd;
+	LastSentPosition = WirePreview.EndPosition;
+
+	FLiveBPBinaryCodec::FWirePreviewPacket Packet;
+	Packet.Event = FLiveBPBinaryCodec::EWirePreviewEvent::Begin;
+	Packet.KeyframeId = KeyframeId;
+	Packet.NodeId = WirePreview.NodeId;
+	Packet.PinName = WirePreview.PinName;
+	Packet.StartPosition = LiveBPWirePreviewStream::Quantize(WirePreview.StartPosition);
+	Packet.EndPosition = KeyframeEnd;
+	FLiveBPBinaryCodec::EncodeWirePreviewPacket(Packet, Writer);
+}
+
+FLiveBPWirePreviewEncoder::EUpdateResult FLiveBPWirePreviewEncoder::Update(const FVector2D& EndPosition, float MinimumMovement, FLiveBPBinaryWriter& Writer)
+{
+	if (!bActive)
+	{
+		return EUpdateResult::Suppressed;
+	}
+
+	const FIntPoint Quantized = LiveBPWirePreviewStream::Quantize(EndPosition);
+	if (Quantized == LastSentEnd || FVector2D::DistSquared(EndPosition, LastSentPosition) < FMath::Square(MinimumMovement))
+	{
+		return EUpdateResult::Suppressed;
+	}
+
+	LastSentEnd = Quantized;
+	LastSentPosition = EndPosition;
+
+	FLiveBPBinaryCodec::FWirePreviewPacket Packet;
+	const FIntPoint Offset = Quantized - KeyframeEnd;
+	if (LiveBPWirePreviewStream::FitsInt16(Offset))
+	{
+		Packet.Event = FLiveBPBinaryCodec::EWirePreviewEvent::Delta;
+		Packet.KeyframeId = KeyframeId;
+		Packet.EndPosition = Offset;
+		FLiveBPBinaryCodec::EncodeWirePreviewPacket(Packet, Writer);
+		return EUpdateResult::Delta;
+	}
+
+	// Out of int16 range, re-anchor
+	KeyframeId = (KeyframeId + 1) & FLiveBPBinaryCodec::WirePreviewKeyframeIdMask;
+	KeyframeEnd = Quantized;
+
+	Packet.Event = FLiveBPBinaryCodec::EWirePreviewEvent::Keyframe;
+	Packet.KeyframeId = KeyframeId;
+	Packet.EndPosition = Quantized;
+	FLiveBPBinaryCodec::EncodeWirePreviewPacket(Packet, Writer);
+	return EUpdateResult::Keyframe;
+}
+
+void FLiveBPWirePreviewEncoder::End(FLiveBPBinaryWriter& Writer)
+{
+	FLiveBPBinaryCodec::FWirePreviewPacket Packet;
+	Packet.Event = FLiveBPBinaryCodec::EWirePreviewEvent::End;
+	Packet.KeyframeId = KeyframeId;
+	FLiveBPBinaryCodec::EncodeWirePreviewPacket(Packet, Writer);
+
+	bActive = false;
+}
+
+// FLiveBPWirePreviewDecoder implementation
+FLiveBPWirePreviewDecoder::FLiveBPWirePreviewDecoder()
+	: bActive(false)
+	, KeyframeId(0)
+	, KeyframeEnd(FIntPoint::ZeroValue)
+{
+}
+
+FLiveBPWirePreviewDecoder::EApplyResult FLiveBPWirePreviewDecoder::Apply(TArrayView<const uint8> Payload, const FLiveBPNameTable* Names)
+{
+	FLiveBPBinaryReader Reader(Payload);
+	Reader.SetNameTable(Names);
+
+	FLiveBPBinaryCodec::FWirePreviewPacket Packet;
+	if (!FLiveBPBinaryCodec::DecodeWirePreviewPacket(Reader, Packet))
+	{
+		return EApplyResult::Invalid;
+	}
+
+	switch (Packet.Event)
+	{
+	case FLiveBPBinaryCodec::EWirePreviewEvent::Begin:
+		bActive = true;
+		KeyframeId = Packet.KeyframeId;
+		KeyframeEnd = Packet.EndPosition;
+		Current.NodeId = Packet.NodeId;
+		Current.PinName = MoveTemp(Packet.PinName);
+		Current.StartPosition = FVector2D(Packet.StartPosition);
+		Current.EndPosition = FVector2D(Packet.EndPosition);
+		break;
+
+	case FLiveBPBinaryCodec::EWirePreviewEvent::Keyframe:
+		if (!bActive)
+		{
+			return EApplyResult::Stale;
+		}
+		KeyframeId = Packet.KeyframeId;
+		KeyframeEnd = Packet.EndPosition;
+		Current.EndPosition = FVector2D(Packet.EndPosition);
+		break;
+
+	case FLiveBPBinaryCodec::EWirePreviewEvent::Delta:
+		if (!bActive || Packet.KeyframeId != KeyframeId)
+		{
+			return EApplyResult::Stale;
+		}
+		Current.EndPosition = FVector2D(KeyframeEnd + Packet.EndPosition);
+		break;
+
+	case FLiveBPBinaryCodec::EWirePreviewEvent::End:
+		if (!bActive)
+		{
+			return EApplyResult::Stale;
+		}
+		bActive = false;
+		Current.Timestamp = FPlatformTime::Seconds();
+		return EApplyResult::Ended;
+	}
+
+	Current.Timestamp = FPlatformTime::Seconds();
+	return EApplyResult::Updated;
+}
+
+void FLiveBPWirePreviewDecoder::Reset()
+{
+	bActive = false;
+	Current.NodeId.Invalidate();
+	Current.PinName.Reset();
+	Current.StartPosition = FVector2D::ZeroVector;
+	Current.EndPosition = FVector2D::ZeroVector;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LiveBPInboundPipeline.h"
+#include "Containers/RingBuffer.h"
+
+/**
+ * Apply priority classes for remote node operations, highest first
+ */
+enum class ELiveBPApplyPriority : uint8
+{
+	Structure, // Nodes added or deleted
+	Links,     // Pins connected or disconnected
+	Layout,    // Moves and property changes
+
+	Count
+};
+
+/**
+ * Applies received node operations on the game thread within a per-frame time budget.
+ *
+ * A burst (a peer pasting hundreds of nodes) is spread over as many frames as it takes instead of
+ * stalling one. Each Apply call hands out every Structure operation before any Links one, and
+ * every Links operation before any Layout one; within a class operations keep their arrival
+ * order. A class never creates what a higher one refers to, so running it early only means a
+ * connection or move for a node deleted later in the backlog finds nothing to act on, which is
+ * where in-order application would have ended up too.
+ * Not thread-safe; it belongs to the game thread.
+ */
+class LIVEBPCORE_API FLiveBPApplyScheduler
+{
+public:
+	FLiveBPApplyScheduler();
+
+	static ELiveBPApplyPriority GetPriority(ELiveBPNodeOperation Operation);
+
+	/** Queues a prepared node operation, group of node moves or node transaction (see FLiveBPInboundPipeline) */
+	void Enqueue(FLiveBPInboundMessage&& Message);
+
+	/**
+	 * Hands queued operations to ApplyOperation in priority order until BudgetSeconds have passed.
+	 * At least one operation is applied per call, so a backlog always makes progress.
+	 * @return Number of operations applied
+	 */
+	int32 Apply(double BudgetSeconds, TFunctionRef<void(FLiveBPInboundMessage& Message)> ApplyOperation);
+
+	int32 Num() const;
+	int32 Num(ELiveBPApplyPriority Priority) const { return Queues[static_cast<int32>(Priority)].Num(); }
+
+	/** Operations queued since the queue was last empty, for showing progress through a backlog */
+	int32 GetBacklogTotal() const { return BacklogTotal; }
+
+	void Reset();
+
+private:
+	TRingBuffer<FLiveBPInboundMessage> Queues[static_cast<int32>(ELiveBPApplyPriority::Count)];
+	int32 BacklogTotal;
+};
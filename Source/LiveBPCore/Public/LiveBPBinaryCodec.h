@@ -0,0 +1,335 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LiveBPDataTypes.h"
+#include "LiveBPSessionDictionary.h"
+#include "LiveBPMessageBuffers.h"
+#include "LiveBPCongestionControl.h"
+#include "LiveBPPresence.h"
+#include "LiveBPNodeMoves.h"
+
+/**
+ * Payload encodings understood by the LiveBP transport
+ */
+enum class ELiveBPPayloadEncoding : uint8
+{
+	Binary,
+	Json // Debug only, human readable
+};
+
+/**
+ * When and how frame payloads are compressed
+ */
+struct FLiveBPCompressionPolicy
+{
+	/** Payloads smaller than this are sent uncompressed. Zero disables compression. */
+	int32 MinPayloadBytes = 1024;
+
+	ELiveBPCompressionFormat Format = ELiveBPCompressionFormat::Oodle;
+};
+
+/**
+ * Non-owning view of a received message, handed to handlers without copying anything.
+ * The payload points into the received frame (or the receiver's decode arena when it was
+ * compressed) and the user id into the sender's name table, so a view is only valid while the
+ * handler it was passed to runs. Use ToMessage() to keep it.
+ */
+struct LIVEBPCORE_API FLiveBPMessageView
+{
+	ELiveBPMessageType MessageType = ELiveBPMessageType::Heartbeat;
+	const FString* UserId = nullptr;
+	FGuid BlueprintId;
+	FGuid GraphId;
+	float Timestamp = 0.0f;
+	TArrayView<const uint8> Payload;
+
+	// Unreliable lane sequence number (see FLiveBPSequenceTracker) for previews and presence, operation log
+	// number (see FLiveBPOperationLog) for edits; zero for anything else
+	uint32 Sequence = 0;
+
+	// Sender's session dictionary, needed to resolve interned names in the payload
+	TSharedPtr<const FLiveBPNameTable, ESPMode::ThreadSafe> NameTable;
+
+	const FString& GetUserId() const { check(UserId); return *UserId; }
+
+	/** Owning copy of the message */
+	FLiveBPMessage ToMessage() const;
+};
+
+/**
+ * Append-only writer for the compact LiveBP binary format.
+ * Integers are LEB128 varints (signed values are zigzag encoded), GUIDs are 16 raw bytes
+ * and strings are a varint byte length followed by UTF-8 data.
+ * Names (users, pins, classes, ...) are a tagged varint: (Handle << 1) | 1 when an interner is
+ * attached, otherwise (Length << 1) followed by the inline value.
+ */
+class LIVEBPCORE_API FLiveBPBinaryWriter
+{
+public:
+	explicit FLiveBPBinaryWriter(TArray<uint8>& InBuffer);
+
+	void WriteByte(uint8 Value);
+	void WriteVarUInt(uint64 Value);
+	void WriteVarInt(int64 Value);
+	void WriteFloat(float Value);
+	void WriteInt16(int16 Value);
+	void WriteGuid(const FGuid& Value);
+	void WriteString(const FString& Value);
+	void WriteBytes(const void* Data, int32 Num);
+
+	void WriteName(ELiveBPNameKind Kind, const FString& Value);
+	void WriteName(ELiveBPNameKind Kind, const FGuid& Value);
+
+	/** Interns names into the session dictionary instead of writing them inline */
+	void SetNameInterner(FLiveBPNameInterner* InInterner) { Interner = InInterner; }
+
+	/** Number of bytes in the underlying buffer */
+	int32 Num() const { return Buffer.Num(); }
+
+private:
+	TArray<uint8>& Buffer;
+	FLiveBPNameInterner* Interner;
+};
+
+/**
+ * Bounds-checked reader for the compact LiveBP binary format.
+ * Any read past the end of the data flags the reader as errored and returns default values.
+ */
+class LIVEBPCORE_API FLiveBPBinaryReader
+{
+public:
+	FLiveBPBinaryReader(const uint8* InData, int32 InNum);
+	explicit FLiveBPBinaryReader(TArrayView<const uint8> InData);
+
+	uint8 ReadByte();
+	uint64 ReadVarUInt();
+	int64 ReadVarInt();
+	float ReadFloat();
+	int16 ReadInt16();
+	FGuid ReadGuid();
+	FString ReadString();
+	bool ReadBytes(void* OutData, int32 InNum);
+	bool Skip(int32 InNum);
+
+	FString ReadName(ELiveBPNameKind Kind);
+	FGuid ReadGuidName(ELiveBPNameKind Kind);
+
+	/** Table used to resolve interned names; without one only inline names can be read */
+	void SetNameTable(const FLiveBPNameTable* InNames) { Names = InNames; }
+
+	/** Bytes not consumed yet */
+	TArrayView<const uint8> GetRemaining() const { return TArrayView<const uint8>(Data + Offset, Num - Offset); }
+
+	bool IsError() const { return bError; }
+	bool IsAtEnd() const { return Offset >= Num; }
+	int32 Tell() const { return Offset; }
+
+private:
+	bool CanRead(int32 Bytes);
+
+	const uint8* Data;
+	int32 Num;
+	int32 Offset;
+	bool bError;
+	const FLiveBPNameTable* Names;
+};
+
+/**
+ * Versioned, tagged binary codec for node operations and lock messages.
+ *
+ * Every payload starts with [Magic][Version][Kind] followed by a varint field mask. Each
+ * operation has its own field layout so e.g. a Move only carries the node id and position.
+ * Decoders accept any subset of the layout, so senders leave out empty optional fields.
+ * UserId and Timestamp are not written for node operations; the message envelope carries them.
+ * Pin names, node classes and user ids are written as names, so they shrink to a handle when
+ * the writer has a session dictionary attached.
+ * The magic byte can never start a JSON document, so binary and debug JSON payloads can be
+ * told apart on receive.
+ */
+class LIVEBPCORE_API FLiveBPBinaryCodec
+{
+public:
+	static constexpr uint8 FormatMagic = 0xB7;
+	static constexpr uint8 FormatVersion = 1;
+
+	enum class EPayloadKind : uint8
+	{
+		NodeOperation = 1,
+		NodeLock = 2,
+		WirePreview = 3,
+		WirePreviewStream = 4,
+		Interest = 5,
+		Heartbeat = 6,
+		Presence = 7,
+		NodeMoves = 8,
+		NodeTransaction = 9,
+		NodeLockSet = 10
+	};
+
+	// Wire preview stream events; packed together with a 6 bit keyframe id into a single byte
+	enum class EWirePreviewEvent : uint8
+	{
+		Begin = 0,    // Anchor node/pin, start and end position
+		Keyframe = 1, // New absolute end position that later deltas are relative to
+		Delta = 2,    // int16 offset of the end position from the current keyframe
+		End = 3
+	};
+
+	static constexpr uint8 WirePreviewKeyframeIdMask = 0x3F;
+
+	struct FWirePreviewPacket
+	{
+		EWirePreviewEvent Event = EWirePreviewEvent::End;
+		uint8 KeyframeId = 0;
+		FGuid NodeId;                                   // Begin only
+		FString PinName;                                // Begin only
+		FIntPoint StartPosition = FIntPoint::ZeroValue; // Begin only
+		FIntPoint EndPosition = FIntPoint::ZeroValue;   // Absolute for Begin/Keyframe, offset from the keyframe for Delta
+	};
+
+	// Frame header: high nibble is the frame version, low nibble the flags
+	static constexpr uint8 FrameVersion = 1;
+
+	enum EFrameFlags : uint8
+	{
+		FrameFlag_Definitions = 1 << 0, // Session dictionary definitions follow the header
+		FrameFlag_Message     = 1 << 1, // A message envelope and payload follow
+		FrameFlag_Compressed  = 1 << 2, // [Format][varint raw size] precede a compressed payload
+		FrameFlag_Sequenced   = 1 << 3  // A varint sequence number follows the envelope; the message type says which sequence
+	};
+
+	// Why a frame was rejected
+	enum class EFrameError : uint8
+	{
+		None,
+		Malformed,
+		UndefinedHandle // Well formed, but names a handle defined in a frame that hasn't arrived yet
+	};
+
+	// Largest payload a compressed frame may inflate to
+	static constexpr int32 MaxUncompressedPayloadBytes = 16 * 1024 * 1024;
+
+	// Node operation fields, in wire order
+	enum ENodeOperationField : uint32
+	{
+		NodeField_NodeId        = 1 << 0,
+		NodeField_TargetNodeId  = 1 << 1,
+		NodeField_PinName       = 1 << 2,
+		NodeField_TargetPinName = 1 << 3,
+		NodeField_Position      = 1 << 4,
+		NodeField_NodeClass     = 1 << 5,
+		NodeField_PropertyData  = 1 << 6
+	};
+
+	// Lock fields, in wire order
+	enum ENodeLockField : uint32
+	{
+		LockField_NodeId   = 1 << 0,
+		LockField_UserId   = 1 << 1,
+		LockField_LockTime = 1 << 2,
+		LockField_Duration = 1 << 3
+	};
+
+	/** Fields that may be written for the given operation */
+	static uint32 GetNodeOperationLayout(ELiveBPNodeOperation Operation);
+
+	static void EncodeNodeOperation(const FLiveBPNodeOperationData& NodeOperation, TArray<uint8>& OutData);
+	static void EncodeNodeOperation(const FLiveBPNodeOperationData& NodeOperation, FLiveBPBinaryWriter& Writer);
+	static bool DecodeNodeOperation(TArrayView<const uint8> Data, FLiveBPNodeOperationData& OutNodeOperation, const FLiveBPNameTable* Names = nullptr);
+	static bool DecodeNodeOperation(FLiveBPBinaryReader& Reader, FLiveBPNodeOperationData& OutNodeOperation);
+
+	// Node transaction: varint count, then that many node operations without their payload headers
+	static void EncodeNodeTransaction(TArrayView<const FLiveBPNodeOperationData> NodeOperations, FLiveBPBinaryWriter& Writer);
+	static bool DecodeNodeTransaction(TArrayView<const uint8> Data, TArray<FLiveBPNodeOperationData>& OutNodeOperations,
+		const FLiveBPNameTable* Names = nullptr);
+
+	static void EncodeNodeLock(const FLiveBPNodeLock& NodeLock, TArray<uint8>& OutData);
+	static void EncodeNodeLock(const FLiveBPNodeLock& NodeLock, FLiveBPBinaryWriter& Writer);
+	static bool DecodeNodeLock(TArrayView<const uint8> Data, FLiveBPNodeLock& OutNodeLock, const FLiveBPNameTable* Names = nullptr);
+	static bool DecodeNodeLock(FLiveBPBinaryReader& Reader, FLiveBPNodeLock& OutNodeLock);
+
+	// Node lock set: the lock state, the duration as a float, a varint count, then the node ids as names.
+	// The holder is the sender of the frame.
+	static void EncodeNodeLockSet(const FLiveBPNodeLockSet& LockSet, FLiveBPBinaryWriter& Writer);
+	static bool DecodeNodeLockSet(TArrayView<const uint8> Data, FLiveBPNodeLockSet& OutLockSet, const FLiveBPNameTable* Names = nullptr);
+
+	static void EncodeWirePreview(const FLiveBPWirePreview& WirePreview, TArray<uint8>& OutData);
+	static void EncodeWirePreview(const FLiveBPWirePreview& WirePreview, FLiveBPBinaryWriter& Writer);
+	static bool DecodeWirePreview(TArrayView<const uint8> Data, FLiveBPWirePreview& OutWirePreview, const FLiveBPNameTable* Names = nullptr);
+	static bool DecodeWirePreview(FLiveBPBinaryReader& Reader, FLiveBPWirePreview& OutWirePreview);
+
+	static void EncodeWirePreviewPacket(const FWirePreviewPacket& Packet, FLiveBPBinaryWriter& Writer);
+	static bool DecodeWirePreviewPacket(FLiveBPBinaryReader& Reader, FWirePreviewPacket& OutPacket);
+
+	// Interest set: varint count followed by that many Blueprint GUIDs
+	static void EncodeInterest(TArrayView<const FGuid> BlueprintIds, FLiveBPBinaryWriter& Writer);
+	static bool DecodeInterest(TArrayView<const uint8> Data, TArray<FGuid>& OutBlueprintIds);
+
+	// Heartbeat: send time, echoed time, echo delay and received count as varints
+	static void EncodeHeartbeat(const FLiveBPHeartbeat& Heartbeat, FLiveBPBinaryWriter& Writer);
+	static bool DecodeHeartbeat(TArrayView<const uint8> Data, FLiveBPHeartbeat& OutHeartbeat);
+
+	// Presence: a flags byte, the cursor (if any) and the view's min corner as signed varints, then its size as varints
+	static void EncodePresence(const FLiveBPPresence& Presence, FLiveBPBinaryWriter& Writer);
+	static bool DecodePresence(TArrayView<const uint8> Data, FLiveBPPresence& OutPresence);
+
+	// Node moves: varint count, then per node its id as a name and the position as signed varints
+	static void EncodeNodeMoves(TArrayView<const FLiveBPNodeMove> Moves, FLiveBPBinaryWriter& Writer);
+	static bool DecodeNodeMoves(TArrayView<const uint8> Data, TArray<FLiveBPNodeMove>& OutMoves, const FLiveBPNameTable* Names = nullptr);
+
+	/** True if the data is a wire preview stream packet rather than a full wire preview */
+	static bool IsWirePreviewStreamPayload(TArrayView<const uint8> Data);
+
+	/** True if the data starts with a binary codec header */
+	static bool IsBinaryPayload(TArrayView<const uint8> Data);
+
+	/**
+	 * Builds a transport frame: [Version|Flags][MessageType][Definitions][User][Blueprint][Graph][Payload].
+	 * The envelope ids are interned, and any definitions queued while encoding the payload travel in the same frame.
+	 * The sender's timestamp is not sent; receivers stamp messages on arrival.
+	 * With a compression policy, payloads at or above its threshold are compressed when that makes the frame smaller.
+	 * A non-zero sequence number is the unreliable lane's or the operation log's, depending on the message type.
+	 */
+	static void EncodeFrame(const FLiveBPMessage& Message, FLiveBPNameInterner& Interner, TArray<uint8>& OutFrame, const FLiveBPCompressionPolicy* Compression = nullptr);
+	static void EncodeFrame(ELiveBPMessageType MessageType, const FString& UserId, const FGuid& BlueprintId, const FGuid& GraphId,
+		TArrayView<const uint8> Payload, FLiveBPNameInterner& Interner, TArray<uint8>& OutFrame, const FLiveBPCompressionPolicy* Compression = nullptr,
+		uint32 Sequence = 0);
+
+	/** Builds a definitions-only frame holding the whole dictionary, for late joiners */
+	static void EncodeSnapshotFrame(const FLiveBPNameInterner& Interner, TArray<uint8>& OutFrame);
+
+	/**
+	 * Builds a definitions-only frame from the interner's pending definitions, so they can go to
+	 * every peer ahead of a message that is only sent to some of them
+	 * @return false (and leaves OutFrame untouched) if nothing is pending
+	 */
+	static bool EncodePendingDefinitionsFrame(FLiveBPNameInterner& Interner, TArray<uint8>& OutFrame);
+
+	/**
+	 * Applies the frame's definitions to the sender's table and decodes its envelope.
+	 * @param bOutHasMessage false for definitions-only frames
+	 */
+	static bool DecodeFrame(TArrayView<const uint8> Frame, FLiveBPNameTable& Names, FLiveBPMessage& OutMessage, bool& bOutHasMessage);
+
+	/**
+	 * Zero-copy variant: the view points into Frame, Names and, for compressed payloads, Arena.
+	 * It stays valid until the next frame is decoded with the same table or the arena is reset.
+	 * @param OutError if given, why the frame was rejected
+	 */
+	static bool DecodeFrame(TArrayView<const uint8> Frame, FLiveBPNameTable& Names, FLiveBPDecodeArena& Arena, FLiveBPMessageView& OutView, bool& bOutHasMessage,
+		EFrameError* OutError = nullptr);
+
+	/** Whether the frame's header says session dictionary definitions follow it */
+	static bool HasFrameDefinitions(TArrayView<const uint8> Frame);
+
+	/** FCompression format name for a LiveBP compression format */
+	static FName GetCompressionFormatName(ELiveBPCompressionFormat Format);
+
+private:
+	static void WriteHeader(FLiveBPBinaryWriter& Writer, EPayloadKind Kind);
+	static bool ReadHeader(FLiveBPBinaryReader& Reader, EPayloadKind ExpectedKind);
+
+	// Operation kind, field mask and fields; shared by single operations and transactions
+	static void WriteNodeOperationBody(const FLiveBPNodeOperationData& NodeOperation, FLiveBPBinaryWriter& Writer);
+	static bool ReadNodeOperationBody(FLiveBPBinaryReader& Reader, FLiveBPNodeOperationData& OutNodeOperation);
+};
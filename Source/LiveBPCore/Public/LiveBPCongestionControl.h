@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bounds for the per-peer send rate of ephemeral streams (wire previews, cursors)
+ */
+struct FLiveBPRateBounds
+{
+	bool bAdaptive = true;       // Otherwise every peer stays at InitialRateHz
+	float MinRateHz = 2.0f;
+	float MaxRateHz = 60.0f;
+	float InitialRateHz = 10.0f;
+};
+
+/**
+ * Heartbeat payload. Each peer probes every other one about once a second: it stamps its own
+ * send time and echoes the newest probe it got from the recipient, together with how long it held
+ * that probe and how many unreliable frames it has received from the recipient so far. The
+ * recipient gets a round-trip time and a loss count for its own traffic out of it.
+ * Times are in microseconds of the stamping peer's FPlatformTime clock.
+ */
+struct FLiveBPHeartbeat
+{
+	uint64 SendTimeUs = 0;
+	uint64 EchoTimeUs = 0;  // 0 until we have heard from the recipient
+	uint64 EchoDelayUs = 0;
+	uint64 UnreliableReceived = 0;
+};
+
+/**
+ * A heartbeat as it arrived, with what the receiver knew about the sender at that moment
+ */
+struct FLiveBPHeartbeatReceipt
+{
+	FLiveBPHeartbeat Heartbeat;
+	double ReceivedTime = 0.0;       // FPlatformTime::Seconds() when the frame was decoded
+	uint64 UnreliableReceived = 0;   // Unreliable frames received from the sender so far
+};
+
+/**
+ * Current send rate to one peer, and what it was derived from
+ */
+struct FLiveBPPeerSendRate
+{
+	float RateHz = 0.0f;
+	float SmoothedRttMs = 0.0f; // 0 until the first round trip
+	float LossRate = 0.0f;
+};
+
+/**
+ * AIMD rate control for ephemeral streams, one rate per peer.
+ *
+ * Each tick a peer's rate grows additively unless it shows congestion, in which case it is halved
+ * (at most once per round trip). Congestion is any of: loss of unreliable frames to that peer,
+ * a smoothed RTT well above the lowest one seen, or our shared send queue filling up. Rates stay
+ * within FLiveBPRateBounds.
+ * Reliable traffic is never paced; only frames that can be dropped without harm go through
+ * ShouldSend.
+ * Not thread-safe; it belongs to the outbound pipeline.
+ */
+class LIVEBPCORE_API FLiveBPCongestionController
+{
+public:
+	FLiveBPCongestionController();
+
+	void SetBounds(const FLiveBPRateBounds& InBounds);
+	const FLiveBPRateBounds& GetBounds() const { return Bounds; }
+
+	void AddPeer(const FGuid& PeerId);
+	void RemovePeer(const FGuid& PeerId);
+	void Reset();
+
+	/**
+	 * Adjusts every peer's rate once per tick
+	 * @param QueueFill How full the send queue got this tick, 0 to 1
+	 */
+	void Update(double CurrentTime, float QueueFill);
+
+	/** Whether an ephemeral frame may go to the peer now; counts it as sent if so */
+	bool ShouldSend(const FGuid& PeerId, double CurrentTime);
+
+	/** Fills in the next probe for the peer if one is due */
+	bool MakeHeartbeat(const FGuid& PeerId, double CurrentTime, FLiveBPHeartbeat& OutHeartbeat);
+
+	/** Takes the round trip and loss report out of a probe the peer sent us */
+	void OnHeartbeat(const FGuid& PeerId, const FLiveBPHeartbeatReceipt& Receipt);
+
+	FLiveBPPeerSendRate GetSendRate(const FGuid& PeerId) const;
+	void GetSendRates(TMap<FGuid, FLiveBPPeerSendRate>& OutRates) const;
+
+	/** Rate of the fastest peer, which is how often it is worth sampling an ephemeral stream */
+	float GetMaxRate() const;
+
+	static uint64 ToMicroseconds(double Seconds) { return static_cast<uint64>(FMath::Max(Seconds, 0.0) * 1000000.0); }
+	static double ToSeconds(uint64 Microseconds) { return static_cast<double>(Microseconds) / 1000000.0; }
+
+private:
+	struct FProbe
+	{
+		uint64 SendTimeUs = 0;
+		uint64 UnreliableSent = 0;
+	};
+
+	struct FPeerState
+	{
+		float RateHz = 0.0f;
+		double NextSendTime = 0.0;
+		double LastUpdateTime = 0.0;
+		double LastDecreaseTime = 0.0;
+		double NextHeartbeatTime = 0.0;
+
+		// Round trip and loss, as measured from the peer's echoes
+		double SmoothedRtt = 0.0;
+		double MinRtt = 0.0;
+		float LossRate = 0.0f;
+		bool bCongestionReported = false; // Set by a probe, cleared by the decrease it causes
+		uint64 UnreliableSent = 0;
+		TArray<FProbe, TInlineAllocator<4>> Probes;
+		FProbe LastAcknowledged;
+		uint64 LastReportedReceived = 0;
+		uint64 Outstanding = 0;     // Sent by the last acknowledged probe but not yet reported received
+		uint64 OutstandingSent = 0; // Sent in the window those belong to
+
+		// The peer's newest probe, echoed in our next one
+		uint64 PeerSendTimeUs = 0;
+		double PeerProbeReceivedTime = 0.0;
+		uint64 UnreliableReceived = 0;
+	};
+
+	bool IsCongested(const FPeerState& Peer, float QueueFill) const;
+	float ClampRate(float RateHz) const;
+
+	FLiveBPRateBounds Bounds;
+	TMap<FGuid, FPeerState> Peers;
+};
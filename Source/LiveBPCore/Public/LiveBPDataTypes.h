@@ -7,6 +7,8 @@
 #include "EdGraph/EdGraphNode.h"
 #include "LiveBPDataTypes.generated.h"
 
+class FLiveBPNameTable;
+
 UENUM(BlueprintType)
 enum class ELiveBPMessageType : uint8
 {
@@ -14,7 +16,12 @@ enum class ELiveBPMessageType : uint8
 	NodeOperation,
 	LockRequest,
 	LockRelease,
-	Heartbeat
+	Heartbeat,
+	Interest, // Blueprints the sender has open; consumed by the transport for routing
+	Presence, // Cursor and view of the sender in a graph
+	NodeMoves, // Positions of every node the sender moved in one tick, applied as one transaction
+	NodeTransaction, // Node operations from one editor action (paste, duplicate, delete), applied atomically
+	LockSet // Locks on a selection of nodes in one graph, taken or released all at once
 };
 
 UENUM(BlueprintType)
@@ -28,6 +35,16 @@ enum class ELiveBPNodeOperation : uint8
 	PropertyChange
 };
 
+// Engine compression formats usable for large payloads; the value is sent on the wire
+UENUM(BlueprintType)
+enum class ELiveBPCompressionFormat : uint8
+{
+	Oodle,
+	Zlib,
+	Gzip,
+	LZ4
+};
+
 UENUM(BlueprintType)
 enum class ELiveBPLockState : uint8
 {
@@ -124,16 +141,45 @@ struct LIVEBPCORE_API FLiveBPNodeLock
 	UPROPERTY(BlueprintReadWrite, Category = "LiveBP")
 	FString UserId;
 
+	// Seconds on the holder's platform clock, which runs for days; a float would lose milliseconds
 	UPROPERTY(BlueprintReadWrite, Category = "LiveBP")
-	float LockTime;
+	double LockTime;
 
 	UPROPERTY(BlueprintReadWrite, Category = "LiveBP")
-	float ExpiryTime;
+	double ExpiryTime;
 
 	FLiveBPNodeLock()
 		: LockState(ELiveBPLockState::Unlocked)
-		, LockTime(0.0f)
-		, ExpiryTime(0.0f)
+		, LockTime(0.0)
+		, ExpiryTime(0.0)
+	{
+	}
+};
+
+/**
+ * Locks on several nodes of one graph, taken or released together. Node ids are kept in ascending
+ * order, the order every client acquires them in.
+ */
+USTRUCT(BlueprintType)
+struct LIVEBPCORE_API FLiveBPNodeLockSet
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "LiveBP")
+	TArray<FGuid> NodeIds;
+
+	UPROPERTY(BlueprintReadWrite, Category = "LiveBP")
+	ELiveBPLockState LockState;
+
+	UPROPERTY(BlueprintReadWrite, Category = "LiveBP")
+	FString UserId;
+
+	UPROPERTY(BlueprintReadWrite, Category = "LiveBP")
+	float Duration;
+
+	FLiveBPNodeLockSet()
+		: LockState(ELiveBPLockState::Unlocked)
+		, Duration(0.0f)
 	{
 	}
 };
@@ -162,6 +208,9 @@ struct LIVEBPCORE_API FLiveBPMessage
 	UPROPERTY(BlueprintReadWrite, Category = "LiveBP")
 	TArray<uint8> PayloadData;
 
+	// Sender's session dictionary, needed to resolve interned names in received payloads
+	TSharedPtr<const FLiveBPNameTable, ESPMode::ThreadSafe> NameTable;
+
 	FLiveBPMessage()
 		: MessageType(ELiveBPMessageType::Heartbeat)
 		, Timestamp(0.0f)
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LiveBPDataTypes.h"
+#include "LiveBPBinaryCodec.h"
+#include "LiveBPMessageBuffers.h"
+#include "LiveBPSessionDictionary.h"
+#include "LiveBPSequenceTracker.h"
+#include "LiveBPOperationLog.h"
+#include "LiveBPWirePreviewStream.h"
+#include "LiveBPCongestionControl.h"
+#include "Misc/TVariant.h"
+#include "Tasks/Pipe.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * A received message, validated, decoded and resolved off the game thread. Applying it is all
+ * that is left to do.
+ */
+struct FLiveBPInboundMessage
+{
+	using FData = TVariant<FEmptyVariantState, FLiveBPWirePreview, FLiveBPNodeOperationData, FLiveBPNodeLock, TArray<FGuid>,
+		FLiveBPHeartbeatReceipt, FLiveBPPresence, TArray<FLiveBPNodeMove>, TArray<FLiveBPNodeOperationData>, FLiveBPNodeLockSet>;
+
+	ELiveBPMessageType MessageType = ELiveBPMessageType::Heartbeat;
+	FGuid SourceEndpointId;
+	FGuid BlueprintId;
+	FGuid GraphId;
+	FString UserId;
+	float Timestamp = 0.0f;
+
+	// The object registered for BlueprintId (see FLiveBPInboundPipeline::SetResolvableObjects).
+	// Only dereference it on the game thread.
+	TWeakObjectPtr<UObject> Blueprint;
+
+	// Wire preview, node operation, lock, the Blueprint ids of an interest set, a heartbeat, a presence update,
+	// a group of node moves, the node operations of a transaction or a lock set
+	FData Data;
+
+	// Set for the packet that ends a streamed wire preview; Data then holds its last state
+	bool bWirePreviewEnded = false;
+};
+
+/**
+ * Turns received Concert batches into apply-ready messages on worker threads.
+ *
+ * Received batches are copied into recycled slots and decoded by a task on a UE::Tasks pipe,
+ * which splits each into frames and runs every frame through the stages in turn: decode the
+ * envelope against the sender's session dictionary, drop stale unreliable updates, validate,
+ * decode the payload, and resolve the Blueprint. The pipe keeps batches in arrival order, which
+ * the dictionary and wire preview streams depend on, while still running alongside the game
+ * thread. Prepared messages wait in recycled slots too until the game thread drains them, so a
+ * warm pipeline does not allocate per batch or per message.
+ */
+class LIVEBPCORE_API FLiveBPInboundPipeline
+{
+public:
+	FLiveBPInboundPipeline();
+	~FLiveBPInboundPipeline();
+
+	/** Queues a received batch (see FLiveBPOutboundBatcher) for decoding. Game thread. */
+	void Enqueue(const FGuid& SourceEndpointId, const TArray<uint8>& Batch);
+
+	/** Drops what we know about an endpoint once its queued batches are decoded */
+	void RemoveEndpoint(const FGuid& EndpointId);
+
+	/** Waits for queued batches, then forgets every endpoint and discards undrained messages. Game thread. */
+	void Reset();
+
+	/**
+	 * Objects that Blueprint ids resolve to. Previews and node operations for any other id are
+	 * dropped on the worker, since there is nothing to apply them to.
+	 */
+	void SetResolvableObjects(TMap<FGuid, TWeakObjectPtr<UObject>>&& Objects);
+
+	/** Hands every prepared message to Apply in arrival order. Game thread. */
+	void Drain(TFunctionRef<void(FLiveBPInboundMessage& Message)> Apply);
+
+	/** Blocks until every queued batch has been decoded */
+	void WaitUntilIdle();
+
+	/** True on the thread running one of this pipeline's decode tasks */
+	bool IsInPipe() const { return Pipe.IsInContext(); }
+
+private:
+	using FResolvableObjects = TMap<FGuid, TWeakObjectPtr<UObject>>;
+
+	struct FPendingBatch
+	{
+		FGuid SourceEndpointId;
+		TArray<uint8> Data;
+	};
+
+	// Pipe tasks; only one runs at a time
+	void DecodePendingBatches();
+	void DecodeBatch(const FGuid& SourceEndpointId, TArrayView<const uint8> Batch);
+	bool Prepare(const FGuid& SourceEndpointId, const FLiveBPMessageView& View, const FResolvableObjects& Objects, FLiveBPInboundMessage& OutMessage);
+	bool DecodeWirePreview(const FLiveBPMessageView& View, FLiveBPInboundMessage& OutMessage);
+
+	UE::Tasks::FPipe Pipe;
+	TLiveBPSwapQueue<FPendingBatch> PendingBatches;
+	TLiveBPSwapQueue<FLiveBPInboundMessage> Prepared;
+
+	// Published by the game thread, read by pipe tasks
+	FCriticalSection ResolvableLock;
+	TSharedRef<const FResolvableObjects, ESPMode::ThreadSafe> Resolvable;
+
+	// Per-endpoint decode state, only touched by pipe tasks
+	TMap<FGuid, TSharedRef<FLiveBPNameTable, ESPMode::ThreadSafe>> RemoteNames;
+	TMap<FGuid, FLiveBPSequenceTracker> RemoteSequences;
+	TMap<FGuid, FLiveBPOperationLog> RemoteOperations;
+	TMap<FGuid, uint64> UnreliableReceived; // Reported back to each sender in our heartbeats
+	TMap<FGuid, FLiveBPWirePreviewDecoder> RemoteWirePreviews;
+	TArray<TArrayView<const uint8>> Frames;
+	FLiveBPDecodeArena Arena;
+	FLiveBPInboundMessage PreparedMessage; // Traded for a queue slot, so it picks up that slot's storage
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Routing table for traffic that only matters to peers looking at the same Blueprint (wire
+ * previews, cursors). Peers publish the set of Blueprints they have open; the table keeps a
+ * prebuilt endpoint list per Blueprint so routing a message is a single lookup.
+ *
+ * Peers that have not published an interest set yet are sent everything, so an older client or
+ * one whose interest is still in flight never misses traffic it might need.
+ */
+class LIVEBPCORE_API FLiveBPInterestRoutes
+{
+public:
+	void AddEndpoint(const FGuid& Endpoint);
+
+	/** Removes the endpoint and forgets its interest */
+	void RemoveEndpoint(const FGuid& Endpoint);
+
+	/**
+	 * Records the Blueprints an endpoint has open. Interest may arrive before the endpoint is
+	 * added; it is kept and applied once it is.
+	 */
+	void SetInterest(const FGuid& Endpoint, TArrayView<const FGuid> BlueprintIds);
+
+	/** Endpoints that should receive traffic about the given Blueprint, in endpoint order */
+	const TArray<FGuid>& GetEndpoints(const FGuid& BlueprintId) const;
+
+	/** Every remote endpoint */
+	const TArray<FGuid>& GetAllEndpoints() const { return Endpoints; }
+
+	bool HasInterest(const FGuid& Endpoint) const { return Interests.Contains(Endpoint); }
+
+	void Reset();
+
+private:
+	void Rebuild();
+
+	TArray<FGuid> Endpoints;
+	TMap<FGuid, TArray<FGuid>> Interests;       // Endpoint -> Blueprints it has open
+	TMap<FGuid, TArray<FGuid>> RoutesByBlueprint;
+	TArray<FGuid> UndeclaredEndpoints;          // Endpoints with no published interest
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/RingBuffer.h"
+
+/**
+ * Playout settings for continuous remote streams
+ */
+struct FLiveBPPlayoutSettings
+{
+	double Delay = 0.1;            // How far behind the newest sample a stream is drawn
+	double MaxExtrapolation = 0.1; // How far past the newest sample motion is projected when the next one is late
+};
+
+/**
+ * Jitter buffer for one continuous remote stream (a cursor, the loose end of a wire preview).
+ *
+ * Samples are stamped with the local time they arrived and played back Delay in the past, so a
+ * stream sent at a few Hz is still rendered as smooth motion at display rate: between two samples the
+ * position is interpolated, and once playback catches up with the newest sample (an update is late
+ * or lost) it keeps moving at the last velocity for up to MaxExtrapolation, then holds. A sample that
+ * arrives after that picks up from the drawn position, so late updates never make the stream jump back.
+ * Samples arriving in the same frame collapse into the newest one.
+ * Not thread-safe; it belongs to the widget drawing the stream.
+ */
+class LIVEBPCORE_API FLiveBPInterpolationBuffer
+{
+public:
+	FLiveBPInterpolationBuffer();
+
+	void AddSample(double Time, const FVector2D& Position, const FLiveBPPlayoutSettings& Settings);
+
+	/** Position to draw at CurrentTime; the zero vector if there are no samples */
+	FVector2D Evaluate(double CurrentTime, const FLiveBPPlayoutSettings& Settings) const;
+
+	/** Whether the drawn position can still change without new samples */
+	bool IsMoving(double CurrentTime, const FLiveBPPlayoutSettings& Settings) const;
+
+	bool IsEmpty() const { return Samples.IsEmpty(); }
+	double GetLastSampleTime() const { return Samples.IsEmpty() ? 0.0 : Samples.Last().Time; }
+
+	/** Starts over, e.g. when a new wire drag begins; the first sample is then drawn as is */
+	void Reset();
+
+	/** Enough for the maximum playout delay at the maximum send rate */
+	static constexpr int32 MaxSamples = 32;
+
+private:
+	struct FSample
+	{
+		double Time;
+		FVector2D Position;
+	};
+
+	TRingBuffer<FSample> Samples;
+};
@@ -3,10 +3,31 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "LiveBPDataTypes.h"
+#include "Containers/RingBuffer.h"
 #include "LiveBPLockManager.generated.h"
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnNodeLockStateChanged, const FGuid&, const FLiveBPNodeLock&);
 
+/**
+ * Outcome of locking a set of nodes: either every node was granted, or none was and Conflicts
+ * lists the nodes someone else holds. All are in ascending id order. Settling a conflicting remote
+ * set lists in Preempted the nodes its losers gave up.
+ */
+struct FLiveBPLockSetResult
+{
+	TArray<FGuid> Granted;
+	TArray<FGuid> Conflicts;
+	TArray<FGuid> Preempted;
+
+	bool IsGranted() const { return Conflicts.Num() == 0; }
+};
+
+/**
+ * The lock table for every node in the session, local and remote locks alike.
+ * Locks can be tagged with the Blueprint and graph of their node when they are taken, so
+ * everything held by a user, or in a Blueprint or graph, can be found and released without
+ * scanning the whole table.
+ */
 UCLASS()
 class LIVEBPCORE_API ULiveBPLockManager : public UObject
 {
@@ -16,8 +37,15 @@ public:
 	ULiveBPLockManager();
 
 	// Lock management
-	bool RequestLock(const FGuid& NodeId, const FString& UserId, float LockDuration = 30.0f);
+	bool RequestLock(const FGuid& NodeId, const FString& UserId, float LockDuration = 30.0f,
+		const FGuid& BlueprintId = FGuid(), const FGuid& GraphId = FGuid());
 	bool ReleaseLock(const FGuid& NodeId, const FString& UserId);
+
+	// All or nothing: a set with any node held by someone else is refused without waiting in line, so
+	// nobody holds part of a selection while waiting for the rest. Nodes are taken in ascending id order.
+	FLiveBPLockSetResult RequestLocks(TArrayView<const FGuid> NodeIds, const FString& UserId, float LockDuration = 30.0f,
+		const FGuid& BlueprintId = FGuid(), const FGuid& GraphId = FGuid());
+	void ReleaseLocks(TArrayView<const FGuid> NodeIds, const FString& UserId);
 	bool IsLocked(const FGuid& NodeId) const;
 	bool IsLockedByUser(const FGuid& NodeId, const FString& UserId) const;
 	bool CanUserModify(const FGuid& NodeId, const FString& UserId) const;
@@ -26,15 +54,30 @@ public:
 	ELiveBPLockState GetLockState(const FGuid& NodeId) const;
 	FString GetLockOwner(const FGuid& NodeId) const;
 	float GetLockTimeRemaining(const FGuid& NodeId) const;
+	const FLiveBPNodeLock* FindLock(const FGuid& NodeId) const; // Null if unlocked or expired
+	int32 Num() const { return NodeLocks.Num(); }
+
+	// Locked nodes by holder, Blueprint or graph
+	void GetUserLocks(const FString& UserId, TArray<FGuid>& OutNodeIds) const;
+	void GetBlueprintLocks(const FGuid& BlueprintId, TArray<FGuid>& OutNodeIds) const;
+	void GetGraphLocks(const FGuid& GraphId, TArray<FGuid>& OutNodeIds) const;
 
-	// Remote lock handling
-	void HandleRemoteLockRequest(const FLiveBPNodeLock& LockRequest);
+	// Remote lock handling. Remote times are from the sender's clock, so only the lock's duration is kept.
+	// Single requests wait in line rather than being settled; the editor locks even one node as a set.
+	void HandleRemoteLockRequest(const FLiveBPNodeLock& LockRequest, const FGuid& BlueprintId = FGuid(), const FGuid& GraphId = FGuid());
 	void HandleRemoteLockRelease(const FLiveBPNodeLock& LockRelease);
 
-	// Maintenance
+	// A remote set that conflicts was taken before its sender saw the other locks. Every client settles
+	// that alike: the lowest user id keeps its set, and whoever it beats loses all they hold in the graph.
+	FLiveBPLockSetResult HandleRemoteLockSet(const FLiveBPNodeLockSet& LockSet, const FGuid& BlueprintId = FGuid(), const FGuid& GraphId = FGuid());
+
+	// Maintenance. Expiry is checked against the clock as of the last update or request, so queries
+	// don't each read it; a tick only visits the locks that are due.
 	void UpdateLocks(float DeltaTime);
 	void ClearAllLocks();
-	void ClearUserLocks(const FString& UserId);
+	void ClearUserLocks(const FString& UserId);          // Their locks go to whoever waits next
+	void ClearBlueprintLocks(const FGuid& BlueprintId);  // Locks and waiting requests are dropped
+	void ClearNodeLock(const FGuid& NodeId);             // Likewise, e.g. once the node is deleted
 
 	// Events
 	FOnNodeLockStateChanged OnNodeLockStateChanged;
@@ -44,10 +87,54 @@ private:
 	UPROPERTY()
 	TMap<FGuid, FLiveBPNodeLock> NodeLocks;
 
-	// Pending lock requests (for conflict resolution)
-	TMap<FGuid, TArray<FLiveBPNodeLock>> PendingLockRequests;
+	// Where each locked node lives, when known
+	struct FLockScope
+	{
+		FGuid BlueprintId;
+		FGuid GraphId;
+	};
+	TMap<FGuid, FLockScope> LockScopes;
+
+	// Secondary indices over NodeLocks, and over the wait queues by user
+	TMap<FString, TSet<FGuid>> LocksByUser;
+	TMap<FGuid, TSet<FGuid>> LocksByBlueprint;
+	TMap<FGuid, TSet<FGuid>> LocksByGraph;
+	TMap<FString, TSet<FGuid>> WaitingByUser;
+
+	// Pending lock requests (for conflict resolution), granted in arrival order; a user waits at most once per node
+	struct FWaitQueue
+	{
+		TRingBuffer<FLiveBPNodeLock> Requests;
+		TSet<FString> Users;
+	};
+	TMap<FGuid, FWaitQueue> PendingLockRequests;
+
+	// Min-heap of lock expiry times. Extending or releasing a lock leaves its old entry behind; entries
+	// that no longer match the lock are skipped when they come up.
+	struct FLockExpiry
+	{
+		double ExpiryTime;
+		FGuid NodeId;
+
+		bool operator<(const FLockExpiry& Other) const { return ExpiryTime < Other.ExpiryTime; }
+	};
+	TArray<FLockExpiry> ExpiryHeap;
+
+	// Clock shared by everything done in one update or request
+	double CurrentTime;
 
 	// Helper functions
+	void RefreshClock();
+	void SetScope(const FGuid& NodeId, const FGuid& BlueprintId, const FGuid& GraphId);
+	void ForgetIdleScope(const FGuid& NodeId);
+	void ReleaseGraphLocks(const FString& UserId, const FGuid& GraphId, TArray<FGuid>& OutNodeIds);
+	void AddLock(const FGuid& NodeId, const FLiveBPNodeLock& Lock);
+	bool RemoveLock(const FGuid& NodeId, FLiveBPNodeLock& OutLock);
+	void RemoveWaitQueue(const FGuid& NodeId);
+	static void GetIndexed(const TSet<FGuid>* NodeIds, TArray<FGuid>& OutNodeIds);
+	static TArray<FGuid> GetCanonicalOrder(TArrayView<const FGuid> NodeIds);
+	void AddPendingRequest(const FLiveBPNodeLock& LockRequest);
+	void ScheduleExpiry(const FLiveBPNodeLock& Lock);
 	void ProcessPendingRequests(const FGuid& NodeId);
 	bool IsLockExpired(const FLiveBPNodeLock& Lock) const;
 	void ExpireLock(const FGuid& NodeId);
@@ -3,6 +3,10 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "LiveBPDataTypes.h"
+#include "LiveBPBinaryCodec.h"
+#include "LiveBPSessionDictionary.h"
+#include "LiveBPOutboundWorker.h"
+#include "LiveBPInboundPipeline.h"
 #include "Subsystems/EditorSubsystem.h"
 #include "IConcertSyncClientModule.h"
 #include "IConcertSyncClient.h"
@@ -11,7 +15,21 @@
 #include "LiveBPMUEIntegration.generated.h"
 
 // Concert-based delegate for message receiving
-DECLARE_MULTICAST_DELEGATE_OneParam(FOnLiveBPMessageReceived, const FLiveBPMessage&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLiveBPInboundMessage, const FLiveBPInboundMessage&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLiveBPUserLeft, const FString&);
+
+/**
+ * Concert custom event carrying a batch of LiveBP frames (see FLiveBPBinaryCodec::EncodeFrame),
+ * each prefixed with its varint length (see FLiveBPOutboundBatcher)
+ */
+USTRUCT()
+struct FLiveBPConcertEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<uint8> Frames;
+};
 
 UCLASS()
 class LIVEBPCORE_API ULiveBPMUEIntegration : public UEditorSubsystem
@@ -29,42 +47,121 @@ public:
 	bool InitializeConcertIntegration();
 	void ShutdownConcertIntegration();
 
-	// Message sending via Concert
+	// Message sending via Concert. Sends only describe the message; serialization, framing and
+	// batching happen on the outbound worker, and the batches go out at the end of the frame.
 	bool SendWirePreview(const FLiveBPWirePreview& WirePreview, const FGuid& BlueprintId, const FGuid& GraphId);
 	bool SendNodeOperation(const FLiveBPNodeOperationData& NodeOperation, const FGuid& BlueprintId, const FGuid& GraphId);
 	bool SendLockRequest(const FLiveBPNodeLock& LockRequest, const FGuid& BlueprintId, const FGuid& GraphId);
 
-	// Message receiving delegate
-	FOnLiveBPMessageReceived OnMessageReceived;
+	// Locks taken or released on several nodes of one graph, sent as a single message
+	bool SendLockSet(const FLiveBPNodeLockSet& LockSet, const FGuid& BlueprintId, const FGuid& GraphId);
+
+	// A node's new position. Moves are coalesced per node until the end of the frame and go out as one
+	// message per graph, which receivers apply in a single transaction.
+	bool SendNodeMove(const FGuid& NodeId, const FIntPoint& Position, const FGuid& BlueprintId, const FGuid& GraphId);
+
+	// Wire preview stream: the anchor goes out once, then only quantized end position deltas
+	bool BeginWirePreviewStream(const FLiveBPWirePreview& WirePreview, const FGuid& BlueprintId, const FGuid& GraphId);
+	bool UpdateWirePreviewStream(const FVector2D& EndPosition);
+	bool EndWirePreviewStream();
+	bool IsWirePreviewStreamActive() const { return bWirePreviewStreamActive; }
+
+	// Updates closer than this (in graph units) to the last sent position are suppressed
+	void SetWirePreviewMovementThreshold(float InThreshold);
+
+	// Our cursor and view in a graph, for the peers that have its Blueprint open. Call it as often as
+	// convenient; the worker only sends changes beyond the presence movement threshold (in graph units).
+	bool UpdatePresence(const FLiveBPPresence& Presence, const FGuid& BlueprintId, const FGuid& GraphId);
+	void SetPresenceMovementThreshold(float InThreshold);
+
+	// Outgoing messages are batched per destination and flushed according to this policy
+	void SetBatchPolicy(const FLiveBPBatchPolicy& InPolicy);
+	const FLiveBPBatchPolicy& GetBatchPolicy() const { return OutboundSettings.BatchPolicy; }
+
+	// Sends everything queued so far without waiting for the policy; blocks until the worker has framed it
+	void FlushOutgoingMessages();
+
+	// Messages wait in a strict-priority queue (locks, then structural ops, then previews) until
+	// the end of the tick; this bounds each priority class
+	void SetOutgoingQueueDepth(int32 InMaxDepth);
+	int32 GetOutgoingQueueDepth() const;
+
+	// Deepest the outgoing queue has been since the last call
+	int32 ConsumePeakOutgoingQueueDepth();
+
+	// Payloads at or above the policy's threshold are compressed before framing
+	void SetCompressionPolicy(const FLiveBPCompressionPolicy& InPolicy);
+	const FLiveBPCompressionPolicy& GetCompressionPolicy() const { return OutboundSettings.CompressionPolicy; }
+
+	// Bounds for the per-peer send rate of previews, which adapts to each peer's round trip, loss and our send queue
+	void SetSendRateBounds(const FLiveBPRateBounds& InBounds);
+
+	// How often to sample previews (the fastest peer's rate), and the current rate to each peer by endpoint
+	float GetEphemeralSendRate() const;
+	void GetPeerSendRates(TMap<FGuid, FLiveBPPeerSendRate>& OutRates) const;
+
+	// Serialize and batch on a background thread (the default), or inline on the game thread
+	void SetUseOutboundWorker(bool bInUseWorker);
+	bool IsOutboundWorkerThreaded() const { return OutboundWorker && OutboundWorker->IsThreaded(); }
+
+	// Blueprints this client has open. Peers only send us previews for these, and we only send
+	// previews to peers that have the Blueprint open; structural messages still go to everyone.
+	void SetLocalInterest(TArrayView<const FGuid> BlueprintIds);
+
+	// Received messages are validated, decoded and resolved on worker threads, then broadcast
+	// here on the game thread at the end of the frame, in arrival order
+	FOnLiveBPInboundMessage OnInboundMessage;
+
+	// User id of a client that left the session, e.g. so the locks it held can be released
+	FOnLiveBPUserLeft OnUserLeft;
+
+	// Blueprints received messages can be applied to, by id; messages for any other are dropped before they reach the game thread
+	void SetResolvableBlueprints(TMap<FGuid, TWeakObjectPtr<UObject>>&& Blueprints);
 
 	// Session status
 	bool IsConnected() const;
 	bool HasActiveSession() const;
 	FString GetCurrentUserId() const;
 	TArray<FString> GetConnectedUsers() const;
+	int32 GetConnectedUserCount() const;
+
+	// Payload encoding for node operations and locks (JSON is only honored in development builds)
+	void SetPayloadEncoding(ELiveBPPayloadEncoding InEncoding);
+	ELiveBPPayloadEncoding GetPayloadEncoding() const { return OutboundSettings.PayloadEncoding; }
 
 private:
 	// Concert client references
 	IConcertSyncClient* ConcertSyncClient;
 	TSharedPtr<IConcertClientSession> ActiveSession;
 
-	// Custom event types for LiveBP collaboration
-	static const FString LiveBPWirePreviewChannel;
-	static const FString LiveBPNodeOperationChannel;
-	static const FString LiveBPLockRequestChannel;
-
 	// Concert event handlers
-	void OnCustomEventReceived(const FConcertSessionContext& Context, const struct FLiveBPConcertEvent& Event);
+	void OnCustomEventReceived(const FConcertSessionContext& Context, const FLiveBPConcertEvent& Event);
 	void OnSessionStartup(TSharedRef<IConcertClientSession> InSession);
 	void OnSessionShutdown(TSharedRef<IConcertClientSession> InSession);
+	void OnSessionClientChanged(IConcertClientSession& InSession, EConcertClientStatus ClientStatus, const FConcertSessionClientInfo& ClientInfo);
+
+	// Outbound work goes to the worker; its finished batches are sent at the end of each engine frame
+	void EnqueueOutbound(FLiveBPOutboundCommand&& Command);
+	void PushOutboundSettings();
+	void OnEndFrame();
+	void SendReadyBatches();
+	TUniquePtr<FLiveBPOutboundWorker> OutboundWorker;
+	FLiveBPOutboundSettings OutboundSettings;
+	FLiveBPConcertEvent OutgoingEvent;
+	FDelegateHandle EndFrameHandle;
+	bool bUseOutboundWorker;
+	bool bWirePreviewStreamActive;
+
+	// Game thread time spent in the send path this frame
+	uint64 GameThreadSendCycles;
 
-	// Serialization helpers for Concert messages
-	TArray<uint8> SerializeWirePreview(const FLiveBPWirePreview& WirePreview) const;
-	TArray<uint8> SerializeNodeOperation(const FLiveBPNodeOperationData& NodeOperation) const;
-	TArray<uint8> SerializeLockRequest(const FLiveBPNodeLock& LockRequest) const;
+	// Other clients in the session, kept up to date from client change events
+	TMap<FGuid, FString> RemoteUserNames;
+	void RebuildRemoteUsers();
 
-	bool DeserializeMessage(const FString& Channel, const TArray<uint8>& Data, FLiveBPMessage& OutMessage) const;
-	bool SendCustomEvent(const FString& Channel, const TArray<uint8>& EventData);
+	// Received batches are decoded off the game thread; prepared messages are applied at the end of each engine frame
+	void ApplyInboundMessages();
+	TUniquePtr<FLiveBPInboundPipeline> InboundPipeline;
 
 	// Internal state
 	bool bIsInitialized;
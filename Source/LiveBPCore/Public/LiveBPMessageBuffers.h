@@ -0,0 +1,153 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeLock.h"
+
+class FLiveBPBufferPool;
+
+/**
+ * Byte buffer borrowed from a FLiveBPBufferPool. Move-only; the buffer goes back to its pool,
+ * capacity intact, when the handle is destroyed.
+ */
+class LIVEBPCORE_API FLiveBPPooledBuffer
+{
+public:
+	FLiveBPPooledBuffer();
+	FLiveBPPooledBuffer(FLiveBPPooledBuffer&& Other);
+	FLiveBPPooledBuffer& operator=(FLiveBPPooledBuffer&& Other);
+	~FLiveBPPooledBuffer();
+
+	FLiveBPPooledBuffer(const FLiveBPPooledBuffer&) = delete;
+	FLiveBPPooledBuffer& operator=(const FLiveBPPooledBuffer&) = delete;
+
+	TArray<uint8>& Get() { return Buffer; }
+	const TArray<uint8>& Get() const { return Buffer; }
+	int32 Num() const { return Buffer.Num(); }
+
+	/** Returns the buffer to its pool early */
+	void Release();
+
+private:
+	friend class FLiveBPBufferPool;
+
+	TArray<uint8> Buffer;
+	FLiveBPBufferPool* Pool;
+};
+
+/**
+ * Free list of outgoing payload buffers. Serializers write straight into a pooled buffer, so once
+ * the pool is warm a send does not touch the heap. Not thread-safe; each pool belongs to one thread.
+ */
+class LIVEBPCORE_API FLiveBPBufferPool
+{
+public:
+	/**
+	 * @param InMaxPooledBuffers Buffers kept on the free list; extra releases are freed
+	 * @param InMaxPooledCapacity Larger buffers (e.g. a big paste) are freed on release instead of pinning memory
+	 */
+	explicit FLiveBPBufferPool(int32 InMaxPooledBuffers = 16, int32 InMaxPooledCapacity = 64 * 1024);
+	~FLiveBPBufferPool();
+
+	FLiveBPPooledBuffer Acquire();
+
+	/** Buffers handed out that had to be created because the free list was empty */
+	int32 GetNumCreated() const { return NumCreated; }
+	int32 GetNumFree() const { return FreeBuffers.Num(); }
+
+private:
+	friend class FLiveBPPooledBuffer;
+
+	void Release(TArray<uint8>& Buffer);
+
+	TArray<TArray<uint8>> FreeBuffers;
+	int32 MaxPooledBuffers;
+	int32 MaxPooledCapacity;
+	int32 NumCreated;
+	int32 NumOutstanding;
+};
+
+/**
+ * Bump allocator for data decoded out of one incoming Concert event (e.g. decompressed
+ * payloads). Everything is released at once by Reset(); the blocks are kept for the next event.
+ */
+class LIVEBPCORE_API FLiveBPDecodeArena
+{
+public:
+	explicit FLiveBPDecodeArena(int32 InBlockSize = 64 * 1024);
+
+	/** Uninitialized bytes that stay valid until the next Reset */
+	TArrayView<uint8> Allocate(int32 NumBytes);
+
+	/** Releases every allocation made since the last reset */
+	void Reset();
+
+	/** Heap allocations the arena itself has made */
+	int32 GetNumBlockAllocations() const { return NumBlockAllocations; }
+	int32 GetBytesUsed() const;
+
+private:
+	TArray<TArray<uint8>> Blocks;
+	int32 BlockSize;
+	int32 CurrentBlock;
+	int32 CurrentOffset;
+	int32 NumBlockAllocations;
+};
+
+/**
+ * Multi-producer, single-consumer queue that recycles its slots. Producers fill the next slot in
+ * place under a short lock; the consumer swaps the filled slots out wholesale and walks them
+ * without holding it. Slots are never destroyed, so once both sides are warm a payload that is
+ * assigned into a slot reuses the capacity the slot already had, and nothing touches the heap.
+ *
+ * Fill must overwrite everything the consumer reads, since a slot still holds whatever it
+ * carried last time round.
+ */
+template<typename ItemType>
+class TLiveBPSwapQueue
+{
+public:
+	/** Fills the next slot. Returns true if the queue was empty, i.e. the consumer may need waking. */
+	template<typename FillType>
+	bool Enqueue(FillType&& Fill)
+	{
+		FScopeLock Lock(&ProducerLock);
+		if (NumProduced == Producing.Num())
+		{
+			Producing.AddDefaulted();
+		}
+		Fill(Producing[NumProduced]);
+		return NumProduced++ == 0;
+	}
+
+	/** Hands every slot filled so far to Consume in order and returns how many there were. Consumer only. */
+	template<typename ConsumeType>
+	int32 Drain(ConsumeType&& Consume)
+	{
+		int32 NumConsumed = 0;
+		{
+			FScopeLock Lock(&ProducerLock);
+			Swap(Producing, Consuming);
+			NumConsumed = NumProduced;
+			NumProduced = 0;
+		}
+
+		for (int32 Index = 0; Index < NumConsumed; ++Index)
+		{
+			Consume(Consuming[Index]);
+		}
+		return NumConsumed;
+	}
+
+	/** Discards whatever is queued; the slots stay for reuse */
+	void Reset()
+	{
+		FScopeLock Lock(&ProducerLock);
+		NumProduced = 0;
+	}
+
+private:
+	FCriticalSection ProducerLock;
+	TArray<ItemType> Producing;
+	TArray<ItemType> Consuming; // Only touched by the consumer outside the lock
+	int32 NumProduced = 0;
+};
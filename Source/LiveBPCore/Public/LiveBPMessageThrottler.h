@@ -40,12 +40,13 @@ public:
 	/**
 	 * Get the throttle interval for a message type
 	 * @param MessageType The message type
-	 * @return Minimum interval between messages in seconds
+	 * @return Minimum interval between messages in seconds; the custom interval if one is set
 	 */
-	static float GetThrottleInterval(ELiveBPMessageType MessageType);
+	float GetThrottleInterval(ELiveBPMessageType MessageType) const;
 
 	/**
-	 * Set custom throttle interval for a message type
+	 * Set custom throttle interval for a message type. The transport keeps the wire preview
+	 * interval in step with its congestion-controlled send rate.
 	 * @param MessageType The message type
 	 * @param Interval Minimum interval in seconds
 	 */
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * One node's new position in a multi-node move. Graph node positions are integral.
+ */
+struct FLiveBPNodeMove
+{
+	FGuid NodeId;
+	FIntPoint Position = FIntPoint::ZeroValue;
+};
+
+/**
+ * Collects the node moves reported during one tick, last write wins per node.
+ *
+ * Dragging a selection reports every selected node on every frame; coalesced, each drag step
+ * goes out as one message per graph instead of one per node, and a node reported several times
+ * only carries its final position. Moves keep the order their nodes were first reported in.
+ * Storage for the graphs that keep moving is reused from tick to tick.
+ * Not thread-safe; it belongs to the send pipeline.
+ */
+class LIVEBPCORE_API FLiveBPNodeMoveCoalescer
+{
+public:
+	using FEmitFunc = TFunctionRef<void(const FGuid& BlueprintId, const FGuid& GraphId, TArrayView<const FLiveBPNodeMove> Moves)>;
+
+	void Add(const FGuid& BlueprintId, const FGuid& GraphId, const FGuid& NodeId, const FIntPoint& Position);
+
+	/** Hands every graph's moves to Emit and starts a new tick. Moves added from Emit go out on the next flush. */
+	void Flush(FEmitFunc Emit);
+
+	bool IsEmpty() const { return NumPending == 0; }
+	int32 Num() const { return NumPending; }
+
+	void Reset();
+
+private:
+	struct FGroup
+	{
+		FGuid BlueprintId;
+		FGuid GraphId;
+		TArray<FLiveBPNodeMove> Moves;
+		TMap<FGuid, int32> MoveIndices;
+	};
+
+	TArray<FGroup> Groups;
+	int32 NumPending = 0;
+};
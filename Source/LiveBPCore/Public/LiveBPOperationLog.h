@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LiveBPDataTypes.h"
+
+/**
+ * Sequence numbers for the edits a sender makes (node operations, moves, transactions, lock requests and releases).
+ *
+ * These go to every peer on the reliable lane, so a sender stamps them from one counter and a
+ * receiver sees a contiguous sequence. The receiver keeps the highest number it has accepted and a
+ * window of the WindowSize numbers below it: anything already in the window, or too old to still be
+ * in it, is a duplicate (a resend, or a replay after a reconnect) and is dropped without being applied
+ * twice. A number that skips ahead leaves a gap that later arrivals may still fill; the numbers still
+ * missing when the window moves past them are reported as lost. Zero is never used and means
+ * "not logged" on the wire.
+ */
+class LIVEBPCORE_API FLiveBPOperationLog
+{
+public:
+	static constexpr int32 WindowSize = 64;
+
+	enum class EAcceptResult : uint8
+	{
+		Accepted,
+		Duplicate // Already applied, or older than the window
+	};
+
+	FLiveBPOperationLog();
+
+	/** Whether messages of a type are stamped from the log */
+	static bool IsLogged(ELiveBPMessageType MessageType);
+
+	/** Sender side: the next number */
+	uint32 Next();
+
+	/**
+	 * Receiver side: checks a number against the ones already accepted
+	 * @param OutLostCount Numbers the window moved past without them arriving
+	 */
+	EAcceptResult Accept(uint32 Sequence, int32& OutLostCount);
+
+	/** Numbers skipped ahead of that are still missing but may yet arrive */
+	int32 GetPendingGapCount() const;
+
+	void Reset();
+
+private:
+	uint32 LastSent;
+	uint32 Highest;
+	uint64 Received; // Bit N is set once Highest - N has been accepted
+	bool bHasReceived;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Delivery lane of an outgoing frame. Reliable frames arrive once and in order; unreliable ones
+ * may be lost or reordered and are meant for ephemeral, latest-wins traffic like previews.
+ */
+enum class ELiveBPDelivery : uint8
+{
+	Reliable,
+	Unreliable
+};
+
+/**
+ * When queued frames are flushed. The byte threshold always applies; a max delay of zero flushes
+ * at the end of every editor tick.
+ */
+struct FLiveBPBatchPolicy
+{
+	/** Flush as soon as the queued frames reach this many bytes. Zero sends every frame on its own. */
+	int32 MaxBatchBytes = 16 * 1024;
+
+	/** Longest a frame may wait for others to join its batch. Zero means end of tick. */
+	double MaxDelaySeconds = 0.0;
+};
+
+/**
+ * Collects outgoing LiveBP frames and packs them into one batch per destination and lane.
+ *
+ * A batch is a sequence of [varint length][frame] records. A frame joins the most recent batch
+ * of its lane when that batch has the same destination set, and starts a new one otherwise, so
+ * every endpoint still receives each lane's frames in the order they were queued. The lanes are
+ * independent on the wire, so interleaving them does not split batches.
+ * Batch storage is recycled after each flush, so a warm batcher does not allocate.
+ */
+class LIVEBPCORE_API FLiveBPOutboundBatcher
+{
+public:
+	struct FBatch
+	{
+		TArray<FGuid> Destinations;
+		TArray<uint8> Data;
+		int32 FrameCount = 0;
+		ELiveBPDelivery Delivery = ELiveBPDelivery::Reliable;
+	};
+
+	FLiveBPOutboundBatcher();
+
+	void SetPolicy(const FLiveBPBatchPolicy& InPolicy) { Policy = InPolicy; }
+	const FLiveBPBatchPolicy& GetPolicy() const { return Policy; }
+
+	/**
+	 * Queues a frame for the given endpoints
+	 * @return true if the byte threshold was reached and the queue should be flushed now
+	 */
+	bool Enqueue(const TArray<FGuid>& Destinations, TArrayView<const uint8> Frame, double CurrentTime, ELiveBPDelivery Delivery = ELiveBPDelivery::Reliable);
+
+	/** Whether the queued frames are due at the end of this tick */
+	bool IsFlushDue(double CurrentTime) const;
+
+	/**
+	 * Hands every queued batch to Send in order, then recycles them. Send may swap Data out
+	 * temporarily (e.g. into a Concert event) as long as it swaps it back.
+	 */
+	void Flush(TFunctionRef<void(FBatch& Batch)> Send);
+
+	bool HasPendingFrames() const { return NumActiveBatches > 0; }
+	int32 GetPendingBytes() const { return PendingBytes; }
+	void Reset();
+
+	/** Appends one length-prefixed frame to batch data */
+	static void AppendFrame(TArray<uint8>& BatchData, TArrayView<const uint8> Frame);
+
+	/**
+	 * Splits batch data back into frames; the views point into BatchData
+	 * @return false if a record is truncated
+	 */
+	static bool SplitFrames(TArrayView<const uint8> BatchData, TArray<TArrayView<const uint8>>& OutFrames);
+
+private:
+	FLiveBPBatchPolicy Policy;
+	TArray<FBatch> Batches; // The first NumActiveBatches are queued, the rest are spare
+	int32 NumActiveBatches;
+	int32 LastBatchIndex[2]; // Most recent queued batch per lane, or INDEX_NONE
+	int32 PendingBytes;
+	double OldestFrameTime;
+};
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LiveBPDataTypes.h"
+#include "LiveBPBinaryCodec.h"
+#include "LiveBPMessageBuffers.h"
+#include "LiveBPSessionDictionary.h"
+#include "LiveBPWirePreviewStream.h"
+#include "LiveBPOutboundBatcher.h"
+#include "LiveBPOutboundScheduler.h"
+#include "LiveBPInterestRoutes.h"
+#include "LiveBPSequenceTracker.h"
+#include "LiveBPOperationLog.h"
+#include "LiveBPCongestionControl.h"
+#include "LiveBPPresence.h"
+#include "LiveBPNodeMoves.h"
+
+/**
+ * Send policies, applied together so a worker never sees half an update
+ */
+struct FLiveBPOutboundSettings
+{
+	FLiveBPBatchPolicy BatchPolicy;
+	FLiveBPCompressionPolicy CompressionPolicy;
+	ELiveBPPayloadEncoding PayloadEncoding = ELiveBPPayloadEncoding::Binary;
+	int32 MaxQueueDepth = 100;
+	float WirePreviewMovementThreshold = 0.1f;
+	float PresenceMovementThreshold = FLiveBPPresenceEncoder::GridSize;
+	FLiveBPRateBounds RateBounds;
+};
+
+/**
+ * The send side of a LiveBP session: serializes messages, queues them by priority, routes them
+ * by interest, frames them against the session dictionary and packs the frames into batches.
+ * Finished batches go to the sink given at construction, which owns the actual Concert send.
+ *
+ * Not thread-safe; it belongs to whichever thread does the sending (see FLiveBPOutboundWorker).
+ */
+class LIVEBPCORE_API FLiveBPOutboundPipeline
+{
+public:
+	using FBatchSink = TFunction<void(FLiveBPOutboundBatcher::FBatch& Batch)>;
+
+	explicit FLiveBPOutboundPipeline(FBatchSink InBatchSink);
+
+	void ApplySettings(const FLiveBPOutboundSettings& InSettings);
+
+	// Session membership. Endpoints never include our own, so nothing we send echoes back.
+	void StartSession(const FString& InUserId, TArrayView<const FGuid> Endpoints);
+	void EndSession();
+	void AddEndpoint(const FGuid& EndpointId);
+	void RemoveEndpoint(const FGuid& EndpointId);
+	void SetRemoteInterest(const FGuid& EndpointId, TArrayView<const FGuid> BlueprintIds);
+
+	// Our own interest set, re-sent to every joiner once we have published one
+	void SetLocalInterest(TArrayView<const FGuid> BlueprintIds);
+
+	// A peer's probe, which carries the round trip and loss of our traffic to it
+	void OnHeartbeat(const FGuid& EndpointId, const FLiveBPHeartbeatReceipt& Receipt);
+
+	// A peer's latest view; unreliable previews it could not see are not sent to it
+	void SetRemoteView(const FGuid& EndpointId, const FLiveBPRemoteView& View);
+
+	// Messages are only queued here; they are framed when the tick ends
+	void SendWirePreview(const FLiveBPWirePreview& WirePreview, const FGuid& BlueprintId, const FGuid& GraphId);
+	// Node operations are held until the tick ends; several from one graph go out as a single transaction
+	void SendNodeOperation(const FLiveBPNodeOperationData& NodeOperation, const FGuid& BlueprintId, const FGuid& GraphId);
+	void SendLockRequest(const FLiveBPNodeLock& LockRequest, const FGuid& BlueprintId, const FGuid& GraphId);
+	// One message for the whole set; the JSON debug encoding falls back to a lock request per node
+	void SendLockSet(const FLiveBPNodeLockSet& LockSet, const FGuid& BlueprintId, const FGuid& GraphId);
+
+	// Moves are coalesced per node until the tick ends, then sent as one message per graph
+	void SendNodeMove(const FGuid& NodeId, const FIntPoint& Position, const FGuid& BlueprintId, const FGuid& GraphId);
+
+	// Our cursor and view; only changes beyond the movement threshold go out, plus a periodic keep-alive
+	void SendPresence(const FLiveBPPresence& Presence, const FGuid& BlueprintId, const FGuid& GraphId);
+
+	// Wire preview stream: the anchor goes out once, then only quantized end position deltas
+	void BeginWirePreviewStream(const FLiveBPWirePreview& WirePreview, const FGuid& BlueprintId, const FGuid& GraphId);
+	void UpdateWirePreviewStream(const FVector2D& EndPosition);
+	void EndWirePreviewStream();
+
+	/** Frames everything queued this tick and hands batches to the sink once the batch policy says they are due */
+	void EndTick(double CurrentTime);
+
+	/** Frames and hands over everything queued so far without waiting for the policy */
+	void Flush();
+
+	int32 GetQueueDepth() const { return OutgoingQueue.Num(); }
+	int32 ConsumePeakQueueDepth() { return OutgoingQueue.ConsumePeakDepth(); }
+
+	const FLiveBPCongestionController& GetCongestionController() const { return Congestion; }
+
+private:
+	// Serialization helpers; they write straight into pooled buffers
+	FLiveBPPooledBuffer SerializeWirePreview(const FLiveBPWirePreview& WirePreview);
+	FLiveBPPooledBuffer SerializeNodeOperation(const FLiveBPNodeOperationData& NodeOperation);
+	FLiveBPPooledBuffer SerializeLockRequest(const FLiveBPNodeLock& LockRequest);
+
+	// Queues the message by priority; it is framed for the clients it is routed to when the queue
+	// drains, and the payload then goes back to the pool. Unreliable messages are sequenced per
+	// peer so receivers can drop stale ones.
+	void SendMessage(ELiveBPMessageType MessageType, const FGuid& BlueprintId, const FGuid& GraphId, FLiveBPPooledBuffer&& Payload,
+		ELiveBPDelivery Delivery = ELiveBPDelivery::Reliable);
+	void DispatchMessage(FLiveBPOutgoingMessage& Message);
+	void SendMessageTo(const TArray<FGuid>& Endpoints, ELiveBPMessageType MessageType, const FGuid& BlueprintId, const FGuid& GraphId,
+		FLiveBPPooledBuffer&& Payload, ELiveBPDelivery Delivery = ELiveBPDelivery::Reliable);
+	void QueueFrame(const TArray<FGuid>& Endpoints, TArrayView<const uint8> Frame, ELiveBPDelivery Delivery = ELiveBPDelivery::Reliable);
+	void SendLocalInterest(const TArray<FGuid>& Endpoints);
+	void SendHeartbeats(double CurrentTime);
+	void QueuePresence();
+	void QueueNodeMoves();
+	void QueueNodeOperations();
+	bool IsVisibleTo(const FGuid& EndpointId, const FLiveBPOutgoingMessage& Message) const;
+	void DrainOutgoingQueue();
+	void SendBatches();
+
+	// Ephemeral traffic that only peers with the same Blueprint open care about
+	static bool IsInterestRouted(ELiveBPMessageType MessageType);
+
+	FBatchSink BatchSink;
+	FLiveBPOutboundSettings Settings;
+	FString UserId;
+	bool bInSession;
+
+	// Other clients in the session and what they have open
+	FLiveBPInterestRoutes RemoteEndpoints;
+
+	// Per-peer pacing of unreliable traffic
+	FLiveBPCongestionController Congestion;
+	TArray<FGuid> PacedEndpoints;
+
+	// Peers an unreliable message goes to, by the number each one gets it under, and those that share one
+	TArray<TPair<uint32, FGuid>> SequencedEndpoints;
+	TArray<FGuid> FrameEndpoints;
+
+	// What each peer is looking at, from its presence updates
+	TMap<FGuid, FLiveBPRemoteView> RemoteViews;
+
+	TArray<FGuid> LocalInterest;
+	bool bHasLocalInterest;
+
+	// Reused message storage; once warm, sending does not allocate on our side
+	FLiveBPBufferPool PayloadPool;
+	FLiveBPOutboundScheduler OutgoingQueue; // Holds pooled payloads, so it must be destroyed before the pool
+	FLiveBPOutboundBatcher OutboundBatcher;
+	TArray<uint8> FrameBuffer;
+
+	// Our session dictionary handles, and unreliable lane sequence numbers per peer
+	FLiveBPNameInterner LocalNames;
+	TMap<FGuid, FLiveBPSequenceTracker> OutgoingSequences;
+	FLiveBPOperationLog OutgoingOperations;
+
+	// Outgoing wire preview stream, and the extent of its latest update for culling
+	FLiveBPWirePreviewEncoder WirePreviewEncoder;
+	FGuid WirePreviewBlueprintId;
+	FGuid WirePreviewGraphId;
+	FBox2D WirePreviewBounds;
+
+	// Outgoing presence stream
+	FLiveBPPresenceEncoder PresenceEncoder;
+
+	// Node moves and other node operations of the current tick
+	FLiveBPNodeMoveCoalescer NodeMoves;
+	TArray<FLiveBPNodeOperationData> PendingNodeOperations;
+	FGuid PendingNodeOperationsBlueprintId;
+	FGuid PendingNodeOperationsGraphId;
+};
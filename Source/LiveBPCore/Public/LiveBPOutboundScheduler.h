@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LiveBPDataTypes.h"
+#include "LiveBPMessageBuffers.h"
+#include "LiveBPOutboundBatcher.h"
+
+/**
+ * Send priority classes, highest first
+ */
+enum class ELiveBPSendPriority : uint8
+{
+	Ownership,  // Lock requests and releases
+	Structural, // Node operations, interest sets and reliable stream keyframes
+	Ephemeral,  // Unreliable previews and cursors
+
+	Count
+};
+
+/**
+ * A message waiting to be framed. The payload is already serialized; framing (and with it
+ * routing and dictionary definitions) happens when the scheduler is drained.
+ */
+struct FLiveBPOutgoingMessage
+{
+	ELiveBPMessageType MessageType = ELiveBPMessageType::Heartbeat;
+	FGuid BlueprintId;
+	FGuid GraphId;
+	FLiveBPPooledBuffer Payload;
+	ELiveBPDelivery Delivery = ELiveBPDelivery::Reliable;
+};
+
+/**
+ * Strict-priority outbound queue with a bounded depth per class.
+ *
+ * Draining hands out every Ownership message before any Structural one, and every Structural
+ * message before any Ephemeral one; within a class messages keep their order.
+ * A full reliable class asks the caller to drain right away, since those messages can't be
+ * dropped. A full Ephemeral class replaces the queued message of the same stream (message type
+ * and Blueprint) with the new one, or drops its oldest message when there is none.
+ * Not thread-safe; it belongs to the outbound pipeline.
+ */
+class LIVEBPCORE_API FLiveBPOutboundScheduler
+{
+public:
+	FLiveBPOutboundScheduler();
+
+	static ELiveBPSendPriority GetPriority(ELiveBPMessageType MessageType, ELiveBPDelivery Delivery);
+
+	/** Messages each class may hold */
+	void SetMaxDepth(int32 InMaxDepth) { MaxDepth = FMath::Max(1, InMaxDepth); }
+	int32 GetMaxDepth() const { return MaxDepth; }
+
+	/**
+	 * Queues a message
+	 * @return true if a reliable class is full and the queue should be drained now
+	 */
+	bool Enqueue(FLiveBPOutgoingMessage&& Message);
+
+	/** Hands every queued message to Send in priority order, then empties the queue. Send must not enqueue. */
+	void Drain(TFunctionRef<void(FLiveBPOutgoingMessage& Message)> Send);
+
+	int32 Num() const;
+	int32 Num(ELiveBPSendPriority Priority) const { return Queues[static_cast<int32>(Priority)].Num(); }
+
+	/** Deepest the queue has been since the last call */
+	int32 ConsumePeakDepth();
+
+	/** Ephemeral messages replaced or dropped because their class was full */
+	int32 GetNumCoalesced() const { return NumCoalesced; }
+
+	void Reset();
+
+private:
+	TArray<FLiveBPOutgoingMessage> Queues[static_cast<int32>(ELiveBPSendPriority::Count)];
+	int32 MaxDepth;
+	int32 PeakDepth;
+	int32 NumCoalesced;
+	bool bDraining;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/SpscQueue.h"
+#include "Misc/TVariant.h"
+#include "LiveBPOutboundPipeline.h"
+#include "LiveBPMessageBuffers.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Session membership handed to the send pipeline when a session starts
+ */
+struct FLiveBPOutboundSession
+{
+	FString UserId;
+	TArray<FGuid> Endpoints;
+};
+
+/**
+ * One unit of outbound work. The game thread only fills these in; serialization, framing and
+ * batching happen when the worker processes them.
+ */
+struct FLiveBPOutboundCommand
+{
+	enum class EKind : uint8
+	{
+		ApplySettings,      // Data: FLiveBPOutboundSettings
+		StartSession,       // Data: FLiveBPOutboundSession
+		EndSession,
+		AddEndpoint,        // Id: endpoint
+		RemoveEndpoint,     // Id: endpoint
+		SetRemoteInterest,  // Id: endpoint, Data: Blueprint ids
+		SetLocalInterest,   // Data: Blueprint ids
+		Heartbeat,          // Id: endpoint, Data: FLiveBPHeartbeatReceipt
+		SetRemoteView,      // Id: endpoint, Data: FLiveBPRemoteView
+		WirePreview,        // Data: FLiveBPWirePreview
+		BeginWirePreview,   // Data: FLiveBPWirePreview
+		UpdateWirePreview,  // Data: end position
+		EndWirePreview,
+		NodeOperation,      // Data: FLiveBPNodeOperationData
+		NodeMove,           // Data: FLiveBPNodeMove
+		LockRequest,        // Data: FLiveBPNodeLock
+		LockSet,            // Data: FLiveBPNodeLockSet
+		Presence,           // Data: FLiveBPPresence
+		EndTick,
+		Flush
+	};
+
+	using FData = TVariant<FEmptyVariantState, FLiveBPOutboundSettings, FLiveBPOutboundSession, TArray<FGuid>,
+		FLiveBPWirePreview, FVector2D, FLiveBPNodeOperationData, FLiveBPNodeLock, FLiveBPHeartbeatReceipt, FLiveBPRemoteView, FLiveBPPresence,
+		FLiveBPNodeMove, FLiveBPNodeLockSet>;
+
+	EKind Kind = EKind::Flush;
+	FGuid Id;          // Blueprint for messages, endpoint for membership changes
+	FGuid GraphId;
+	FData Data;
+};
+
+/**
+ * Runs the outbound pipeline off the game thread.
+ *
+ * Any thread queues commands into recycled slots (see TLiveBPSwapQueue); the worker thread
+ * applies them to its FLiveBPOutboundPipeline in order and parks finished batches on an SPSC
+ * queue, which the game thread empties into Concert (whose sessions are not safe to send on from
+ * other threads). Batch storage is handed back to the worker after each send, so a warm worker
+ * allocates neither for commands nor for batches.
+ *
+ * Without a thread (disabled, or a platform without threading) commands are processed inline on
+ * the caller, which must then be the game thread.
+ */
+class LIVEBPCORE_API FLiveBPOutboundWorker : public FRunnable
+{
+public:
+	FLiveBPOutboundWorker();
+	virtual ~FLiveBPOutboundWorker();
+
+	/** Starts or stops the worker thread. Pipeline state carries over either way. */
+	void SetThreaded(bool bInThreaded);
+	bool IsThreaded() const { return Thread != nullptr; }
+
+	/**
+	 * Queues a command for the pipeline. Safe from any thread while the worker is threaded;
+	 * otherwise the command is processed inline, so it must come from the game thread.
+	 */
+	void Enqueue(FLiveBPOutboundCommand&& Command);
+
+	/** Blocks until every command queued so far has been processed */
+	void WaitUntilIdle();
+
+	/** Hands every finished batch to Send in order. Game thread only. */
+	void SendReadyBatches(TFunctionRef<void(FLiveBPOutboundBatcher::FBatch& Batch)> Send);
+
+	/** Time spent processing commands since the last call, in seconds */
+	double ConsumeProcessingTime();
+
+	/** Pipeline queue depth as of the last processed command, and its peak since the last call */
+	int32 GetQueueDepth() const { return QueueDepth.load(std::memory_order_relaxed); }
+	int32 ConsumePeakQueueDepth() { return PeakQueueDepth.exchange(0, std::memory_order_relaxed); }
+
+	/** Congestion-controlled send rates as of the last processed command; safe from any thread */
+	float GetMaxSendRate() const { return MaxSendRate.load(std::memory_order_relaxed); }
+	void GetSendRates(TMap<FGuid, FLiveBPPeerSendRate>& OutRates) const;
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	void ProcessCommands();
+	void ProcessCommand(FLiveBPOutboundCommand& Command);
+	void OnBatchReady(FLiveBPOutboundBatcher::FBatch& Batch);
+	void PublishSendRates();
+
+	FLiveBPOutboundPipeline Pipeline; // Only touched by the thread processing commands
+
+	TLiveBPSwapQueue<FLiveBPOutboundCommand> Commands;
+	TSpscQueue<FLiveBPOutboundBatcher::FBatch> ReadyBatches; // Worker to game thread
+	TSpscQueue<FLiveBPOutboundBatcher::FBatch> SpareBatches; // Game thread back to worker
+
+	FRunnableThread* Thread;
+	FEvent* WorkEvent;
+	std::atomic<bool> bStopRequested;
+
+	std::atomic<uint64> NumEnqueued;
+	std::atomic<uint64> NumProcessed;
+	std::atomic<uint64> ProcessingCycles;
+	std::atomic<int32> QueueDepth;
+	std::atomic<int32> PeakQueueDepth;
+
+	std::atomic<float> MaxSendRate;
+	mutable FCriticalSection SendRatesLock;
+	TMap<FGuid, FLiveBPPeerSendRate> SendRates;
+};
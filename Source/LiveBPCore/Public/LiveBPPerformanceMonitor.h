@@ -19,6 +19,28 @@ public:
 		int32 TotalMessagesSent = 0;
 		int32 TotalMessagesReceived = 0;
 		
+		// Outbound batching
+		int32 TotalBatchesSent = 0;
+		float AverageFramesPerBatch = 0.0f;
+		float AverageBatchBytes = 0.0f;
+		int32 PeakFramesPerBatch = 0;
+		
+		// Unreliable lane (previews, cursors)
+		int32 UnreliableMessagesSent = 0;
+		int32 UnreliableMessagesReceived = 0;
+		int32 UnreliableMessagesLost = 0;    // Sequence gaps; never arrived, or not yet
+		int32 UnreliableMessagesDropped = 0; // Arrived out of order or already superseded
+		float UnreliableLossRate = 0.0f;
+		
+		// Operation log (edits on the reliable lane)
+		int32 OperationsReceived = 0;
+		int32 OperationsLost = 0;            // Gaps the reorder window moved past
+		int32 DuplicateOperationsDropped = 0;
+		
+		// Outbound worker, per editor frame
+		float OutboundGameThreadMs = 0.0f; // Send path time left on the game thread
+		float OutboundOffloadedMs = 0.0f;  // Serialization and batching the worker took off it
+		
 		// Network latency
 		float AverageLatencyMs = 0.0f;
 		float PeakLatencyMs = 0.0f;
@@ -39,6 +61,8 @@ public:
 		// Frame performance
 		float AverageFrameTimeMs = 0.0f;
 		float CollaborationOverheadMs = 0.0f;
+		int32 RemoteApplyBacklog = 0;      // Remote operations waiting for a later frame
+		int32 PeakRemoteApplyBacklog = 0;
 		
 		// Session info
 		float SessionDurationSeconds = 0.0f;
@@ -46,6 +70,18 @@ public:
 		bool bIsSessionActive = false;
 	};
 
+	struct FCompressionMetrics
+	{
+		int32 Attempts = 0;            // Payloads over the threshold
+		int32 CompressedCount = 0;     // Attempts that were sent compressed
+		int64 RawBytes = 0;
+		int64 SentBytes = 0;
+		float CompressionRatio = 1.0f; // SentBytes / RawBytes, lower is better
+		float AverageCompressTimeMs = 0.0f;
+		int32 Decompressions = 0;
+		float AverageDecompressTimeMs = 0.0f;
+	};
+
 	struct FScopeTimer
 	{
 		FScopeTimer(const FString& InName, FLiveBPPerformanceMonitor* InMonitor);
@@ -91,6 +127,61 @@ public:
 	 */
 	void RecordMessageReceived(ELiveBPMessageType MessageType, int32 PayloadSize, float LatencyMs);
 
+	/**
+	 * Record an outbound batch
+	 * @param FrameCount Number of frames packed into the batch
+	 * @param BatchSize Size of the batch in bytes
+	 */
+	void RecordBatchSent(int32 FrameCount, int32 BatchSize);
+
+	/**
+	 * Record a message sent on the unreliable lane
+	 */
+	void RecordUnreliableSent();
+
+	/**
+	 * Record a sequenced message received on the unreliable lane
+	 * @param LostCount Sequence numbers skipped since the previous accepted message
+	 * @param bDropped Whether it was discarded as out of order or superseded
+	 */
+	void RecordUnreliableReceived(int32 LostCount, bool bDropped);
+
+	/**
+	 * Record a logged edit received on the reliable lane
+	 * @param LostCount Missing operations the reorder window moved past
+	 * @param bDuplicate Whether it was discarded as already applied
+	 */
+	void RecordOperationReceived(int32 LostCount, bool bDuplicate);
+
+	/**
+	 * Record one editor frame of outbound work
+	 * @param GameThreadMs Time the game thread spent queueing messages and handing batches to Concert
+	 * @param OffloadedMs Time the outbound worker spent on that frame's messages instead of the game thread
+	 */
+	void RecordOutboundFrame(float GameThreadMs, float OffloadedMs);
+
+	/**
+	 * Record a payload compression attempt
+	 * @param MessageType Type of message
+	 * @param RawSize Uncompressed payload size in bytes
+	 * @param SentSize Payload size actually sent (RawSize if compression did not pay off)
+	 * @param DurationMs CPU time spent compressing
+	 */
+	void RecordCompression(ELiveBPMessageType MessageType, int32 RawSize, int32 SentSize, float DurationMs);
+
+	/**
+	 * Record a payload decompression
+	 * @param MessageType Type of message
+	 * @param DurationMs CPU time spent decompressing
+	 */
+	void RecordDecompression(ELiveBPMessageType MessageType, float DurationMs);
+
+	/**
+	 * Get compression statistics per message type
+	 * @return Map of message types to their compression metrics
+	 */
+	TMap<ELiveBPMessageType, FCompressionMetrics> GetCompressionMetrics() const;
+
 	/**
 	 * Record an error
 	 * @param ErrorType Type of error
@@ -117,8 +208,9 @@ public:
 	 * Record frame performance
 	 * @param FrameTimeMs Frame time in milliseconds
 	 * @param CollaborationOverheadMs Time spent on collaboration in milliseconds
+	 * @param RemoteApplyBacklog Remote operations left over for later frames
 	 */
-	void RecordFramePerformance(float FrameTimeMs, float CollaborationOverheadMs);
+	void RecordFramePerformance(float FrameTimeMs, float CollaborationOverheadMs, int32 RemoteApplyBacklog = 0);
 
 	/**
 	 * Add a scoped timer measurement
@@ -199,6 +291,36 @@ private:
 	FMessageStats ReceivedMessages;
 	TMap<ELiveBPMessageType, FMessageStats> MessageTypeStats;
 	
+	// Compression statistics
+	struct FCompressionStats
+	{
+		int32 Attempts = 0;
+		int32 CompressedCount = 0;
+		int64 RawBytes = 0;
+		int64 SentBytes = 0;
+		double CompressTimeMs = 0.0;
+		int32 Decompressions = 0;
+		double DecompressTimeMs = 0.0;
+	};
+	TMap<ELiveBPMessageType, FCompressionStats> CompressionStats;
+	
+	// Batch statistics
+	int32 BatchCount;
+	int32 BatchedFrameCount;
+	int64 BatchedBytes;
+	int32 PeakFramesPerBatch;
+	
+	// Unreliable lane statistics
+	int32 UnreliableSentCount;
+	int32 UnreliableReceivedCount;
+	int32 UnreliableLostCount;
+	int32 UnreliableDroppedCount;
+	
+	// Operation log statistics
+	int32 OperationReceivedCount;
+	int32 OperationLostCount;
+	int32 OperationDuplicateCount;
+	
 	// Latency tracking
 	static const int32 MAX_LATENCY_SAMPLES = 100;
 	TCircularBuffer<FLatencyMeasurement, MAX_LATENCY_SAMPLES> LatencyHistory;
@@ -218,6 +340,10 @@ private:
 	static const int32 MAX_FRAME_SAMPLES = 60;
 	TCircularBuffer<float, MAX_FRAME_SAMPLES> FrameTimeHistory;
 	TCircularBuffer<float, MAX_FRAME_SAMPLES> CollaborationOverheadHistory;
+	TCircularBuffer<float, MAX_FRAME_SAMPLES> OutboundGameThreadHistory;
+	TCircularBuffer<float, MAX_FRAME_SAMPLES> OutboundOffloadedHistory;
+	int32 CurrentRemoteApplyBacklog;
+	int32 PeakRemoteApplyBacklog;
 	
 	// Session info
 	int32 CurrentConnectedUsers;
@@ -260,5 +386,26 @@ private:
 #define LIVEBP_RECORD_MESSAGE_RECEIVED(Type, Size, Latency) \
 	FLiveBPGlobalPerformanceMonitor::Get().RecordMessageReceived(Type, Size, Latency)
 
+#define LIVEBP_RECORD_BATCH_SENT(FrameCount, Size) \
+	FLiveBPGlobalPerformanceMonitor::Get().RecordBatchSent(FrameCount, Size)
+
+#define LIVEBP_RECORD_UNRELIABLE_SENT() \
+	FLiveBPGlobalPerformanceMonitor::Get().RecordUnreliableSent()
+
+#define LIVEBP_RECORD_UNRELIABLE_RECEIVED(LostCount, bDropped) \
+	FLiveBPGlobalPerformanceMonitor::Get().RecordUnreliableReceived(LostCount, bDropped)
+
+#define LIVEBP_RECORD_OPERATION_RECEIVED(LostCount, bDuplicate) \
+	FLiveBPGlobalPerformanceMonitor::Get().RecordOperationReceived(LostCount, bDuplicate)
+
+#define LIVEBP_RECORD_OUTBOUND_FRAME(GameThreadMs, OffloadedMs) \
+	FLiveBPGlobalPerformanceMonitor::Get().RecordOutboundFrame(GameThreadMs, OffloadedMs)
+
+#define LIVEBP_RECORD_COMPRESSION(Type, RawSize, SentSize, DurationMs) \
+	FLiveBPGlobalPerformanceMonitor::Get().RecordCompression(Type, RawSize, SentSize, DurationMs)
+
+#define LIVEBP_RECORD_DECOMPRESSION(Type, DurationMs) \
+	FLiveBPGlobalPerformanceMonitor::Get().RecordDecompression(Type, DurationMs)
+
 #define LIVEBP_RECORD_ERROR(ErrorType, bIsNetwork) \
 	FLiveBPGlobalPerformanceMonitor::Get().RecordError(ErrorType, bIsNetwork)
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Where a user is in a graph: their cursor and the part of the graph their panel shows.
+ * Positions are in cells of the graph snap grid (see FLiveBPPresenceEncoder::GridSize).
+ */
+struct FLiveBPPresence
+{
+	bool bHasCursor = false;                 // Off while the mouse is outside the graph panel
+	FIntPoint Cursor = FIntPoint::ZeroValue;
+	FIntRect View;                           // Max is exclusive
+};
+
+/**
+ * A peer's latest view, as the send side keeps it for culling
+ */
+struct FLiveBPRemoteView
+{
+	FGuid BlueprintId;
+	FGuid GraphId;
+	FIntRect View;
+};
+
+/**
+ * Sender side of the presence stream.
+ *
+ * Positions are quantized to the graph snap grid before anything else, and an update only goes
+ * out when the cursor or an edge of the view has moved at least the movement threshold since the
+ * last one sent, the cursor appeared or left, or the user moved to another graph. The last state
+ * is re-sent every KeepAliveInterval while nothing changes, so updates lost on the unreliable lane
+ * heal and receivers don't time an idle cursor out.
+ */
+class LIVEBPCORE_API FLiveBPPresenceEncoder
+{
+public:
+	static constexpr float GridSize = 16.0f;
+	static constexpr double KeepAliveInterval = 2.0;
+
+	FLiveBPPresenceEncoder();
+
+	static FLiveBPPresence Quantize(const FVector2D* Cursor, const FBox2D& View);
+	static FVector2D ToGraph(const FIntPoint& Cell) { return FVector2D(Cell) * GridSize; }
+	static FBox2D ToGraph(const FIntRect& View) { return FBox2D(ToGraph(View.Min), ToGraph(View.Max)); }
+
+	/**
+	 * Whether the presence has changed enough to be sent; records it as sent if so
+	 * @param MovementThreshold In graph units
+	 */
+	bool Update(const FLiveBPPresence& Presence, const FGuid& BlueprintId, const FGuid& GraphId, float MovementThreshold, double CurrentTime);
+
+	/** Whether the last sent state is due to be repeated; records it as sent if so */
+	bool ConsumeKeepAlive(double CurrentTime);
+
+	bool HasSent() const { return bHasSent; }
+	const FLiveBPPresence& GetLastSent() const { return LastSent; }
+	const FGuid& GetBlueprintId() const { return BlueprintId; }
+	const FGuid& GetGraphId() const { return GraphId; }
+
+	void Reset();
+
+	/**
+	 * Whether content within Bounds (graph units) may be visible in a peer's view of the same graph.
+	 * The view is grown by a margin so content entering it is already there when it gets scrolled in.
+	 */
+	static bool IsVisible(const FLiveBPRemoteView& RemoteView, const FGuid& InBlueprintId, const FGuid& InGraphId, const FBox2D& Bounds);
+
+private:
+	bool bHasSent;
+	double LastSendTime;
+	FLiveBPPresence LastSent;
+	FGuid BlueprintId;
+	FGuid GraphId;
+};
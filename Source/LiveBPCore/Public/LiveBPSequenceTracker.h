@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LiveBPDataTypes.h"
+
+/**
+ * Sequence numbers for the unreliable lane.
+ *
+ * Each stream (message type + Blueprint) has its own counter, and the sender keeps one tracker
+ * per peer and only numbers a message for the peers it goes to. A receiver that is only routed
+ * one Blueprint's previews, or is paced or culled out of some, still sees a contiguous sequence,
+ * so gaps really are losses.
+ * Messages on the lane are latest-wins, so anything at or behind the last accepted number is
+ * superseded and dropped. Zero is never used and means "not sequenced" on the wire.
+ */
+class LIVEBPCORE_API FLiveBPSequenceTracker
+{
+public:
+	enum class EAcceptResult : uint8
+	{
+		Accepted,
+		Superseded // Out of order, duplicated or older than what was already applied
+	};
+
+	/** Sender side: the next number for a stream */
+	uint32 Next(ELiveBPMessageType MessageType, const FGuid& BlueprintId);
+
+	/**
+	 * Receiver side: checks a number against the last one accepted on the stream
+	 * @param OutLostCount Numbers skipped since the last accepted message (0 if superseded)
+	 */
+	EAcceptResult Accept(ELiveBPMessageType MessageType, const FGuid& BlueprintId, uint32 Sequence, int32& OutLostCount);
+
+	void Reset() { Streams.Reset(); }
+
+private:
+	TMap<TTuple<ELiveBPMessageType, FGuid>, uint32> Streams;
+};
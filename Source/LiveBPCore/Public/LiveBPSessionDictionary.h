@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FLiveBPBinaryWriter;
+class FLiveBPBinaryReader;
+
+/**
+ * Kinds of value that can be interned in the session dictionary.
+ * Every kind has its own handle space starting at zero.
+ */
+enum class ELiveBPNameKind : uint8
+{
+	User,
+	Blueprint,
+	Graph,
+	Pin,
+	NodeClass,
+	Node,
+
+	Count
+};
+
+/** Blueprint, graph and node ids are interned as GUIDs, everything else as strings */
+inline bool IsGuidNameKind(ELiveBPNameKind Kind)
+{
+	return Kind == ELiveBPNameKind::Blueprint || Kind == ELiveBPNameKind::Graph || Kind == ELiveBPNameKind::Node;
+}
+
+/** Case sensitive FString keys; pin and user names must round trip exactly */
+struct FLiveBPCaseSensitiveKeyFuncs : TDefaultMapKeyFuncs<FString, uint32, false>
+{
+	static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+	static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32<TCHAR>(*Key); }
+};
+
+/**
+ * Sender side of the session dictionary.
+ * Values get a dense handle the first time they are interned, and the new definition is queued
+ * so the next outgoing frame carries it in-band ahead of the message that uses it.
+ */
+class LIVEBPCORE_API FLiveBPNameInterner
+{
+public:
+	uint32 Intern(ELiveBPNameKind Kind, const FString& Value);
+	uint32 Intern(ELiveBPNameKind Kind, const FGuid& Value);
+
+	bool HasPendingDefinitions() const { return PendingDefinitions.Num() > 0; }
+
+	/** Writes the definitions created since the last call and clears the queue */
+	void WritePendingDefinitions(FLiveBPBinaryWriter& Writer);
+
+	/** Writes every definition, for peers that joined after they were first sent */
+	void WriteSnapshot(FLiveBPBinaryWriter& Writer) const;
+
+	int32 NumDefinitions() const;
+	void Reset();
+
+private:
+	struct FDefinition
+	{
+		ELiveBPNameKind Kind;
+		uint32 Handle;
+	};
+
+	void WriteDefinition(FLiveBPBinaryWriter& Writer, const FDefinition& Definition) const;
+
+	TMap<FString, uint32, FDefaultSetAllocator, FLiveBPCaseSensitiveKeyFuncs> StringHandles[static_cast<int32>(ELiveBPNameKind::Count)];
+	TMap<FGuid, uint32> GuidHandles[static_cast<int32>(ELiveBPNameKind::Count)];
+	TArray<FString> Strings[static_cast<int32>(ELiveBPNameKind::Count)];
+	TArray<FGuid> Guids[static_cast<int32>(ELiveBPNameKind::Count)];
+	TArray<FDefinition> PendingDefinitions;
+};
+
+/**
+ * Receiver side of the session dictionary, one per remote sender.
+ * Handles index straight into per-kind arrays, so resolving is O(1).
+ */
+class LIVEBPCORE_API FLiveBPNameTable
+{
+public:
+	/**
+	 * Reads a definitions block written by FLiveBPNameInterner
+	 * @return false if the block is malformed or redefines an existing handle with a different value
+	 */
+	bool ReadDefinitions(FLiveBPBinaryReader& Reader);
+
+	const FString* FindString(ELiveBPNameKind Kind, uint64 Handle) const;
+	const FGuid* FindGuid(ELiveBPNameKind Kind, uint64 Handle) const;
+
+	int32 NumDefinitions() const;
+
+private:
+	TArray<FString> Strings[static_cast<int32>(ELiveBPNameKind::Count)];
+	TArray<FGuid> Guids[static_cast<int32>(ELiveBPNameKind::Count)];
+};
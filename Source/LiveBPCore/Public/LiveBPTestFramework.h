@@ -53,6 +53,137 @@ public:
 	 */
 	bool TestMessageSerialization();
 
+	/**
+	 * Test the binary node operation / lock codec, including malformed input
+	 * @return true if all codec tests pass
+	 */
+	bool TestBinaryCodec();
+
+	/**
+	 * Test session dictionary interning, frame envelopes and late joiner snapshots
+	 * @return true if all dictionary tests pass
+	 */
+	bool TestSessionDictionary();
+
+	/**
+	 * Test the delta-quantized wire preview stream (anchor, deltas, re-keying, suppression)
+	 * @return true if all stream tests pass
+	 */
+	bool TestWirePreviewStream();
+
+	/**
+	 * Test outbound batching (per-destination packing, ordering and flush policy)
+	 * @return true if all batching tests pass
+	 */
+	bool TestOutboundBatching();
+
+	/**
+	 * Test threshold-based payload compression in frames
+	 * @return true if all compression tests pass
+	 */
+	bool TestPayloadCompression();
+
+	/**
+	 * Test interest-managed routing tables and the interest set / definitions frames they rely on
+	 * @return true if all routing tests pass
+	 */
+	bool TestInterestRouting();
+
+	/**
+	 * Test the unreliable lane: lane-separated batches, frames sequenced per peer and stale-update rejection
+	 * @return true if all unreliable lane tests pass
+	 */
+	bool TestUnreliableLane();
+
+	/**
+	 * Test the strict-priority outbound queue (class order, bounded depth and coalescing)
+	 * @return true if all scheduler tests pass
+	 */
+	bool TestOutboundScheduler();
+
+	/**
+	 * Test the outbound worker: commands processed off the game thread come back as routed batches
+	 * @return true if the worker produces the same batches threaded and inline
+	 */
+	bool TestOutboundWorker();
+
+	/**
+	 * Test the inbound pipeline: batches decoded, validated and resolved on workers come back typed and in order,
+	 * and a frame naming handles not defined yet is skipped without the rest of its batch
+	 * @return true if all inbound pipeline tests pass
+	 */
+	bool TestInboundPipeline();
+
+	/**
+	 * Test the remote apply scheduler: budgeted draining in priority order with the remainder carried over
+	 * @return true if all apply scheduler tests pass
+	 */
+	bool TestApplyScheduler();
+
+	/**
+	 * Test the per-peer send rate controller against simulated links (clean, lossy, congested queue, fixed rate, late frames)
+	 * @return true if rates rise, fall and stay within bounds as expected
+	 */
+	bool TestCongestionControl();
+
+	/**
+	 * Test the remote motion jitter buffer: interpolation, capped extrapolation and late samples picking up without a jump
+	 * @return true if all interpolation tests pass
+	 */
+	bool TestInterpolationBuffer();
+
+	/**
+	 * Test the presence stream: grid quantization, threshold suppression, keep-alives, the wire format and view culling
+	 * @return true if all presence tests pass
+	 */
+	bool TestPresence();
+
+	/**
+	 * Test node move coalescing: last write wins per node, one group per graph, handle encoding and apply scheduling
+	 * @return true if all node move tests pass
+	 */
+	bool TestNodeMoveCoalescing();
+
+	/**
+	 * Test node transactions: one editor action's operations sent as one message, in order, and scheduled as one apply
+	 * @return true if all node transaction tests pass
+	 */
+	bool TestNodeTransaction();
+
+	/**
+	 * Test the operation log: resent edits dropped as duplicates, late ones accepted once, and gaps reported
+	 * @return true if all operation log tests pass
+	 */
+	bool TestOperationLog();
+
+	/**
+	 * Test the lock indices: locks listed by holder, Blueprint and graph, and released in bulk through them
+	 * @return true if all lock index tests pass
+	 */
+	bool TestLockIndices();
+
+	/**
+	 * Test lock sets: all-or-nothing acquisition in ascending id order, concurrent sets (and a set
+	 * against an overlapping single lock) settling alike on every client in any arrival order, and the lock
+	 * set payload round trip
+	 * @return true if all lock set tests pass
+	 */
+	bool TestLockSets();
+
+	/**
+	 * Count heap allocations for streamed wire previews through the outbound worker and inbound pipeline
+	 * @param Messages Number of steady-state messages to measure after warming up
+	 * @return true if no message allocated once pools, slots, batches and arenas were warm
+	 */
+	bool TestSteadyStateAllocations(int32 Messages = 1000);
+
+	/**
+	 * Compare payload size and encode/decode throughput of the binary codec against JSON
+	 * @param Iterations Number of encode/decode round trips per format
+	 * @return true if the binary codec is smaller than JSON for every operation
+	 */
+	bool BenchmarkBinaryCodec(int32 Iterations = 10000);
+
 	/**
 	 * Test message throttling system
 	 * @return true if throttling tests pass
@@ -140,7 +271,7 @@ private:
 	
 	// Locking test helpers
 	bool TestBasicLocking();
-	bool TestLockExpiry();
+	bool TestLockExpiry(); // Due locks expire on update, waiting users are granted in order, repeats are ignored
 	bool TestConflictingLocks();
 	bool TestLockHierarchy();
 	
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "LiveBPDataTypes.h"
 
+struct FLiveBPMessageView;
+
 /**
  * Utility functions for Live Blueprint collaboration
  */
@@ -12,15 +14,20 @@ public:
 	// Message serialization helpers
 	static TArray<uint8> SerializeToJson(const FLiveBPNodeOperationData& NodeOperation);
 	static TArray<uint8> SerializeToJson(const FLiveBPNodeLock& NodeLock);
-	static bool DeserializeFromJson(const TArray<uint8>& Data, FLiveBPNodeOperationData& OutNodeOperation);
-	static bool DeserializeFromJson(const TArray<uint8>& Data, FLiveBPNodeLock& OutNodeLock);
+	static bool DeserializeFromJson(TArrayView<const uint8> Data, FLiveBPNodeOperationData& OutNodeOperation);
+	static bool DeserializeFromJson(TArrayView<const uint8> Data, FLiveBPNodeLock& OutNodeLock);
+
+	// Payload decoding that accepts both the binary codec and debug JSON
+	static bool DeserializeNodeOperation(TArrayView<const uint8> Data, FLiveBPNodeOperationData& OutNodeOperation, const FLiveBPNameTable* Names = nullptr);
+	static bool DeserializeNodeLock(TArrayView<const uint8> Data, FLiveBPNodeLock& OutNodeLock, const FLiveBPNameTable* Names = nullptr);
 
 	// Binary serialization for wire previews
 	static TArray<uint8> SerializeToBinary(const FLiveBPWirePreview& WirePreview);
-	static bool DeserializeFromBinary(const TArray<uint8>& Data, FLiveBPWirePreview& OutWirePreview);
+	static bool DeserializeFromBinary(TArrayView<const uint8> Data, FLiveBPWirePreview& OutWirePreview, const FLiveBPNameTable* Names = nullptr);
 
 	// Validation helpers
 	static bool IsValidMessage(const FLiveBPMessage& Message);
+	static bool IsValidMessage(const FLiveBPMessageView& Message);
 	static bool IsValidNodeOperation(const FLiveBPNodeOperationData& NodeOperation);
 	static bool IsValidWirePreview(const FLiveBPWirePreview& WirePreview);
 	static bool IsValidNodeLock(const FLiveBPNodeLock& NodeLock);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LiveBPDataTypes.h"
+#include "LiveBPBinaryCodec.h"
+
+/**
+ * Sender side of a wire preview stream.
+ *
+ * The anchor (node, pin, start position) is sent once when the drag begins. After that each
+ * update carries only the end position, quantized to whole graph units, as an int16 offset from
+ * the current keyframe. Keyframes are the Begin packet and any re-anchoring packet sent when an
+ * offset no longer fits in int16. They always go out on the reliable channel, so deltas are
+ * relative to a position the receiver is known to have, and a lost delta never corrupts later ones.
+ */
+class LIVEBPCORE_API FLiveBPWirePreviewEncoder
+{
+public:
+	enum class EUpdateResult : uint8
+	{
+		Suppressed, // Below the movement threshold, nothing written
+		Delta,
+		Keyframe
+	};
+
+	FLiveBPWirePreviewEncoder();
+
+	void Begin(const FLiveBPWirePreview& WirePreview, FLiveBPBinaryWriter& Writer);
+	EUpdateResult Update(const FVector2D& EndPosition, float MinimumMovement, FLiveBPBinaryWriter& Writer);
+	void End(FLiveBPBinaryWriter& Writer);
+
+	bool IsActive() const { return bActive; }
+
+private:
+	bool bActive;
+	uint8 KeyframeId;
+	FIntPoint KeyframeEnd;
+	FIntPoint LastSentEnd;
+	FVector2D LastSentPosition;
+};
+
+/**
+ * Receiver side of a wire preview stream, one per remote user.
+ * The reconstructed preview lives in the decoder and is updated in place, so applying a delta
+ * does not copy the pin name or user id.
+ */
+class LIVEBPCORE_API FLiveBPWirePreviewDecoder
+{
+public:
+	enum class EApplyResult : uint8
+	{
+		Invalid, // Malformed payload
+		Stale,   // Delta for a keyframe we don't have (or no active stream)
+		Updated,
+		Ended
+	};
+
+	FLiveBPWirePreviewDecoder();
+
+	/** Applies one stream packet; on Updated or Ended, GetWirePreview() holds the full preview */
+	EApplyResult Apply(TArrayView<const uint8> Payload, const FLiveBPNameTable* Names);
+
+	const FLiveBPWirePreview& GetWirePreview() const { return Current; }
+
+	/** User id stamped on the reconstructed preview */
+	void SetUserId(const FString& InUserId) { Current.UserId = InUserId; }
+
+	bool IsActive() const { return bActive; }
+	void Reset();
+
+private:
+	bool bActive;
+	uint8 KeyframeId;
+	FIntPoint KeyframeEnd;
+	FLiveBPWirePreview Current;
+};
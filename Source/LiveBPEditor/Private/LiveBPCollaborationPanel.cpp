@@ -190,6 +190,52 @@ void SLiveBPCollaborationPanel::Construct(const FArguments& InArgs)
 						.Font(FCoreStyle::GetDefaultFontStyle("Bold", 10))
 					]
 				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0, 5, 0, 0)
+				[
+					SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					[
+						SNew(STextBlock)
+						.Text(FText::FromString(TEXT("Preview Send Rate: ")))
+						.Font(FCoreStyle::GetDefaultFontStyle("Regular", 10))
+					]
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					.Padding(5, 0)
+					.VAlign(VAlign_Center)
+					[
+						SAssignNew(SendRateText, STextBlock)
+						.Text(FText::FromString(TEXT("-")))
+						.Font(FCoreStyle::GetDefaultFontStyle("Bold", 10))
+					]
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0, 5, 0, 0)
+				[
+					SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					.VAlign(VAlign_Center)
+					[
+						SNew(STextBlock)
+						.Text(FText::FromString(TEXT("Remote Playout Delay: ")))
+						.Font(FCoreStyle::GetDefaultFontStyle("Regular", 10))
+					]
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					.Padding(5, 0)
+					.VAlign(VAlign_Center)
+					[
+						SAssignNew(PlayoutDelayText, STextBlock)
+						.Text(FText::FromString(TEXT("-")))
+						.Font(FCoreStyle::GetDefaultFontStyle("Bold", 10))
+					]
+				]
 			]
 		]
 		
@@ -587,6 +633,50 @@ void SLiveBPCollaborationPanel::UpdateSessionStatistics()
 									(LatencyMs > 50.0f ? FLinearColor::Yellow : FLinearColor::Green);
 		NetworkLatencyBar->SetFillColorAndOpacity(LatencyColor);
 	}
+	
+	// Update preview send rate; each peer gets its own, adapted to its link
+	ULiveBPMUEIntegration* Integration = EditorSubsystem.IsValid() ? EditorSubsystem->GetMUEIntegration() : nullptr;
+	float SlowestRateHz = 0.0f;
+	if (SendRateText.IsValid() && Integration)
+	{
+		TMap<FGuid, FLiveBPPeerSendRate> PeerRates;
+		Integration->GetPeerSendRates(PeerRates);
+		
+		const FLiveBPPeerSendRate* Slowest = nullptr;
+		float MaxRate = 0.0f;
+		for (const auto& Pair : PeerRates)
+		{
+			if (!Slowest || Pair.Value.RateHz < Slowest->RateHz)
+			{
+				Slowest = &Pair.Value;
+			}
+			MaxRate = FMath::Max(MaxRate, Pair.Value.RateHz);
+		}
+		
+		FString RateString = TEXT("-");
+		if (Slowest)
+		{
+			SlowestRateHz = Slowest->RateHz;
+			RateString = FMath::IsNearlyEqual(Slowest->RateHz, MaxRate, 0.5f)
+				? FString::Printf(TEXT("%.0f Hz"), MaxRate)
+				: FString::Printf(TEXT("%.0f-%.0f Hz"), Slowest->RateHz, MaxRate);
+			RateString += FString::Printf(TEXT(" (slowest peer: %.0fms RTT, %.0f%% loss)"), Slowest->SmoothedRttMs, Slowest->LossRate * 100.0f);
+		}
+		SendRateText->SetText(FText::FromString(RateString));
+	}
+	
+	// Update remote playout delay; peers sending less often than it spend part of the time extrapolated.
+	// Our own rate to the slowest peer stands in for theirs, since links are mostly symmetric.
+	const ULiveBPSettings* Settings = GetDefault<ULiveBPSettings>();
+	if (PlayoutDelayText.IsValid() && Settings)
+	{
+		const float RateHz = SlowestRateHz > 0.0f ? SlowestRateHz : static_cast<float>(Settings->WirePreviewUpdateRate);
+		const float SendIntervalMs = 1000.0f / FMath::Max(RateHz, 1.0f);
+		
+		PlayoutDelayText->SetText(FText::FromString(FString::Printf(TEXT("%.0fms (extrapolating up to %.0fms)"),
+			Settings->RemotePlayoutDelayMs, Settings->MaxExtrapolationMs)));
+		PlayoutDelayText->SetColorAndOpacity(Settings->RemotePlayoutDelayMs >= SendIntervalMs ? FLinearColor::Green : FLinearColor::Yellow);
+	}
 }
 
 FString SLiveBPCollaborationPanel::FormatDuration(float Seconds) const
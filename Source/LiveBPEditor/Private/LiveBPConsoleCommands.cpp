@@ -8,6 +8,7 @@
 #include "LiveBPPerformanceMonitor.h"
 #include "LiveBPMUEIntegration.h"
 #include "LiveBPLockManager.h"
+#include "LiveBPSettings.h"
 #include "Engine/Engine.h"
 #include "HAL/IConsoleManager.h"
 
@@ -106,6 +107,12 @@ void FLiveBPConsoleCommands::ShowStats(const TArray<FString>& Args)
 		UE_LOG(LogLiveBPEditor, Log, TEXT("Current User: %s"), *CurrentUserId);
 		UE_LOG(LogLiveBPEditor, Log, TEXT("Connected Users: %d"), ConnectedUsers.Num());
 		UE_LOG(LogLiveBPEditor, Log, TEXT("Debug Mode: %s"), EditorSubsystem->IsDebugModeEnabled() ? TEXT("ENABLED") : TEXT("DISABLED"));
+		UE_LOG(LogLiveBPEditor, Log, TEXT("Preview Send Rate: %.1f Hz"), MUEIntegration->GetEphemeralSendRate());
+		if (const ULiveBPSettings* Settings = GetDefault<ULiveBPSettings>())
+		{
+			UE_LOG(LogLiveBPEditor, Log, TEXT("Remote Playout Delay: %.0f ms (extrapolating up to %.0f ms)"),
+				Settings->RemotePlayoutDelayMs, Settings->MaxExtrapolationMs);
+		}
 		
 		// Print connected users
 		for (const FString& User : ConnectedUsers)
@@ -165,14 +172,16 @@ void FLiveBPConsoleCommands::ClearLocks(const TArray<FString>& Args)
 		return;
 	}
 
-	// Clear all locks - this accesses the private NodeLocks map through a public method we need to add
-	UE_LOG(LogLiveBPEditor, Warning, TEXT("Clear locks functionality requires additional implementation"));
-	UE_LOG(LogLiveBPEditor, Log, TEXT("Use Blueprint Editor to manually release locks"));
+	ULiveBPLockManager* LockManager = EditorSubsystem->GetLockManager();
+	const int32 LockCount = LockManager->Num();
+	LockManager->ClearAllLocks();
+
+	UE_LOG(LogLiveBPEditor, Log, TEXT("Cleared %d node locks"), LockCount);
 	
 	if (GEngine)
 	{
 		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, 
-			TEXT("Clear locks feature pending implementation"));
+			FString::Printf(TEXT("Cleared %d node locks"), LockCount));
 	}
 }
 
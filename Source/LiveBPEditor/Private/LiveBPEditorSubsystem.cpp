@@ -1,5 +1,8 @@
 #include "LiveBPEditorSubsystem.h"
 #include "LiveBPEditor.h"
+#include "LiveBPSettings.h"
+#include "LiveBPUtils.h"
+#include "LiveBPPerformanceMonitor.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "BlueprintEditorModule.h"
 #include "Framework/Notifications/NotificationManager.h"
@@ -22,11 +25,18 @@
 #include "HAL/PlatformFileManager.h"
 #include "Misc/Paths.h"
 #include "EditorSubsystemBlueprintLibrary.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/App.h"
+#include "ScopedTransaction.h"
 
 ULiveBPEditorSubsystem::ULiveBPEditorSubsystem()
 	: bCollaborationEnabled(false)
 	, bDebugModeEnabled(false)
-	, LastWirePreviewTime(0.0f)
+	, LastWirePreviewTime(0.0)
+	, PendingWirePreviewPosition(FVector2D::ZeroVector)
+	, bHasPendingWirePreview(false)
+	, LastPresenceTime(0.0)
+	, bHasPendingPresence(false)
 {
 }
 
@@ -38,19 +48,28 @@ void ULiveBPEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	// Create core components
 	MUEIntegration = NewObject<ULiveBPMUEIntegration>(this);
+	LockManager = NewObject<ULiveBPLockManager>(this);
 
 	// Bind delegates
-	MUEIntegration->OnMessageReceived.AddUObject(this, &ULiveBPEditorSubsystem::OnMUEMessageReceived);
+	MUEIntegration->OnInboundMessage.AddUObject(this, &ULiveBPEditorSubsystem::OnMUEMessageReceived);
+	MUEIntegration->OnUserLeft.AddUObject(this, &ULiveBPEditorSubsystem::OnUserLeft);
 
+	ApplyTransportSettings();
 	RegisterBlueprintCallbacks();
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &ULiveBPEditorSubsystem::OnEndFrame);
 }
 
 void ULiveBPEditorSubsystem::Deinitialize()
 {
 	UE_LOG(LogLiveBPEditor, Log, TEXT("Deinitializing LiveBP Editor Subsystem"));
 
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+
 	DisableCollaboration();
 	UnregisterBlueprintCallbacks();
+	GraphIndices.Empty();
 
 	if (MUEIntegration)
 	{
@@ -89,6 +108,7 @@ void ULiveBPEditorSubsystem::EnableCollaboration()
 	}
 
 	bCollaborationEnabled = true;
+	PublishInterest();
 	ShowCollaborationNotification(TEXT("LiveBP collaboration enabled"), 3.0f);
 }
 
@@ -104,90 +124,99 @@ void ULiveBPEditorSubsystem::DisableCollaboration()
 	bCollaborationEnabled = false;
 	
 	// Release all node locks
-	NodeLocks.Empty();
+	LockManager->ClearAllLocks();
+
+	// Operations still queued belong to a session we no longer follow
+	RemoteOperations.Reset();
+	UpdateRemoteApplyProgress();
+	bHasPendingPresence = false;
+
+	// We no longer show anything, so stop peers from sending us previews
+	PublishInterest();
 	
 	ShowCollaborationNotification(TEXT("LiveBP collaboration disabled"), 3.0f);
 }
 
 bool ULiveBPEditorSubsystem::RequestNodeLock(UEdGraphNode* Node, float LockDuration)
 {
-	if (!IsCollaborationEnabled() || !Node)
+	if (!Node)
 	{
 		return false;
 	}
 
-	FGuid NodeId = GetNodeGuid(Node);
-	UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
-	if (!Blueprint)
+	// A set of one, so it is settled against concurrent selections the same way on every client
+	UEdGraphNode* const Nodes[] = { Node };
+	return RequestNodeLocks(Nodes, LockDuration).Granted.Num() > 0;
+}
+
+bool ULiveBPEditorSubsystem::ReleaseNodeLock(UEdGraphNode* Node)
+{
+	if (!Node)
 	{
 		return false;
 	}
 
-	// Check if node is already locked by someone else
-	if (IsNodeLockedByOther(Node))
+	UEdGraphNode* const Nodes[] = { Node };
+	return ReleaseNodeLocks(Nodes);
+}
+
+FLiveBPLockSetResult ULiveBPEditorSubsystem::RequestNodeLocks(TArrayView<UEdGraphNode* const> Nodes, float LockDuration)
+{
+	FLiveBPNodeLockSet LockSet;
+	FGuid BlueprintId;
+	FGuid GraphId;
+	if (!IsCollaborationEnabled() || !GetLockSetScope(Nodes, LockSet, BlueprintId, GraphId))
 	{
-		ShowCollaborationNotification(FString::Printf(TEXT("Node is locked by another user")), 3.0f);
-		return false;
+		return FLiveBPLockSetResult();
 	}
 
-	// Create lock request
-	FLiveBPNodeLock LockRequest;
-	LockRequest.NodeId = NodeId;
-	LockRequest.LockState = ELiveBPLockState::Locked;
-	LockRequest.UserId = MUEIntegration->GetCurrentUserId();
-	LockRequest.LockTime = FPlatformTime::Seconds();
-	LockRequest.ExpiryTime = LockRequest.LockTime + LockDuration;
+	FLiveBPLockSetResult Result = LockManager->RequestLocks(LockSet.NodeIds, LockSet.UserId, LockDuration, BlueprintId, GraphId);
+	if (!Result.IsGranted())
+	{
+		ShowCollaborationNotification(FString::Printf(TEXT("%d of the selected nodes are locked by another user"), Result.Conflicts.Num()), 3.0f);
+		return Result;
+	}
 
-	// Send lock request
-	FGuid BlueprintId = GetBlueprintGuid(Blueprint);
-	FGuid GraphId = GetGraphGuid(Node->GetGraph());
-	
-	if (MUEIntegration->SendLockRequest(LockRequest, BlueprintId, GraphId))
+	// The granted set is in the order every client takes the locks in
+	LockSet.NodeIds = Result.Granted;
+	LockSet.LockState = ELiveBPLockState::Locked;
+	LockSet.Duration = LockDuration;
+	if (!MUEIntegration->SendLockSet(LockSet, BlueprintId, GraphId))
 	{
-		// Store lock locally
-		NodeLocks.Add(NodeId, LockRequest);
-		UpdateNodeVisualState(Node);
-		return true;
+		LockManager->ReleaseLocks(LockSet.NodeIds, LockSet.UserId);
+		return FLiveBPLockSetResult();
 	}
 
-	return false;
+	for (UEdGraphNode* Node : Nodes)
+	{
+		UpdateNodeVisualState(Node);
+	}
+	return Result;
 }
 
-bool ULiveBPEditorSubsystem::ReleaseNodeLock(UEdGraphNode* Node)
+bool ULiveBPEditorSubsystem::ReleaseNodeLocks(TArrayView<UEdGraphNode* const> Nodes)
 {
-	if (!IsCollaborationEnabled() || !Node)
+	FLiveBPNodeLockSet LockSet;
+	FGuid BlueprintId;
+	FGuid GraphId;
+	if (!IsCollaborationEnabled() || !GetLockSetScope(Nodes, LockSet, BlueprintId, GraphId))
 	{
 		return false;
 	}
 
-	FGuid NodeId = GetNodeGuid(Node);
-	
-	// Check if we have this node locked
-	if (FLiveBPNodeLock* ExistingLock = NodeLocks.Find(NodeId))
+	// Only the nodes we hold
+	LockSet.NodeIds.RemoveAll([this, &LockSet](const FGuid& NodeId) { return !LockManager->IsLockedByUser(NodeId, LockSet.UserId); });
+	if (LockSet.NodeIds.Num() == 0 || !MUEIntegration->SendLockSet(LockSet, BlueprintId, GraphId))
 	{
-		if (ExistingLock->UserId == MUEIntegration->GetCurrentUserId())
-		{
-			// Create unlock request
-			FLiveBPNodeLock UnlockRequest = *ExistingLock;
-			UnlockRequest.LockState = ELiveBPLockState::Unlocked;
-			
-			UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
-			if (Blueprint)
-			{
-				FGuid BlueprintId = GetBlueprintGuid(Blueprint);
-				FGuid GraphId = GetGraphGuid(Node->GetGraph());
-				
-				if (MUEIntegration->SendLockRequest(UnlockRequest, BlueprintId, GraphId))
-				{
-					NodeLocks.Remove(NodeId);
-					UpdateNodeVisualState(Node);
-					return true;
-				}
-			}
-		}
+		return false;
 	}
 
-	return false;
+	LockManager->ReleaseLocks(LockSet.NodeIds, LockSet.UserId);
+	for (UEdGraphNode* Node : Nodes)
+	{
+		UpdateNodeVisualState(Node);
+	}
+	return true;
 }
 
 bool ULiveBPEditorSubsystem::IsNodeLockedByOther(UEdGraphNode* Node) const
@@ -198,14 +227,7 @@ bool ULiveBPEditorSubsystem::IsNodeLockedByOther(UEdGraphNode* Node) const
 	}
 
 	FGuid NodeId = GetNodeGuid(Node);
-	if (const FLiveBPNodeLock* Lock = NodeLocks.Find(NodeId))
-	{
-		return Lock->LockState == ELiveBPLockState::Locked && 
-			   Lock->UserId != MUEIntegration->GetCurrentUserId() &&
-			   FPlatformTime::Seconds() < Lock->ExpiryTime;
-	}
-
-	return false;
+	return LockManager->IsLocked(NodeId) && !LockManager->IsLockedByUser(NodeId, MUEIntegration->GetCurrentUserId());
 }
 
 bool ULiveBPEditorSubsystem::CanModifyNode(UEdGraphNode* Node) const
@@ -224,12 +246,24 @@ void ULiveBPEditorSubsystem::RegisterBlueprintCallbacks()
 	// Register for asset editor events
 	FAssetEditorManager::Get().OnAssetOpenedInEditor().AddUObject(this, &ULiveBPEditorSubsystem::OnAssetOpened);
 	FAssetEditorManager::Get().OnAssetEditorRequestClose().AddUObject(this, &ULiveBPEditorSubsystem::OnAssetClosed);
+	FCoreUObjectDelegates::OnObjectRenamed.AddUObject(this, &ULiveBPEditorSubsystem::OnObjectRenamed);
 }
 
 void ULiveBPEditorSubsystem::UnregisterBlueprintCallbacks()
 {
 	FAssetEditorManager::Get().OnAssetOpenedInEditor().RemoveAll(this);
 	FAssetEditorManager::Get().OnAssetEditorRequestClose().RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectRenamed.RemoveAll(this);
+
+	for (const auto& Pair : TrackedGraphEditors)
+	{
+		if (UBlueprint* Blueprint = Pair.Key)
+		{
+			Blueprint->OnChanged().RemoveAll(this);
+		}
+	}
+	Identities.Reset();
+	GraphRegistries.Empty();
 
 	// Unregister all Blueprint-specific callbacks
 	for (auto& Pair : BlueprintDelegateHandles)
@@ -251,11 +285,19 @@ void ULiveBPEditorSubsystem::OnAssetOpened(UObject* Asset, IAssetEditorInstance*
 		// Store Blueprint GUID mapping
 		FGuid BlueprintId = GetBlueprintGuid(Blueprint);
 		BlueprintGuidMap.Add(BlueprintId, Blueprint);
+		PublishResolvableBlueprints();
+		TrackedGraphEditors.FindOrAdd(Blueprint);
+		GetGraphRegistry(Blueprint);
+		if (!Blueprint->OnChanged().IsBoundToObject(this))
+		{
+			Blueprint->OnChanged().AddUObject(this, &ULiveBPEditorSubsystem::OnBlueprintChanged);
+		}
 		
 		// Register for Blueprint-specific events if collaboration is enabled
 		if (IsCollaborationEnabled())
 		{
 			RegisterGraphEditorCallbacks(Blueprint);
+			PublishInterest();
 		}
 	}
 }
@@ -274,27 +316,80 @@ void ULiveBPEditorSubsystem::OnAssetClosed(UObject* Asset, IAssetEditorInstance*
 		// Remove from GUID mapping
 		FGuid BlueprintId = GetBlueprintGuid(Blueprint);
 		BlueprintGuidMap.Remove(BlueprintId);
+		PublishResolvableBlueprints();
+
+		if (IsCollaborationEnabled())
+		{
+			PublishInterest();
+		}
 		
 		// Release any locks on nodes in this Blueprint
-		TArray<FGuid> LocksToRemove;
-		for (const auto& LockPair : NodeLocks)
+		LockManager->ClearBlueprintLocks(BlueprintId);
+
+		TArray<UEdGraph*> Graphs;
+		GetGraphRegistry(Blueprint).GetGraphs(Graphs);
+		for (UEdGraph* Graph : Graphs)
 		{
-			// Check if this lock belongs to a node in the closing Blueprint
-			for (UEdGraph* Graph : Blueprint->UbergraphPages)
-			{
-				if (FindNodeByGuid(Graph, LockPair.Key))
-				{
-					LocksToRemove.Add(LockPair.Key);
-					break;
-				}
-			}
+			GraphIndices.Remove(Graph);
 		}
-		
-		for (const FGuid& LockId : LocksToRemove)
+
+		GraphRegistries.Remove(Blueprint);
+		Blueprint->OnChanged().RemoveAll(this);
+		Identities.RemoveWithin(Blueprint);
+	}
+}
+
+void ULiveBPEditorSubsystem::OnBlueprintChanged(UBlueprint* Blueprint)
+{
+	// Graphs may have been added, removed or renamed, or the Blueprint reparented; ids are recomputed on next use
+	Identities.RemoveWithin(Blueprint);
+	if (FLiveBPGraphRegistry* Registry = GraphRegistries.Find(Blueprint))
+	{
+		Registry->Invalidate();
+	}
+}
+
+void ULiveBPEditorSubsystem::OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+	if (!Object->IsA<UBlueprint>() && !Object->IsA<UEdGraph>() && !Object->IsA<UEdGraphNode>())
+	{
+		return;
+	}
+
+	Identities.RemoveWithin(Object);
+
+	// Graph ids are derived from the graph's and its Blueprint's names
+	UBlueprint* Owner = Cast<UBlueprint>(Object);
+	if (UEdGraph* Graph = Cast<UEdGraph>(Object))
+	{
+		Owner = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+	}
+	if (FLiveBPGraphRegistry* Registry = Owner ? GraphRegistries.Find(Owner) : nullptr)
+	{
+		Registry->Invalidate();
+	}
+
+	// An open Blueprint that was renamed is known to peers by its new id from now on
+	UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+	if (!Blueprint || !TrackedGraphEditors.Contains(Blueprint))
+	{
+		return;
+	}
+
+	for (auto It = BlueprintGuidMap.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == Blueprint)
 		{
-			NodeLocks.Remove(LockId);
+			It.RemoveCurrent();
 		}
 	}
+	BlueprintGuidMap.Add(GetBlueprintGuid(Blueprint), Blueprint);
+	PublishResolvableBlueprints();
+
+	if (IsCollaborationEnabled())
+	{
+		PublishInterest();
+	}
 }
 
 void ULiveBPEditorSubsystem::OnBlueprintPreCompile(UBlueprint* Blueprint)
@@ -384,8 +479,7 @@ void ULiveBPEditorSubsystem::OnNodeRemoved(UEdGraphNode* Node)
 	MUEIntegration->SendNodeOperation(NodeOp, BlueprintId, GraphId);
 	
 	// Remove any locks for this node
-	FGuid NodeId = GetNodeGuid(Node);
-	NodeLocks.Remove(NodeId);
+	LockManager->ClearNodeLock(NodeOp.NodeId);
 }
 
 void ULiveBPEditorSubsystem::OnNodeMoved(UEdGraphNode* Node)
@@ -401,18 +495,9 @@ void ULiveBPEditorSubsystem::OnNodeMoved(UEdGraphNode* Node)
 		return;
 	}
 
-	// Create node operation data
-	FLiveBPNodeOperationData NodeOp;
-	NodeOp.Operation = ELiveBPNodeOperation::Move;
-	NodeOp.NodeId = GetNodeGuid(Node);
-	NodeOp.Position = FVector2D(Node->NodePosX, Node->NodePosY);
-	NodeOp.UserId = MUEIntegration->GetCurrentUserId();
-	NodeOp.Timestamp = FPlatformTime::Seconds();
-
-	// Send to other clients
-	FGuid BlueprintId = GetBlueprintGuid(Blueprint);
-	FGuid GraphId = GetGraphGuid(Node->GetGraph());
-	MUEIntegration->SendNodeOperation(NodeOp, BlueprintId, GraphId);
+	// Dragging a selection reports every node each frame; the transport sends one coalesced move per graph per tick
+	MUEIntegration->SendNodeMove(GetNodeGuid(Node), FIntPoint(Node->NodePosX, Node->NodePosY),
+		GetBlueprintGuid(Blueprint), GetGraphGuid(Node->GetGraph()));
 }
 
 void ULiveBPEditorSubsystem::OnPinConnected(UEdGraphPin* OutputPin, UEdGraphPin* InputPin)
@@ -486,44 +571,209 @@ void ULiveBPEditorSubsystem::OnPinDisconnected(UEdGraphPin* Pin)
 }
 
 // Wire preview handling
-void ULiveBPEditorSubsystem::OnWireDragStart(const TSharedRef<SGraphEditor>& GraphEditor, UEdGraphNode* Node, const FString& PinName)
+bool ULiveBPEditorSubsystem::BeginWirePreview(UEdGraphPin* StartPin, const FVector2D& StartPosition)
 {
-	// Wire drag started - we could start tracking this
+	if (!IsCollaborationEnabled() || !StartPin)
+	{
+		return false;
+	}
+
+	UEdGraphNode* Node = StartPin->GetOwningNode();
+	UBlueprint* Blueprint = Node ? FBlueprintEditorUtils::FindBlueprintForNode(Node) : nullptr;
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	FLiveBPWirePreview WirePreview;
+	WirePreview.NodeId = GetNodeGuid(Node);
+	WirePreview.PinName = StartPin->PinName.ToString();
+	WirePreview.StartPosition = StartPosition;
+	WirePreview.EndPosition = StartPosition;
+
+	LastWirePreviewTime = FPlatformTime::Seconds();
+	bHasPendingWirePreview = false;
+
+	return MUEIntegration->BeginWirePreviewStream(WirePreview, GetBlueprintGuid(Blueprint), GetGraphGuid(Node->GetGraph()));
 }
 
-void ULiveBPEditorSubsystem::OnWireDragUpdate(const TSharedRef<SGraphEditor>& GraphEditor, const FVector2D& Position)
+void ULiveBPEditorSubsystem::UpdateWirePreview(const FVector2D& EndPosition)
 {
-	if (!IsCollaborationEnabled())
+	if (!IsCollaborationEnabled() || !MUEIntegration->IsWirePreviewStreamActive())
 	{
 		return;
 	}
 
-	// Throttle wire preview updates
-	float CurrentTime = FPlatformTime::Seconds();
-	if (CurrentTime - LastWirePreviewTime < WIRE_PREVIEW_THROTTLE)
+	// Sample no faster than the fastest peer takes updates; slower peers are paced by the transport.
+	// The latest position is kept so EndWirePreview can flush it.
+	PendingWirePreviewPosition = EndPosition;
+	bHasPendingWirePreview = true;
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	const double Interval = 1.0 / MUEIntegration->GetEphemeralSendRate();
+	if (CurrentTime - LastWirePreviewTime < Interval)
 	{
 		return;
 	}
+
 	LastWirePreviewTime = CurrentTime;
+	bHasPendingWirePreview = false;
+	MUEIntegration->UpdateWirePreviewStream(EndPosition);
+}
 
-	// Create and send wire preview
-	// In a full implementation, we would get the actual drag data from the graph editor
-	FLiveBPWirePreview WirePreview;
-	WirePreview.EndPosition = Position;
-	WirePreview.UserId = MUEIntegration->GetCurrentUserId();
-	WirePreview.Timestamp = CurrentTime;
+void ULiveBPEditorSubsystem::EndWirePreview()
+{
+	if (!MUEIntegration || !MUEIntegration->IsWirePreviewStreamActive())
+	{
+		return;
+	}
+
+	if (bHasPendingWirePreview)
+	{
+		MUEIntegration->UpdateWirePreviewStream(PendingWirePreviewPosition);
+		bHasPendingWirePreview = false;
+	}
 
-	// We would need to identify the Blueprint and Graph here
-	// For now, this is a placeholder
+	MUEIntegration->EndWirePreviewStream();
 }
 
-void ULiveBPEditorSubsystem::OnWireDragEnd(const TSharedRef<SGraphEditor>& GraphEditor)
+// Presence handling
+void ULiveBPEditorSubsystem::UpdatePresence(UEdGraph* Graph, const FVector2D* Cursor, const FBox2D& View)
 {
-	// Wire drag ended
+	if (!IsCollaborationEnabled() || !Graph || !GetDefault<ULiveBPSettings>()->bBroadcastPresence)
+	{
+		return;
+	}
+
+	UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	// Only the newest state matters; it goes out once the presence interval has passed, here or at the end of the frame
+	PendingPresence = FLiveBPPresenceEncoder::Quantize(Cursor, View);
+	PendingPresenceBlueprintId = GetBlueprintGuid(Blueprint);
+	PendingPresenceGraphId = GetGraphGuid(Graph);
+	bHasPendingPresence = true;
+
+	FlushPresence(FPlatformTime::Seconds());
 }
 
-// Message handling
-void ULiveBPEditorSubsystem::OnMUEMessageReceived(const FLiveBPMessage& Message)
+void ULiveBPEditorSubsystem::FlushPresence(double CurrentTime)
+{
+	if (!bHasPendingPresence)
+	{
+		return;
+	}
+
+	// Presence is a low rate stream: never faster than its own setting, nor than the fastest peer takes previews
+	const float RateHz = FMath::Min(GetDefault<ULiveBPSettings>()->PresenceUpdateRateHz, MUEIntegration->GetEphemeralSendRate());
+	if (CurrentTime - LastPresenceTime < 1.0 / FMath::Max(RateHz, 0.1f))
+	{
+		return;
+	}
+
+	LastPresenceTime = CurrentTime;
+	bHasPendingPresence = false;
+	MUEIntegration->UpdatePresence(PendingPresence, PendingPresenceBlueprintId, PendingPresenceGraphId);
+}
+
+void ULiveBPEditorSubsystem::ApplyTransportSettings()
+{
+	if (!MUEIntegration)
+	{
+		return;
+	}
+
+	const ULiveBPSettings* Settings = GetDefault<ULiveBPSettings>();
+	MUEIntegration->SetPayloadEncoding(Settings->bUseJsonPayloadsForDebugging ? ELiveBPPayloadEncoding::Json : ELiveBPPayloadEncoding::Binary);
+	MUEIntegration->SetWirePreviewMovementThreshold(Settings->MinimumMovementThreshold);
+	MUEIntegration->SetPresenceMovementThreshold(Settings->PresenceMovementThreshold);
+
+	FLiveBPBatchPolicy BatchPolicy;
+	BatchPolicy.MaxBatchBytes = Settings->bBatchOutgoingMessages ? Settings->MaxBatchBytes : 0;
+	BatchPolicy.MaxDelaySeconds = Settings->MaxBatchDelayMs / 1000.0;
+	MUEIntegration->SetBatchPolicy(BatchPolicy);
+
+	FLiveBPCompressionPolicy CompressionPolicy;
+	CompressionPolicy.MinPayloadBytes = Settings->bCompressLargePayloads ? Settings->CompressionThresholdBytes : 0;
+	CompressionPolicy.Format = Settings->CompressionFormat;
+	MUEIntegration->SetCompressionPolicy(CompressionPolicy);
+
+	MUEIntegration->SetOutgoingQueueDepth(Settings->MaxMessageQueueSize);
+
+	FLiveBPRateBounds RateBounds;
+	RateBounds.bAdaptive = Settings->bAdaptiveSendRate;
+	RateBounds.MinRateHz = Settings->MinSendRateHz;
+	RateBounds.MaxRateHz = FMath::Max(Settings->MaxSendRateHz, Settings->MinSendRateHz);
+	RateBounds.InitialRateHz = Settings->WirePreviewUpdateRate;
+	MUEIntegration->SetSendRateBounds(RateBounds);
+	MUEIntegration->SetUseOutboundWorker(Settings->bSendOnWorkerThread);
+}
+
+void ULiveBPEditorSubsystem::OnEndFrame()
+{
+	if (!MUEIntegration)
+	{
+		return;
+	}
+
+	const double ApplyStartTime = FPlatformTime::Seconds();
+	FlushPresence(ApplyStartTime);
+	ApplyRemoteOperations();
+	LockManager->UpdateLocks(FApp::GetDeltaTime());
+	const float ApplyTimeMs = static_cast<float>((FPlatformTime::Seconds() - ApplyStartTime) * 1000.0);
+
+	FLiveBPGlobalPerformanceMonitor::Get().RecordFramePerformance(
+		FApp::GetDeltaTime() * 1000.0f, ApplyTimeMs, RemoteOperations.Num());
+
+	// Peak rather than current depth; the integration may already have drained the queue this frame
+	FLiveBPGlobalPerformanceMonitor::Get().UpdateMemoryStats(
+		MUEIntegration->ConsumePeakOutgoingQueueDepth(), LockManager->Num(), MUEIntegration->GetConnectedUserCount());
+}
+
+void ULiveBPEditorSubsystem::PublishInterest()
+{
+	if (!MUEIntegration)
+	{
+		return;
+	}
+
+	TArray<FGuid> OpenBlueprints;
+	if (IsCollaborationEnabled())
+	{
+		for (const auto& Pair : TrackedGraphEditors)
+		{
+			if (Pair.Key)
+			{
+				OpenBlueprints.Add(GetBlueprintGuid(Pair.Key));
+			}
+		}
+	}
+
+	MUEIntegration->SetLocalInterest(OpenBlueprints);
+}
+
+void ULiveBPEditorSubsystem::PublishResolvableBlueprints()
+{
+	if (!MUEIntegration)
+	{
+		return;
+	}
+
+	TMap<FGuid, TWeakObjectPtr<UObject>> Blueprints;
+	Blueprints.Reserve(BlueprintGuidMap.Num());
+	for (const auto& Pair : BlueprintGuidMap)
+	{
+		Blueprints.Add(Pair.Key, Pair.Value);
+	}
+
+	MUEIntegration->SetResolvableBlueprints(MoveTemp(Blueprints));
+}
+
+// Message handling. Messages arrive decoded and with their Blueprint resolved; only applying them is left.
+void ULiveBPEditorSubsystem::OnMUEMessageReceived(const FLiveBPInboundMessage& Message)
 {
 	if (!IsCollaborationEnabled())
 	{
@@ -537,67 +787,198 @@ void ULiveBPEditorSubsystem::OnMUEMessageReceived(const FLiveBPMessage& Message)
 			ProcessWirePreviewMessage(Message);
 			break;
 		case ELiveBPMessageType::NodeOperation:
+		case ELiveBPMessageType::NodeMoves:
+		case ELiveBPMessageType::NodeTransaction:
 			ProcessNodeOperationMessage(Message);
 			break;
+		case ELiveBPMessageType::Presence:
+			ProcessPresenceMessage(Message);
+			break;
 		case ELiveBPMessageType::LockRequest:
 			ProcessLockMessage(Message);
 			break;
+		case ELiveBPMessageType::LockSet:
+			ProcessLockSetMessage(Message);
+			break;
 		default:
 			break;
 	}
 }
 
-void ULiveBPEditorSubsystem::ProcessWirePreviewMessage(const FLiveBPMessage& Message)
+void ULiveBPEditorSubsystem::ProcessWirePreviewMessage(const FLiveBPInboundMessage& Message)
 {
-	// Find the Blueprint and broadcast the wire preview
-	UBlueprint* Blueprint = FindBlueprintByGuid(Message.BlueprintId);
+	// The Blueprint may have been closed since the message was resolved
+	UBlueprint* Blueprint = Cast<UBlueprint>(Message.Blueprint.Get());
 	if (!Blueprint)
 	{
 		return;
 	}
 
-	// Deserialize wire preview data
-	FLiveBPWirePreview WirePreview;
-	// Implementation would deserialize from Message.PayloadData
-	
-	OnRemoteWirePreview.Broadcast(Blueprint, WirePreview, Message.UserId);
+	if (Message.bWirePreviewEnded)
+	{
+		OnRemoteWirePreviewEnded.Broadcast(Blueprint, Message.UserId);
+		return;
+	}
+
+	OnRemoteWirePreview.Broadcast(Blueprint, Message.Data.Get<FLiveBPWirePreview>(), Message.UserId);
 }
 
-void ULiveBPEditorSubsystem::ProcessNodeOperationMessage(const FLiveBPMessage& Message)
+void ULiveBPEditorSubsystem::ProcessPresenceMessage(const FLiveBPInboundMessage& Message)
 {
-	// Find the Blueprint and broadcast the node operation
-	UBlueprint* Blueprint = FindBlueprintByGuid(Message.BlueprintId);
+	// Peers also report Blueprints we don't have open; the transport has already noted their view for culling
+	UBlueprint* Blueprint = Cast<UBlueprint>(Message.Blueprint.Get());
 	if (!Blueprint)
 	{
 		return;
 	}
 
-	// Deserialize node operation data
-	FLiveBPNodeOperationData NodeOperation;
-	// Implementation would deserialize from Message.PayloadData
-	
-	OnRemoteNodeOperation.Broadcast(Blueprint, NodeOperation, Message.UserId);
+	// A null graph means the user is in a graph we can't show, which still hides their cursor elsewhere
+	UEdGraph* Graph = FindGraphByGuid(Blueprint, Message.GraphId);
+	OnRemotePresence.Broadcast(Blueprint, Graph, Message.Data.Get<FLiveBPPresence>(), Message.UserId);
 }
 
-void ULiveBPEditorSubsystem::ProcessLockMessage(const FLiveBPMessage& Message)  
+void ULiveBPEditorSubsystem::ProcessNodeOperationMessage(const FLiveBPInboundMessage& Message)
 {
-	// Deserialize lock request
-	// Implementation would deserialize from Message.PayloadData
-	FLiveBPNodeLock LockRequest;
-	// For now, create a placeholder
-	
+	// Applied at the end of the frame, within the apply budget
+	FLiveBPInboundMessage Queued = Message;
+	RemoteOperations.Enqueue(MoveTemp(Queued));
+}
+
+void ULiveBPEditorSubsystem::ApplyRemoteOperations()
+{
+	if (RemoteOperations.Num() == 0)
+	{
+		return;
+	}
+
+	const ULiveBPSettings* Settings = GetDefault<ULiveBPSettings>();
+	RemoteOperations.Apply(Settings->RemoteApplyBudgetMs / 1000.0, [this](FLiveBPInboundMessage& Message)
+	{
+		// The Blueprint may have been closed while the operation waited
+		UBlueprint* Blueprint = Cast<UBlueprint>(Message.Blueprint.Get());
+		if (!Blueprint)
+		{
+			return;
+		}
+
+		if (Message.Data.IsType<TArray<FLiveBPNodeMove>>())
+		{
+			ApplyRemoteNodeMoves(Blueprint, Message.GraphId, Message.Data.Get<TArray<FLiveBPNodeMove>>());
+			return;
+		}
+
+		if (Message.Data.IsType<TArray<FLiveBPNodeOperationData>>())
+		{
+			ApplyRemoteNodeTransaction(Blueprint, Message.GraphId, Message.Data.Get<TArray<FLiveBPNodeOperationData>>(), Message.UserId);
+			return;
+		}
+
+		OnRemoteNodeOperation.Broadcast(Blueprint, Message.Data.Get<FLiveBPNodeOperationData>(), Message.UserId);
+	});
+
+	UpdateRemoteApplyProgress();
+}
+
+void ULiveBPEditorSubsystem::ApplyRemoteNodeMoves(UBlueprint* Blueprint, const FGuid& GraphId, const TArray<FLiveBPNodeMove>& Moves)
+{
+	UEdGraph* Graph = FindGraphByGuid(Blueprint, GraphId);
+	if (!Graph || Moves.Num() == 0)
+	{
+		return;
+	}
+
+	// One transaction for the whole group, so it is undone as one
+	FLiveBPGraphIndex& Index = GetGraphIndex(Graph);
+	const FScopedTransaction Transaction(NSLOCTEXT("LiveBP", "RemoteMoveNodes", "Move Nodes (Remote)"));
+	for (const FLiveBPNodeMove& Move : Moves)
+	{
+		UEdGraphNode* Node = Index.FindNode(Move.NodeId);
+		if (Node && (Node->NodePosX != Move.Position.X || Node->NodePosY != Move.Position.Y))
+		{
+			Node->Modify();
+			Node->NodePosX = Move.Position.X;
+			Node->NodePosY = Move.Position.Y;
+		}
+	}
+}
+
+void ULiveBPEditorSubsystem::ApplyRemoteNodeTransaction(UBlueprint* Blueprint, const FGuid& GraphId,
+	const TArray<FLiveBPNodeOperationData>& NodeOperations, const FString& UserId)
+{
+	// The whole editor action is one transaction on our side too, and the graph is refreshed once at the end
+	{
+		const FScopedTransaction Transaction(NSLOCTEXT("LiveBP", "RemoteNodeTransaction", "Edit Graph (Remote)"));
+		for (const FLiveBPNodeOperationData& NodeOperation : NodeOperations)
+		{
+			OnRemoteNodeOperation.Broadcast(Blueprint, NodeOperation, UserId);
+		}
+	}
+
+	if (UEdGraph* Graph = FindGraphByGuid(Blueprint, GraphId))
+	{
+		Graph->NotifyGraphChanged();
+	}
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+}
+
+void ULiveBPEditorSubsystem::UpdateRemoteApplyProgress()
+{
+	TSharedPtr<SNotificationItem> Notification = RemoteApplyNotification.Pin();
+	const int32 Remaining = RemoteOperations.Num();
+
+	if (Remaining == 0)
+	{
+		if (Notification.IsValid())
+		{
+			Notification->SetText(FText::FromString(TEXT("Applied remote changes")));
+			Notification->SetCompletionState(SNotificationItem::CS_Success);
+			Notification->ExpireAndFadeout();
+			RemoteApplyNotification.Reset();
+		}
+		return;
+	}
+
+	// Only a backlog that outlasts a frame is worth showing
+	const int32 Total = RemoteOperations.GetBacklogTotal();
+	const FText Progress = FText::FromString(FString::Printf(TEXT("Applying remote changes: %d of %d"), Total - Remaining, Total));
+
+	if (!Notification.IsValid())
+	{
+		FNotificationInfo Info(Progress);
+		Info.bFireAndForget = false;
+		Info.bUseLargeFont = false;
+		Info.bUseThrobber = true;
+		Info.FadeOutDuration = 0.5f;
+		Info.ExpireDuration = 1.0f;
+
+		Notification = FSlateNotificationManager::Get().AddNotification(Info);
+		if (Notification.IsValid())
+		{
+			Notification->SetCompletionState(SNotificationItem::CS_Pending);
+		}
+		RemoteApplyNotification = Notification;
+		return;
+	}
+
+	Notification->SetText(Progress);
+}
+
+void ULiveBPEditorSubsystem::ProcessLockMessage(const FLiveBPInboundMessage& Message)  
+{
+	const FLiveBPNodeLock& LockRequest = Message.Data.Get<FLiveBPNodeLock>();
+
 	// Update local lock state
 	if (LockRequest.LockState == ELiveBPLockState::Locked)
 	{
-		NodeLocks.Add(LockRequest.NodeId, LockRequest);
+		LockManager->HandleRemoteLockRequest(LockRequest, Message.BlueprintId, Message.GraphId);
 	}
 	else
 	{
-		NodeLocks.Remove(LockRequest.NodeId);
+		LockManager->HandleRemoteLockRelease(LockRequest);
 	}
 
 	// Find and update visual state of the node
-	UBlueprint* Blueprint = FindBlueprintByGuid(Message.BlueprintId);
+	UBlueprint* Blueprint = Cast<UBlueprint>(Message.Blueprint.Get());
 	if (Blueprint)
 	{
 		UEdGraph* Graph = FindGraphByGuid(Blueprint, Message.GraphId);
@@ -612,7 +993,81 @@ void ULiveBPEditorSubsystem::ProcessLockMessage(const FLiveBPMessage& Message)
 	}
 }
 
+void ULiveBPEditorSubsystem::ProcessLockSetMessage(const FLiveBPInboundMessage& Message)
+{
+	const FLiveBPNodeLockSet& LockSet = Message.Data.Get<FLiveBPNodeLockSet>();
+
+	// The sender took the set locally before this reached it, so a conflict is settled the same way on
+	// every client, the sender included, rather than answered
+	const FString LocalUserId = MUEIntegration->GetCurrentUserId();
+	const bool bHeldLocally = LockSet.NodeIds.ContainsByPredicate([this, &LocalUserId](const FGuid& NodeId) { return LockManager->IsLockedByUser(NodeId, LocalUserId); });
+
+	const FLiveBPLockSetResult Result = LockManager->HandleRemoteLockSet(LockSet, Message.BlueprintId, Message.GraphId);
+	if (!Result.IsGranted())
+	{
+		UE_LOG(LogLiveBPEditor, Log, TEXT("Refused %s's lock on %d nodes: %d are held by someone who selected them first"),
+			*LockSet.UserId, LockSet.NodeIds.Num(), Result.Conflicts.Num());
+	}
+	else if (bHeldLocally && Result.Preempted.Num() > 0)
+	{
+		ShowCollaborationNotification(FString::Printf(TEXT("%s selected some of your locked nodes at the same time and took them"), *LockSet.UserId), 3.0f);
+	}
+
+	UBlueprint* Blueprint = Cast<UBlueprint>(Message.Blueprint.Get());
+	UEdGraph* Graph = Blueprint ? FindGraphByGuid(Blueprint, Message.GraphId) : nullptr;
+	if (Graph)
+	{
+		for (const FGuid& NodeId : LockSet.NodeIds)
+		{
+			UpdateNodeVisualState(FindNodeByGuid(Graph, NodeId));
+		}
+		for (const FGuid& NodeId : Result.Preempted)
+		{
+			UpdateNodeVisualState(FindNodeByGuid(Graph, NodeId));
+		}
+	}
+}
+
+void ULiveBPEditorSubsystem::OnUserLeft(const FString& UserId)
+{
+	// Nobody is left to release them; their nodes go to whoever waits next
+	LockManager->ClearUserLocks(UserId);
+}
+
 // Utility functions
+bool ULiveBPEditorSubsystem::GetLockSetScope(TArrayView<UEdGraphNode* const> Nodes, FLiveBPNodeLockSet& OutLockSet, FGuid& OutBlueprintId,
+	FGuid& OutGraphId) const
+{
+	UEdGraph* Graph = nullptr;
+	for (UEdGraphNode* Node : Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		// A lock set travels with a single graph id
+		if (Graph && Node->GetGraph() != Graph)
+		{
+			UE_LOG(LogLiveBPEditor, Warning, TEXT("Cannot lock nodes of several graphs at once"));
+			return false;
+		}
+		Graph = Node->GetGraph();
+		OutLockSet.NodeIds.Add(GetNodeGuid(Node));
+	}
+
+	UBlueprint* Blueprint = Graph ? FBlueprintEditorUtils::FindBlueprintForGraph(Graph) : nullptr;
+	if (!Blueprint)
+	{
+		return false;
+	}
+
+	OutLockSet.UserId = MUEIntegration->GetCurrentUserId();
+	OutBlueprintId = GetBlueprintGuid(Blueprint);
+	OutGraphId = GetGraphGuid(Graph);
+	return true;
+}
+
 UBlueprint* ULiveBPEditorSubsystem::FindBlueprintByGuid(const FGuid& BlueprintId) const
 {
 	if (UBlueprint* const* Found = BlueprintGuidMap.Find(BlueprintId))
@@ -622,41 +1077,48 @@ UBlueprint* ULiveBPEditorSubsystem::FindBlueprintByGuid(const FGuid& BlueprintId
 	return nullptr;
 }
 
-UEdGraph* ULiveBPEditorSubsystem::FindGraphByGuid(UBlueprint* Blueprint, const FGuid& GraphId) const
+UEdGraph* ULiveBPEditorSubsystem::FindGraphByGuid(UBlueprint* Blueprint, const FGuid& GraphId)
 {
-	if (!Blueprint)
-	{
-		return nullptr;
-	}
+	return Blueprint ? GetGraphRegistry(Blueprint).Find(GraphId) : nullptr;
+}
 
-	// Simple implementation - in reality we'd need a better graph identification system
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+FLiveBPGraphRegistry& ULiveBPEditorSubsystem::GetGraphRegistry(UBlueprint* Blueprint)
+{
+	FLiveBPGraphRegistry& Registry = GraphRegistries.FindOrAdd(Blueprint);
+	if (!Registry.IsBuilt())
 	{
-		if (GetGraphGuid(Graph) == GraphId)
-		{
-			return Graph;
-		}
+		Registry.Rebuild(Blueprint, [this](UEdGraph* Graph) { return GetGraphGuid(Graph); });
 	}
+	return Registry;
+}
 
-	return nullptr;
+UEdGraphNode* ULiveBPEditorSubsystem::FindNodeByGuid(UEdGraph* Graph, const FGuid& NodeId)
+{
+	return Graph ? GetGraphIndex(Graph).FindNode(NodeId) : nullptr;
 }
 
-UEdGraphNode* ULiveBPEditorSubsystem::FindNodeByGuid(UEdGraph* Graph, const FGuid& NodeId) const
+UEdGraphPin* ULiveBPEditorSubsystem::FindPinByName(UEdGraph* Graph, const FGuid& NodeId, FName PinName)
 {
-	if (!Graph)
+	return Graph ? GetGraphIndex(Graph).FindPin(NodeId, PinName) : nullptr;
+}
+
+FLiveBPGraphIndex& ULiveBPEditorSubsystem::GetGraphIndex(UEdGraph* Graph)
+{
+	if (TUniquePtr<FLiveBPGraphIndex>* Index = GraphIndices.Find(Graph))
 	{
-		return nullptr;
+		return **Index;
 	}
 
-	for (UEdGraphNode* Node : Graph->Nodes)
+	// Graphs destroyed without their Blueprint being closed first go when the next one is indexed
+	for (auto It = GraphIndices.CreateIterator(); It; ++It)
 	{
-		if (GetNodeGuid(Node) == NodeId)
+		if (!It.Key().IsValid())
 		{
-			return Node;
+			It.RemoveCurrent();
 		}
 	}
 
-	return nullptr;
+	return *GraphIndices.Add(Graph, MakeUnique<FLiveBPGraphIndex>(Graph, [this](UEdGraphNode* Node) { return GetNodeGuid(Node); }));
 }
 
 FGuid ULiveBPEditorSubsystem::GetBlueprintGuid(UBlueprint* Blueprint) const
@@ -666,15 +1128,18 @@ FGuid ULiveBPEditorSubsystem::GetBlueprintGuid(UBlueprint* Blueprint) const
 		return FGuid();
 	}
 
-	// Use the Blueprint's package GUID for consistency across sessions
-	if (UPackage* Package = Blueprint->GetPackage())
+	return Identities.FindOrAdd(Blueprint, [Blueprint]()
 	{
-		return Package->GetGuid();
-	}
-	
-	// Fallback: generate based on asset path for consistency
-	FString AssetPath = Blueprint->GetPathName();
-	return FGuid::NewNameGuid(AssetPath);
+		// Use the Blueprint's package GUID for consistency across sessions
+		if (UPackage* Package = Blueprint->GetPackage())
+		{
+			return Package->GetGuid();
+		}
+		
+		// Fallback: generate based on asset path for consistency
+		FString AssetPath = Blueprint->GetPathName();
+		return FGuid::NewNameGuid(AssetPath);
+	});
 }
 
 FGuid ULiveBPEditorSubsystem::GetGraphGuid(UEdGraph* Graph) const
@@ -684,16 +1149,19 @@ FGuid ULiveBPEditorSubsystem::GetGraphGuid(UEdGraph* Graph) const
 		return FGuid();
 	}
 
-	// Generate consistent GUID based on graph name and owning Blueprint
-	UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
-	if (Blueprint)
+	return Identities.FindOrAdd(Graph, [Graph]()
 	{
-		FString GraphIdentifier = FString::Printf(TEXT("%s_%s"), *Blueprint->GetPathName(), *Graph->GetName());
-		return FGuid::NewNameGuid(GraphIdentifier);
-	}
-	
-	// Fallback
-	return FGuid::NewNameGuid(Graph->GetPathName());
+		// Generate consistent GUID based on graph name and owning Blueprint
+		UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+		if (Blueprint)
+		{
+			FString GraphIdentifier = FString::Printf(TEXT("%s_%s"), *Blueprint->GetPathName(), *Graph->GetName());
+			return FGuid::NewNameGuid(GraphIdentifier);
+		}
+		
+		// Fallback
+		return FGuid::NewNameGuid(Graph->GetPathName());
+	});
 }
 
 FGuid ULiveBPEditorSubsystem::GetNodeGuid(UEdGraphNode* Node) const
@@ -710,28 +1178,32 @@ FGuid ULiveBPEditorSubsystem::GetNodeGuid(UEdGraphNode* Node) const
 	}
 	
 	// Generate a deterministic GUID based on node class and position for consistency
-	// This ensures the same node gets the same GUID across different sessions
-	UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
-	if (Blueprint)
+	// This ensures the same node gets the same GUID across different sessions. Cached, it also
+	// stays the same while the node is moved.
+	return Identities.FindOrAdd(Node, [Node]()
 	{
-		FString NodeIdentifier = FString::Printf(TEXT("%s_%s_%d_%d_%s"), 
-			*Blueprint->GetPathName(), 
+		UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForNode(Node);
+		if (Blueprint)
+		{
+			FString NodeIdentifier = FString::Printf(TEXT("%s_%s_%d_%d_%s"), 
+				*Blueprint->GetPathName(), 
+				*Node->GetClass()->GetName(),
+				(int32)Node->NodePosX,
+				(int32)Node->NodePosY,
+				*Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+			
+			// Generate deterministic GUID from the identifier string
+			return FGuid::NewNameGuid(NodeIdentifier);
+		}
+		
+		// Fallback: generate based on class and position only
+		FString FallbackIdentifier = FString::Printf(TEXT("%s_%d_%d"), 
 			*Node->GetClass()->GetName(),
 			(int32)Node->NodePosX,
-			(int32)Node->NodePosY,
-			*Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+			(int32)Node->NodePosY);
 		
-		// Generate deterministic GUID from the identifier string
-		return FGuid::NewNameGuid(NodeIdentifier);
-	}
-	
-	// Fallback: generate based on class and position only
-	FString FallbackIdentifier = FString::Printf(TEXT("%s_%d_%d"), 
-		*Node->GetClass()->GetName(),
-		(int32)Node->NodePosX,
-		(int32)Node->NodePosY);
-	
-	return FGuid::NewNameGuid(FallbackIdentifier);
+		return FGuid::NewNameGuid(FallbackIdentifier);
+	});
 }
 
 void ULiveBPEditorSubsystem::UpdateNodeVisualState(UEdGraphNode* Node)
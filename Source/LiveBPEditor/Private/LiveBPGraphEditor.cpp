@@ -15,6 +15,7 @@
 #include "Rendering/DrawElements.h"
 #include "Widgets/SBoxPanel.h"
 #include "Engine/Engine.h"
+#include "Editor.h"
 
 void SLiveBPGraphEditor::Construct(const FArguments& InArgs)
 {
@@ -22,12 +23,20 @@ void SLiveBPGraphEditor::Construct(const FArguments& InArgs)
 	DragStartPinId = FGuid();
 	DragStartPosition = FVector2D::ZeroVector;
 	LastMousePosition = FVector2D::ZeroVector;
+	bPublishingPresence = false;
 	LastCleanupTime = 0.0f;
 	
 	// Get editor subsystem
-	if (GEngine)
+	if (GEditor)
 	{
-		EditorSubsystem = GEngine->GetEngineSubsystem<ULiveBPEditorSubsystem>();
+		EditorSubsystem = GEditor->GetEditorSubsystem<ULiveBPEditorSubsystem>();
+	}
+	
+	if (EditorSubsystem.IsValid())
+	{
+		EditorSubsystem->OnRemoteWirePreview.AddSP(this, &SLiveBPGraphEditor::HandleRemoteWirePreview);
+		EditorSubsystem->OnRemoteWirePreviewEnded.AddSP(this, &SLiveBPGraphEditor::HandleRemoteWirePreviewEnded);
+		EditorSubsystem->OnRemotePresence.AddSP(this, &SLiveBPGraphEditor::HandleRemotePresence);
 	}
 	
 	// Create the standard graph editor
@@ -96,6 +105,29 @@ void SLiveBPGraphEditor::Tick(const FGeometry& AllottedGeometry, const double In
 	
 	// Update collaboration overlay
 	UpdateCollaborationOverlay();
+	
+	// Our presence follows panning and zooming as well as the mouse; the subsystem samples it at the presence rate
+	if (IsHovered())
+	{
+		PublishPresence(AllottedGeometry, true);
+	}
+	
+	// Remote motion is interpolated between updates, so keep repainting while any of it is still moving
+	const double Now = FPlatformTime::Seconds();
+	const FLiveBPPlayoutSettings Playout = GetPlayoutSettings();
+	bool bRemoteMotion = false;
+	for (const auto& CursorPair : RemoteUserCursors)
+	{
+		bRemoteMotion |= CursorPair.Value.bIsVisible && CursorPair.Value.Motion.IsMoving(Now, Playout);
+	}
+	for (const auto& PreviewPair : WireDragPreviews)
+	{
+		bRemoteMotion |= PreviewPair.Value.bIsActive && PreviewPair.Value.EndMotion.IsMoving(Now, Playout);
+	}
+	if (bRemoteMotion)
+	{
+		Invalidate(EInvalidateWidgetReason::Paint);
+	}
 }
 
 int32 SLiveBPGraphEditor::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, 
@@ -106,17 +138,31 @@ int32 SLiveBPGraphEditor::OnPaint(const FPaintArgs& Args, const FGeometry& Allot
 	
 	// Draw collaboration overlays on top
 	const ULiveBPSettings* Settings = GetDefault<ULiveBPSettings>();
-	if (!Settings || !Settings->bShowRemoteUserCursors)
+	if (!Settings)
 	{
 		return MaxLayerId;
 	}
 	
-	// Draw remote user cursors
-	for (const auto& CursorPair : RemoteUserCursors)
+	// Remote cursors and previews are sampled once per paint, a playout delay behind the newest update
+	const double Now = FPlatformTime::Seconds();
+	const FLiveBPPlayoutSettings Playout = GetPlayoutSettings();
+	
+	// Draw remote user cursors, skipping the ones scrolled out of our view
+	if (Settings->bShowCollaboratorCursors)
 	{
-		if (CursorPair.Value.bIsVisible)
+		const FSlateRect Visible(FVector2D(-CURSOR_SIZE, -CURSOR_SIZE), AllottedGeometry.GetLocalSize());
+		for (const auto& CursorPair : RemoteUserCursors)
 		{
-			DrawRemoteUserCursor(AllottedGeometry, OutDrawElements, MaxLayerId + 1, CursorPair.Key, CursorPair.Value);
+			if (!CursorPair.Value.bIsVisible)
+			{
+				continue;
+			}
+	
+			const FVector2D Position = CursorPair.Value.Motion.Evaluate(Now, Playout);
+			if (Visible.ContainsPoint(GraphToScreenPosition(AllottedGeometry, Position)))
+			{
+				DrawRemoteUserCursor(AllottedGeometry, OutDrawElements, MaxLayerId + 1, CursorPair.Key, CursorPair.Value, Position);
+			}
 		}
 	}
 	
@@ -127,7 +173,8 @@ int32 SLiveBPGraphEditor::OnPaint(const FPaintArgs& Args, const FGeometry& Allot
 		{
 			if (PreviewPair.Value.bIsActive)
 			{
-				DrawWireDragPreview(AllottedGeometry, OutDrawElements, MaxLayerId + 2, PreviewPair.Key, PreviewPair.Value);
+				DrawWireDragPreview(AllottedGeometry, OutDrawElements, MaxLayerId + 2, PreviewPair.Key, PreviewPair.Value,
+					PreviewPair.Value.EndMotion.Evaluate(Now, Playout));
 			}
 		}
 	}
@@ -156,21 +203,22 @@ FReply SLiveBPGraphEditor::OnMouseMove(const FGeometry& MyGeometry, const FPoint
 	if (bIsWireDragging)
 	{
 		OnLocalWireDragUpdate(ScreenToGraphPosition(MyGeometry, MousePosition));
-		SendWirePreviewMessage(ScreenToGraphPosition(MyGeometry, MousePosition));
 	}
 	
-	// Let the base graph editor handle the event first
-	FReply Reply = GraphEditor->OnMouseMove(MyGeometry, MouseEvent);
+	// Let the base graph editor handle the event first; our cursor is published from Tick
+	return GraphEditor->OnMouseMove(MyGeometry, MouseEvent);
+}
+
+void SLiveBPGraphEditor::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SCompoundWidget::OnMouseLeave(MouseEvent);
 	
-	// Send cursor position to other users if enabled
-	const ULiveBPSettings* Settings = GetDefault<ULiveBPSettings>();
-	if (Settings && Settings->bBroadcastCursorPosition && EditorSubsystem.IsValid())
+	// Keep the view, drop the cursor
+	if (bPublishingPresence)
 	{
-		FVector2D GraphPos = ScreenToGraphPosition(MyGeometry, MousePosition);
-		EditorSubsystem->BroadcastCursorPosition(GraphPos);
+		PublishPresence(GetCachedGeometry(), false);
+		bPublishingPresence = false;
 	}
-	
-	return Reply;
 }
 
 FReply SLiveBPGraphEditor::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
@@ -239,24 +287,89 @@ FReply SLiveBPGraphEditor::OnDragDetected(const FGeometry& MyGeometry, const FPo
 void SLiveBPGraphEditor::UpdateRemoteUserCursor(const FString& UserId, const FVector2D& Position, const FLinearColor& Color)
 {
 	FRemoteUserCursor& Cursor = RemoteUserCursors.FindOrAdd(UserId);
+	const double Now = FPlatformTime::Seconds();
+	
+	// A cursor that reappears starts where it is, not gliding in from where it was last seen
+	if (!Cursor.bIsVisible)
+	{
+		Cursor.Motion.Reset();
+	}
+	Cursor.Motion.AddSample(Now, Position, GetPlayoutSettings());
+	
 	Cursor.Position = Position;
 	Cursor.Color = Color;
-	Cursor.LastUpdateTime = FPlatformTime::Seconds();
+	Cursor.LastUpdateTime = Now;
 	Cursor.bIsVisible = true;
 }
 
-void SLiveBPGraphEditor::UpdateWireDragPreview(const FLiveBPWirePreviewMessage& Message)
+void SLiveBPGraphEditor::UpdateWireDragPreview(const FString& UserId, const FLiveBPWirePreview& WirePreview)
 {
-	FWireDragPreview& Preview = WireDragPreviews.FindOrAdd(Message.SenderId);
-	Preview.StartPinId = Message.StartPinId;
-	Preview.CurrentPosition = Message.CurrentMousePosition;
-	Preview.Color = GetUserColor(Message.SenderId);
-	Preview.LastUpdateTime = FPlatformTime::Seconds();
+	FWireDragPreview& Preview = WireDragPreviews.FindOrAdd(UserId);
+	const double Now = FPlatformTime::Seconds();
+	
+	// Each drag is its own stream
+	if (!Preview.bIsActive || Preview.StartNodeId != WirePreview.NodeId || Preview.StartPinName != WirePreview.PinName)
+	{
+		Preview.EndMotion.Reset();
+	}
+	Preview.EndMotion.AddSample(Now, WirePreview.EndPosition, GetPlayoutSettings());
+	
+	Preview.StartNodeId = WirePreview.NodeId;
+	Preview.StartPinName = WirePreview.PinName;
+	Preview.StartPosition = WirePreview.StartPosition;
+	Preview.CurrentPosition = WirePreview.EndPosition;
+	Preview.Color = GetUserColor(UserId);
+	Preview.LastUpdateTime = Now;
 	Preview.bIsActive = true;
+}
+
+void SLiveBPGraphEditor::HandleRemoteWirePreview(UBlueprint* Blueprint, const FLiveBPWirePreview& WirePreview, const FString& UserId)
+{
+	if (Blueprint == CurrentBlueprint.Get())
+	{
+		UpdateWireDragPreview(UserId, WirePreview);
+	}
+}
+
+void SLiveBPGraphEditor::HandleRemoteWirePreviewEnded(UBlueprint* Blueprint, const FString& UserId)
+{
+	if (Blueprint == CurrentBlueprint.Get())
+	{
+		ClearWireDragPreview(UserId);
+	}
+}
+
+void SLiveBPGraphEditor::PublishPresence(const FGeometry& Geometry, bool bHasCursor)
+{
+	if (!EditorSubsystem.IsValid() || !GraphEditor.IsValid())
+	{
+		return;
+	}
 	
-	// Find start position from pin
-	// This would require blueprint graph traversal to find the actual pin position
-	Preview.StartPosition = FVector2D(0, 0); // Placeholder
+	const FVector2D ViewMin = ScreenToGraphPosition(Geometry, FVector2D::ZeroVector);
+	const FVector2D ViewMax = ScreenToGraphPosition(Geometry, Geometry.GetLocalSize());
+	const FVector2D Cursor = ScreenToGraphPosition(Geometry, LastMousePosition);
+	
+	EditorSubsystem->UpdatePresence(GraphEditor->GetCurrentGraph(), bHasCursor ? &Cursor : nullptr, FBox2D(ViewMin, ViewMax));
+	bPublishingPresence = bHasCursor;
+}
+
+void SLiveBPGraphEditor::HandleRemotePresence(UBlueprint* Blueprint, UEdGraph* Graph, const FLiveBPPresence& Presence, const FString& UserId)
+{
+	if (Blueprint != CurrentBlueprint.Get())
+	{
+		return;
+	}
+	
+	// In this graph with the mouse over it; otherwise the cursor is hidden, not forgotten, so it keeps its color
+	if (Presence.bHasCursor && GraphEditor.IsValid() && Graph == GraphEditor->GetCurrentGraph())
+	{
+		UpdateRemoteUserCursor(UserId, FLiveBPPresenceEncoder::ToGraph(Presence.Cursor), GetUserColor(UserId));
+	}
+	else if (FRemoteUserCursor* Cursor = RemoteUserCursors.Find(UserId))
+	{
+		Cursor->bIsVisible = false;
+	}
 }
 
 void SLiveBPGraphEditor::ClearWireDragPreview(const FString& UserId)
@@ -299,14 +412,28 @@ FLinearColor SLiveBPGraphEditor::GetUserColor(const FString& UserId)
 	return NewColor;
 }
 
+FLiveBPPlayoutSettings SLiveBPGraphEditor::GetPlayoutSettings()
+{
+	FLiveBPPlayoutSettings Playout;
+	if (const ULiveBPSettings* Settings = GetDefault<ULiveBPSettings>())
+	{
+		Playout.Delay = Settings->RemotePlayoutDelayMs / 1000.0;
+		Playout.MaxExtrapolation = Settings->MaxExtrapolationMs / 1000.0;
+	}
+	return Playout;
+}
+
 void SLiveBPGraphEditor::OnLocalWireDragStart(const FGuid& PinId, const FVector2D& Position)
 {
 	bIsWireDragging = true;
 	DragStartPinId = PinId;
 	DragStartPosition = Position;
 	
-	// Send initial wire preview message
-	SendWirePreviewMessage(Position);
+	// Send the anchor once; subsequent updates only carry the end position
+	if (EditorSubsystem.IsValid())
+	{
+		EditorSubsystem->BeginWirePreview(FindPinById(PinId), Position);
+	}
 	
 	UE_LOG(LogLiveBPEditor, VeryVerbose, TEXT("Started local wire drag from pin %s at position %s"), 
 		*PinId.ToString(), *Position.ToString());
@@ -317,8 +444,11 @@ void SLiveBPGraphEditor::OnLocalWireDragUpdate(const FVector2D& Position)
 	if (!bIsWireDragging)
 		return;
 	
-	// Throttled sending handled by SendWirePreviewMessage
-	SendWirePreviewMessage(Position);
+	// Throttling and movement suppression are handled by the subsystem
+	if (EditorSubsystem.IsValid())
+	{
+		EditorSubsystem->UpdateWirePreview(Position);
+	}
 }
 
 void SLiveBPGraphEditor::OnLocalWireDragEnd(const FVector2D& Position, bool bConnected)
@@ -328,21 +458,11 @@ void SLiveBPGraphEditor::OnLocalWireDragEnd(const FVector2D& Position, bool bCon
 	
 	bIsWireDragging = false;
 	
-	// Send final wire preview message indicating end
+	// Flush the final position and close the stream
 	if (EditorSubsystem.IsValid())
 	{
-		FLiveBPWirePreviewMessage EndMessage;
-		EndMessage.MessageId = FGuid::NewGuid();
-		EndMessage.SenderId = EditorSubsystem->GetLocalUserId();
-		EndMessage.BlueprintId = CurrentBlueprint.IsValid() ? 
-			FGuid() : FGuid(); // Would get actual blueprint ID
-		EndMessage.StartPinId = DragStartPinId;
-		EndMessage.CurrentMousePosition = Position;
-		EndMessage.bIsDragEnd = true;
-		EndMessage.bWasConnected = bConnected;
-		EndMessage.Timestamp = FPlatformTime::Seconds();
-		
-		EditorSubsystem->SendWirePreviewMessage(EndMessage);
+		EditorSubsystem->UpdateWirePreview(Position);
+		EditorSubsystem->EndWirePreview();
 	}
 	
 	// Release any node locks we were holding
@@ -352,29 +472,29 @@ void SLiveBPGraphEditor::OnLocalWireDragEnd(const FVector2D& Position, bool bCon
 		*Position.ToString(), bConnected ? TEXT("true") : TEXT("false"));
 }
 
-void SLiveBPGraphEditor::SendWirePreviewMessage(const FVector2D& MousePosition)
+UEdGraphPin* SLiveBPGraphEditor::FindPinById(const FGuid& PinId) const
 {
-	if (!EditorSubsystem.IsValid() || !bIsWireDragging)
-		return;
+	UEdGraph* Graph = GraphEditor.IsValid() ? GraphEditor->GetCurrentGraph() : nullptr;
+	if (!Graph || !PinId.IsValid())
+	{
+		return nullptr;
+	}
 	
-	FLiveBPWirePreviewMessage Message;
-	Message.MessageId = FGuid::NewGuid();
-	Message.SenderId = EditorSubsystem->GetLocalUserId();
-	Message.BlueprintId = CurrentBlueprint.IsValid() ? 
-		FGuid() : FGuid(); // Would get actual blueprint ID
-	Message.StartPinId = DragStartPinId;
-	Message.CurrentMousePosition = MousePosition;
-	Message.bIsDragEnd = false;
-	Message.bWasConnected = false;
-	Message.Timestamp = FPlatformTime::Seconds();
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (UEdGraphPin* Pin = Node ? Node->FindPinById(PinId) : nullptr)
+		{
+			return Pin;
+		}
+	}
 	
-	EditorSubsystem->SendWirePreviewMessage(Message);
+	return nullptr;
 }
 
 void SLiveBPGraphEditor::DrawRemoteUserCursor(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, 
-	int32 LayerId, const FString& UserId, const FRemoteUserCursor& Cursor) const
+	int32 LayerId, const FString& UserId, const FRemoteUserCursor& Cursor, const FVector2D& Position) const
 {
-	FVector2D ScreenPos = GraphToScreenPosition(AllottedGeometry, Cursor.Position);
+	FVector2D ScreenPos = GraphToScreenPosition(AllottedGeometry, Position);
 	
 	// Draw cursor triangle
 	TArray<FVector2D> CursorPoints;
@@ -409,10 +529,10 @@ void SLiveBPGraphEditor::DrawRemoteUserCursor(const FGeometry& AllottedGeometry,
 }
 
 void SLiveBPGraphEditor::DrawWireDragPreview(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, 
-	int32 LayerId, const FString& UserId, const FWireDragPreview& Preview) const
+	int32 LayerId, const FString& UserId, const FWireDragPreview& Preview, const FVector2D& EndPosition) const
 {
 	FVector2D StartScreenPos = GraphToScreenPosition(AllottedGeometry, Preview.StartPosition);
-	FVector2D EndScreenPos = GraphToScreenPosition(AllottedGeometry, Preview.CurrentPosition);
+	FVector2D EndScreenPos = GraphToScreenPosition(AllottedGeometry, EndPosition);
 	
 	// Draw preview wire with bezier curve (similar to Blueprint wires)
 	FVector2D ControlPoint1 = StartScreenPos + FVector2D(50, 0);
@@ -478,11 +598,13 @@ void SLiveBPGraphEditor::DrawNodeLockFeedback(const FGeometry& AllottedGeometry,
 
 FVector2D SLiveBPGraphEditor::ScreenToGraphPosition(const FGeometry& Geometry, const FVector2D& ScreenPosition) const
 {
+	// Positions here are local to the panel; the view location is the graph position of its top left corner
 	if (GraphEditor.IsValid())
 	{
-		// This would use the graph editor's coordinate transformation
-		// For now, return screen position as placeholder
-		return ScreenPosition;
+		FVector2D ViewLocation;
+		float ZoomAmount = 1.0f;
+		GraphEditor->GetViewLocation(ViewLocation, ZoomAmount);
+		return ViewLocation + ScreenPosition / FMath::Max(ZoomAmount, KINDA_SMALL_NUMBER);
 	}
 	return ScreenPosition;
 }
@@ -491,9 +613,10 @@ FVector2D SLiveBPGraphEditor::GraphToScreenPosition(const FGeometry& Geometry, c
 {
 	if (GraphEditor.IsValid())
 	{
-		// This would use the graph editor's coordinate transformation
-		// For now, return graph position as placeholder
-		return GraphPosition;
+		FVector2D ViewLocation;
+		float ZoomAmount = 1.0f;
+		GraphEditor->GetViewLocation(ViewLocation, ZoomAmount);
+		return (GraphPosition - ViewLocation) * ZoomAmount;
 	}
 	return GraphPosition;
 }
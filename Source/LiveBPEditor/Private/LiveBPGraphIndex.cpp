@@ -0,0 +1,254 @@
+#include "LiveBPGraphIndex.h"
+#include "LiveBPEditor.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+
+FLiveBPGraphIndex::FLiveBPGraphIndex(UEdGraph* InGraph, FNodeIdFunc InGetNodeId)
+	: Graph(InGraph)
+	, GetNodeId(MoveTemp(InGetNodeId))
+	, bNeedsRebuild(true)
+	, bRebuiltSinceChange(false)
+{
+	if (InGraph)
+	{
+		GraphChangedHandle = InGraph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateRaw(this, &FLiveBPGraphIndex::OnGraphChanged));
+	}
+}
+
+FLiveBPGraphIndex::~FLiveBPGraphIndex()
+{
+	if (UEdGraph* IndexedGraph = Graph.Get())
+	{
+		IndexedGraph->RemoveOnGraphChangedHandler(GraphChangedHandle);
+	}
+}
+
+UEdGraphNode* FLiveBPGraphIndex::FindNode(const FGuid& NodeId)
+{
+	if (bNeedsRebuild)
+	{
+		Rebuild();
+	}
+	else if (AddedNodes.Num() > 0)
+	{
+		IndexAddedNodes();
+	}
+
+	FNodeEntry* Entry = Nodes.Find(NodeId);
+	if (!Entry && !bRebuiltSinceChange)
+	{
+		// An id that changed without a notification; an index built from scratch is right until the graph changes again
+		Rebuild();
+		Entry = Nodes.Find(NodeId);
+	}
+	if (!Entry)
+	{
+		return nullptr;
+	}
+
+	UEdGraphNode* Node = Entry->Node.Get();
+	if (!Node)
+	{
+		// Collected without the graph telling us; nothing else can be stale in the same way without a rebuild
+		bNeedsRebuild = true;
+		return nullptr;
+	}
+	return Node;
+}
+
+UEdGraphPin* FLiveBPGraphIndex::FindPin(const FGuid& NodeId, FName PinName)
+{
+	UEdGraphNode* Node = FindNode(NodeId);
+	if (!Node)
+	{
+		return nullptr;
+	}
+
+	FNodeEntry& Entry = Nodes.FindChecked(NodeId);
+	if (!Entry.bPinsIndexed)
+	{
+		IndexPins(Entry);
+	}
+
+	auto FindIndexedPin = [&Entry, Node, PinName]() -> UEdGraphPin*
+	{
+		const int32* PinIndex = Entry.PinIndices.Find(PinName);
+		UEdGraphPin* Pin = PinIndex && Node->Pins.IsValidIndex(*PinIndex) ? Node->Pins[*PinIndex] : nullptr;
+		return Pin && Pin->PinName == PinName ? Pin : nullptr;
+	};
+
+	if (UEdGraphPin* Pin = FindIndexedPin())
+	{
+		return Pin;
+	}
+
+	// A reconstructed node has new pins; re-index it and look once more
+	IndexPins(Entry);
+	return FindIndexedPin();
+}
+
+void FLiveBPGraphIndex::OnGraphChanged(const FEdGraphEditAction& Action)
+{
+	if (bNeedsRebuild)
+	{
+		return;
+	}
+
+	// Selection doesn't change the graph; anything we can't patch in is rebuilt on the next lookup
+	if (Action.Action == GRAPHACTION_SelectNode)
+	{
+		return;
+	}
+
+	bRebuiltSinceChange = false;
+
+	// A pasted or spawned node only gets its own guid after this notification, so its id is read at the next lookup
+	if (Action.Action & GRAPHACTION_AddNode)
+	{
+		for (const UEdGraphNode* Node : Action.Nodes)
+		{
+			AddedNodes.Add(const_cast<UEdGraphNode*>(Node));
+		}
+		return;
+	}
+
+	if (Action.Action & GRAPHACTION_RemoveNode)
+	{
+		for (const UEdGraphNode* Node : Action.Nodes)
+		{
+			AddedNodes.Remove(const_cast<UEdGraphNode*>(Node));
+			RemoveNode(Node);
+		}
+	}
+	else
+	{
+		bNeedsRebuild = true;
+		return;
+	}
+
+	if (AddedNodes.Num() == 0)
+	{
+		Verify();
+	}
+}
+
+void FLiveBPGraphIndex::Rebuild()
+{
+	bNeedsRebuild = false;
+	bRebuiltSinceChange = true;
+	Nodes.Reset();
+	NodeIds.Reset();
+	AddedNodes.Reset();
+
+	UEdGraph* IndexedGraph = Graph.Get();
+	if (!IndexedGraph)
+	{
+		return;
+	}
+
+	Nodes.Reserve(IndexedGraph->Nodes.Num());
+	NodeIds.Reserve(IndexedGraph->Nodes.Num());
+	for (UEdGraphNode* Node : IndexedGraph->Nodes)
+	{
+		AddNode(Node);
+	}
+
+	UE_LOG(LogLiveBPEditor, VeryVerbose, TEXT("Indexed %d nodes of graph %s"), NodeIds.Num(), *IndexedGraph->GetName());
+}
+
+void FLiveBPGraphIndex::IndexAddedNodes()
+{
+	for (const TWeakObjectPtr<UEdGraphNode>& Node : AddedNodes)
+	{
+		AddNode(Node.Get());
+	}
+	AddedNodes.Reset();
+
+	Verify();
+}
+
+void FLiveBPGraphIndex::AddNode(UEdGraphNode* Node)
+{
+	if (!Node || NodeIds.Contains(Node))
+	{
+		return;
+	}
+
+	const FGuid NodeId = GetNodeId(Node);
+	FNodeEntry& Entry = Nodes.Add(NodeId);
+	Entry.Node = Node;
+	NodeIds.Add(Node, NodeId);
+}
+
+void FLiveBPGraphIndex::RemoveNode(const UEdGraphNode* Node)
+{
+	FGuid NodeId;
+	if (!NodeIds.RemoveAndCopyValue(Node, NodeId))
+	{
+		return;
+	}
+
+	// Another node may have taken the id over since (a paste that kept the original's guid)
+	const FNodeEntry* Entry = Nodes.Find(NodeId);
+	if (Entry && Entry->Node.Get() == Node)
+	{
+		Nodes.Remove(NodeId);
+	}
+}
+
+void FLiveBPGraphIndex::IndexPins(FNodeEntry& Entry)
+{
+	Entry.PinIndices.Reset();
+	Entry.bPinsIndexed = true;
+
+	UEdGraphNode* Node = Entry.Node.Get();
+	if (!Node)
+	{
+		return;
+	}
+
+	// First pin of a name wins, as with UEdGraphNode::FindPin
+	for (int32 PinIndex = 0; PinIndex < Node->Pins.Num(); ++PinIndex)
+	{
+		if (const UEdGraphPin* Pin = Node->Pins[PinIndex])
+		{
+			Entry.PinIndices.FindOrAdd(Pin->PinName, PinIndex);
+		}
+	}
+}
+
+void FLiveBPGraphIndex::Verify() const
+{
+#if DO_GUARD_SLOW
+	const UEdGraph* IndexedGraph = Graph.Get();
+	if (!IndexedGraph)
+	{
+		return;
+	}
+
+	int32 NumNodes = 0;
+	for (const UEdGraphNode* Node : IndexedGraph->Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		++NumNodes;
+		const FGuid* NodeId = NodeIds.Find(Node);
+		if (!ensureMsgf(NodeId && Nodes.Contains(*NodeId), TEXT("LiveBP graph index of %s is missing node %s"),
+			*IndexedGraph->GetName(), *Node->GetName()))
+		{
+			continue;
+		}
+
+		ensureMsgf(GetNodeId(const_cast<UEdGraphNode*>(Node)) == *NodeId, TEXT("LiveBP graph index of %s has node %s under stale id %s"),
+			*IndexedGraph->GetName(), *Node->GetName(), *NodeId->ToString());
+		ensureMsgf(Nodes[*NodeId].Node.Get() == Node, TEXT("LiveBP graph index of %s has another node under the id of %s"),
+			*IndexedGraph->GetName(), *Node->GetName());
+	}
+
+	ensureMsgf(NumNodes == NodeIds.Num(), TEXT("LiveBP graph index of %s has %d nodes, the graph %d"),
+		*IndexedGraph->GetName(), NodeIds.Num(), NumNodes);
+#endif
+}
@@ -0,0 +1,48 @@
+#include "LiveBPGraphRegistry.h"
+#include "LiveBPEditor.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+
+void FLiveBPGraphRegistry::Rebuild(UBlueprint* Blueprint, FGraphIdFunc GetGraphId)
+{
+	bIsBuilt = true;
+	Graphs.Reset();
+
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	// Includes the graphs nested in each graph, at any depth
+	TArray<UEdGraph*> AllGraphs;
+	Blueprint->GetAllGraphs(AllGraphs);
+
+	Graphs.Reserve(AllGraphs.Num());
+	for (UEdGraph* Graph : AllGraphs)
+	{
+		if (Graph)
+		{
+			Graphs.Add(GetGraphId(Graph), Graph);
+		}
+	}
+
+	UE_LOG(LogLiveBPEditor, VeryVerbose, TEXT("Registered %d graphs of %s"), Graphs.Num(), *Blueprint->GetName());
+}
+
+UEdGraph* FLiveBPGraphRegistry::Find(const FGuid& GraphId) const
+{
+	const TWeakObjectPtr<UEdGraph>* Graph = Graphs.Find(GraphId);
+	return Graph ? Graph->Get() : nullptr;
+}
+
+void FLiveBPGraphRegistry::GetGraphs(TArray<UEdGraph*>& OutGraphs) const
+{
+	OutGraphs.Reset(Graphs.Num());
+	for (const TPair<FGuid, TWeakObjectPtr<UEdGraph>>& Pair : Graphs)
+	{
+		if (UEdGraph* Graph = Pair.Value.Get())
+		{
+			OutGraphs.Add(Graph);
+		}
+	}
+}
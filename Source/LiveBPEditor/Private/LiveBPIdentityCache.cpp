@@ -0,0 +1,35 @@
+#include "LiveBPIdentityCache.h"
+
+FGuid FLiveBPIdentityCache::FindOrAdd(UObject* Object, TFunctionRef<FGuid()> Compute)
+{
+	if (!Object)
+	{
+		return FGuid();
+	}
+
+	if (const FGuid* Id = Ids.Find(Object))
+	{
+		return *Id;
+	}
+
+	const FGuid Id = Compute();
+	Ids.Add(Object, Id);
+	return Id;
+}
+
+void FLiveBPIdentityCache::RemoveWithin(const UObject* Outer)
+{
+	for (auto It = Ids.CreateIterator(); It; ++It)
+	{
+		const UObject* Object = It.Key().Get();
+		if (!Object || Object == Outer || Object->IsIn(Outer))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FLiveBPIdentityCache::Reset()
+{
+	Ids.Reset();
+}
@@ -101,6 +101,8 @@ private:
 	TSharedPtr<STextBlock> ErrorCountText;
 	TSharedPtr<SProgressBar> NetworkLatencyBar;
 	TSharedPtr<STextBlock> NetworkLatencyText;
+	TSharedPtr<STextBlock> SendRateText;
+	TSharedPtr<STextBlock> PlayoutDelayText;
 	
 	/** Update timers */
 	float LastUpdateTime;
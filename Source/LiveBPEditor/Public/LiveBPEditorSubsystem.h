@@ -6,15 +6,24 @@
 #include "BlueprintGraph/Classes/K2Node.h"
 #include "LiveBPDataTypes.h"
 #include "LiveBPMUEIntegration.h"
+#include "LiveBPLockManager.h"
+#include "LiveBPPresence.h"
+#include "LiveBPApplyScheduler.h"
+#include "LiveBPGraphIndex.h"
+#include "LiveBPIdentityCache.h"
+#include "LiveBPGraphRegistry.h"
 #include "LiveBPEditorSubsystem.generated.h"
 
 class SGraphEditor;
 class UEdGraph;
 class UEdGraphNode;
 class FBlueprintEditor;
+class SNotificationItem;
 
 DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnRemoteWirePreview, UBlueprint*, const FLiveBPWirePreview&, const FString&);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnRemoteWirePreviewEnded, UBlueprint*, const FString&);
 DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnRemoteNodeOperation, UBlueprint*, const FLiveBPNodeOperationData&, const FString&);
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnRemotePresence, UBlueprint*, UEdGraph*, const FLiveBPPresence&, const FString&);
 
 UCLASS()
 class LIVEBPEDITOR_API ULiveBPEditorSubsystem : public UEditorSubsystem
@@ -40,35 +49,80 @@ public:
 	
 	// Access to components (for console commands)
 	ULiveBPMUEIntegration* GetMUEIntegration() const { return MUEIntegration; }
+	ULiveBPLockManager* GetLockManager() const { return LockManager; }
 
 	// Node locking
 	bool RequestNodeLock(UEdGraphNode* Node, float LockDuration = 30.0f);
 	bool ReleaseNodeLock(UEdGraphNode* Node);
 	bool IsNodeLockedByOther(UEdGraphNode* Node) const;
+
+	// Locks a selection of nodes from one graph all at once, in a single message; if any is held by
+	// someone else, none is taken and the result lists the conflicting nodes
+	FLiveBPLockSetResult RequestNodeLocks(TArrayView<UEdGraphNode* const> Nodes, float LockDuration = 30.0f);
+	bool ReleaseNodeLocks(TArrayView<UEdGraphNode* const> Nodes);
 	bool CanModifyNode(UEdGraphNode* Node) const;
 
+	// Local wire drag previews, streamed to the other users
+	bool BeginWirePreview(UEdGraphPin* StartPin, const FVector2D& StartPosition);
+	void UpdateWirePreview(const FVector2D& EndPosition);
+	void EndWirePreview();
+
+	// Local cursor (null while the mouse is outside the panel) and visible area of a graph, in graph units
+	void UpdatePresence(UEdGraph* Graph, const FVector2D* Cursor, const FBox2D& View);
+
+	// Node and pin lookups by wire id, for handlers of remote operations; indexed per graph
+	UEdGraphNode* FindNodeByGuid(UEdGraph* Graph, const FGuid& NodeId);
+	UEdGraphPin* FindPinByName(UEdGraph* Graph, const FGuid& NodeId, FName PinName);
+
 	// Events
 	FOnRemoteWirePreview OnRemoteWirePreview;
+	FOnRemoteWirePreviewEnded OnRemoteWirePreviewEnded;
 	FOnRemoteNodeOperation OnRemoteNodeOperation;
+	FOnRemotePresence OnRemotePresence;
 
 private:
 	// Core components
 	UPROPERTY()
 	TObjectPtr<ULiveBPMUEIntegration> MUEIntegration;
 
+	// Everyone's node locks, ours and those received, indexed by holder, Blueprint and graph
+	UPROPERTY()
+	TObjectPtr<ULiveBPLockManager> LockManager;
+
 	// State
 	bool bCollaborationEnabled;
 	bool bDebugModeEnabled;
 	TMap<UBlueprint*, TWeakPtr<SGraphEditor>> TrackedGraphEditors;
 	TMap<UBlueprint*, FDelegateHandle> BlueprintDelegateHandles;
 	TMap<FGuid, UBlueprint*> BlueprintGuidMap;
-	
-	// Node locks (simple implementation without separate LockManager)
-	TMap<FGuid, FLiveBPNodeLock> NodeLocks;
 
-	// Wire preview throttling
-	float LastWirePreviewTime;
-	static constexpr float WIRE_PREVIEW_THROTTLE = 0.1f; // 10Hz
+	// Wire preview sampling, at the fastest peer's congestion-controlled send rate
+	double LastWirePreviewTime;
+	FVector2D PendingWirePreviewPosition;
+	bool bHasPendingWirePreview;
+
+	// Presence sampling at ULiveBPSettings::PresenceUpdateRateHz; the newest state waits here until it is due
+	double LastPresenceTime;
+	FLiveBPPresence PendingPresence;
+	FGuid PendingPresenceBlueprintId;
+	FGuid PendingPresenceGraphId;
+	bool bHasPendingPresence;
+	void FlushPresence(double CurrentTime);
+
+	// Wire ids of the objects we have sent or looked up, so they are derived from paths and names only once
+	mutable FLiveBPIdentityCache Identities;
+
+	// Every graph of each open Blueprint by wire id, rebuilt after structural changes
+	TMap<TWeakObjectPtr<UBlueprint>, FLiveBPGraphRegistry> GraphRegistries;
+	FLiveBPGraphRegistry& GetGraphRegistry(UBlueprint* Blueprint);
+
+	// Node/pin indices of the graphs remote operations have touched, dropped when their Blueprint closes
+	TMap<TWeakObjectPtr<UEdGraph>, TUniquePtr<FLiveBPGraphIndex>> GraphIndices;
+	FLiveBPGraphIndex& GetGraphIndex(UEdGraph* Graph);
+
+	// Received node operations, applied a frame-time budget at a time (see ULiveBPSettings::RemoteApplyBudgetMs)
+	FLiveBPApplyScheduler RemoteOperations;
+	TWeakPtr<SNotificationItem> RemoteApplyNotification;
 
 	// Blueprint editor integration
 	void RegisterBlueprintCallbacks();
@@ -79,6 +133,10 @@ private:
 	
 	void OnBlueprintPreCompile(UBlueprint* Blueprint);
 	void OnBlueprintCompiled(UBlueprint* Blueprint);
+
+	// Cached ids that may no longer match what they would be computed as
+	void OnBlueprintChanged(UBlueprint* Blueprint);
+	void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName);
 	
 	// Graph editor hooks
 	void RegisterGraphEditorCallbacks(UBlueprint* Blueprint);
@@ -90,21 +148,37 @@ private:
 	void OnPinConnected(class UEdGraphPin* OutputPin, class UEdGraphPin* InputPin);
 	void OnPinDisconnected(class UEdGraphPin* Pin);
 	
-	// Wire preview handling
-	void OnWireDragStart(const TSharedRef<SGraphEditor>& GraphEditor, UEdGraphNode* Node, const FString& PinName);
-	void OnWireDragUpdate(const TSharedRef<SGraphEditor>& GraphEditor, const FVector2D& Position);
-	void OnWireDragEnd(const TSharedRef<SGraphEditor>& GraphEditor);
-	
+	// Pushes transport related settings down to the MUE integration
+	void ApplyTransportSettings();
+
+	// Per-tick bookkeeping once the engine frame ends
+	void OnEndFrame();
+	FDelegateHandle EndFrameHandle;
+
+	// Tells the other clients which Blueprints we have open, so previews are only sent where they are visible
+	void PublishInterest();
+
+	// Lets the integration resolve Blueprint ids of received messages off the game thread
+	void PublishResolvableBlueprints();
+
 	// Message handling
-	void OnMUEMessageReceived(const FLiveBPMessage& Message);
-	void ProcessWirePreviewMessage(const FLiveBPMessage& Message);
-	void ProcessNodeOperationMessage(const FLiveBPMessage& Message);
-	void ProcessLockMessage(const FLiveBPMessage& Message);
+	void OnMUEMessageReceived(const FLiveBPInboundMessage& Message);
+	void ProcessWirePreviewMessage(const FLiveBPInboundMessage& Message);
+	void ProcessPresenceMessage(const FLiveBPInboundMessage& Message);
+	void ProcessNodeOperationMessage(const FLiveBPInboundMessage& Message);
+	void ApplyRemoteOperations();
+	void ApplyRemoteNodeMoves(UBlueprint* Blueprint, const FGuid& GraphId, const TArray<FLiveBPNodeMove>& Moves);
+	void ApplyRemoteNodeTransaction(UBlueprint* Blueprint, const FGuid& GraphId, const TArray<FLiveBPNodeOperationData>& NodeOperations,
+		const FString& UserId);
+	void UpdateRemoteApplyProgress();
+	void ProcessLockMessage(const FLiveBPInboundMessage& Message);
+	void ProcessLockSetMessage(const FLiveBPInboundMessage& Message);
+	void OnUserLeft(const FString& UserId);
 	
 	// Utility functions
+	bool GetLockSetScope(TArrayView<UEdGraphNode* const> Nodes, FLiveBPNodeLockSet& OutLockSet, FGuid& OutBlueprintId, FGuid& OutGraphId) const;
 	UBlueprint* FindBlueprintByGuid(const FGuid& BlueprintId) const;
-	UEdGraph* FindGraphByGuid(UBlueprint* Blueprint, const FGuid& GraphId) const;
-	UEdGraphNode* FindNodeByGuid(UEdGraph* Graph, const FGuid& NodeId) const;
+	UEdGraph* FindGraphByGuid(UBlueprint* Blueprint, const FGuid& GraphId);
 	FGuid GetBlueprintGuid(UBlueprint* Blueprint) const;
 	FGuid GetGraphGuid(UEdGraph* Graph) const;
 	FGuid GetNodeGuid(UEdGraphNode* Node) const;
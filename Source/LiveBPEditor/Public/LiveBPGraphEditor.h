@@ -6,6 +6,7 @@
 #include "BlueprintGraph/Classes/K2Node.h"
 #include "SGraphEditor.h"
 #include "LiveBPDataTypes.h"
+#include "LiveBPInterpolation.h"
 #include "LiveBPEditorSubsystem.h"
 
 class SGraphPanel;
@@ -41,7 +42,7 @@ public:
 	void UpdateRemoteUserCursor(const FString& UserId, const FVector2D& Position, const FLinearColor& Color);
 	
 	/** Update wire drag preview from remote user */
-	void UpdateWireDragPreview(const FLiveBPWirePreviewMessage& Message);
+	void UpdateWireDragPreview(const FString& UserId, const FLiveBPWirePreview& WirePreview);
 	
 	/** Clear wire drag preview for a user */
 	void ClearWireDragPreview(const FString& UserId);
@@ -58,6 +59,7 @@ protected:
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, 
 		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
 	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
 	virtual FReply OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
 	virtual FReply OnDragDetected(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
@@ -75,7 +77,8 @@ private:
 	/** Remote user cursor data */
 	struct FRemoteUserCursor
 	{
-		FVector2D Position;
+		FVector2D Position; // Newest received; drawn from Motion
+		FLiveBPInterpolationBuffer Motion;
 		FLinearColor Color;
 		float LastUpdateTime;
 		bool bIsVisible;
@@ -87,14 +90,16 @@ private:
 	/** Wire drag preview data */
 	struct FWireDragPreview
 	{
-		FGuid StartPinId;
+		FGuid StartNodeId;
+		FString StartPinName;
 		FVector2D StartPosition;
-		FVector2D CurrentPosition;
+		FVector2D CurrentPosition; // Newest received; drawn from EndMotion
+		FLiveBPInterpolationBuffer EndMotion;
 		FLinearColor Color;
 		float LastUpdateTime;
 		bool bIsActive;
 		
-		FWireDragPreview() : StartPinId(), StartPosition(FVector2D::ZeroVector), CurrentPosition(FVector2D::ZeroVector), 
+		FWireDragPreview() : StartNodeId(), StartPosition(FVector2D::ZeroVector), CurrentPosition(FVector2D::ZeroVector), 
 			Color(FLinearColor::White), LastUpdateTime(0.0f), bIsActive(false) {}
 	};
 	TMap<FString, FWireDragPreview> WireDragPreviews;
@@ -118,12 +123,18 @@ private:
 	FVector2D DragStartPosition;
 	FVector2D LastMousePosition;
 	
+	/** Whether our presence in this graph was published while hovered, so leaving it can hide our cursor */
+	bool bPublishingPresence;
+	
 	/** Collaboration colors for different users */
 	TMap<FString, FLinearColor> UserColors;
 	
 	/** Get or create a color for a user */
 	FLinearColor GetUserColor(const FString& UserId);
 	
+	/** Playout delay and extrapolation for remote cursors and previews, from the settings */
+	static FLiveBPPlayoutSettings GetPlayoutSettings();
+	
 	/** Handle local wire drag start */
 	void OnLocalWireDragStart(const FGuid& PinId, const FVector2D& Position);
 	
@@ -133,16 +144,26 @@ private:
 	/** Handle local wire drag end */
 	void OnLocalWireDragEnd(const FVector2D& Position, bool bConnected);
 	
-	/** Send wire preview message to other users */
-	void SendWirePreviewMessage(const FVector2D& MousePosition);
+	/** Remote wire preview events from the editor subsystem */
+	void HandleRemoteWirePreview(UBlueprint* Blueprint, const FLiveBPWirePreview& WirePreview, const FString& UserId);
+	void HandleRemoteWirePreviewEnded(UBlueprint* Blueprint, const FString& UserId);
+	
+	/** Publish our cursor (if the mouse is over the panel) and the visible part of the graph */
+	void PublishPresence(const FGeometry& Geometry, bool bHasCursor);
+	
+	/** Remote presence from the editor subsystem: shows the user's cursor while they are in this graph */
+	void HandleRemotePresence(UBlueprint* Blueprint, UEdGraph* Graph, const FLiveBPPresence& Presence, const FString& UserId);
+	
+	/** Find a pin in the edited graph by its PinId */
+	UEdGraphPin* FindPinById(const FGuid& PinId) const;
 	
 	/** Draw remote user cursor */
 	void DrawRemoteUserCursor(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, 
-		int32 LayerId, const FString& UserId, const FRemoteUserCursor& Cursor) const;
+		int32 LayerId, const FString& UserId, const FRemoteUserCursor& Cursor, const FVector2D& Position) const;
 	
 	/** Draw wire drag preview */
 	void DrawWireDragPreview(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, 
-		int32 LayerId, const FString& UserId, const FWireDragPreview& Preview) const;
+		int32 LayerId, const FString& UserId, const FWireDragPreview& Preview, const FVector2D& EndPosition) const;
 	
 	/** Draw node lock visual feedback */
 	void DrawNodeLockFeedback(const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, 
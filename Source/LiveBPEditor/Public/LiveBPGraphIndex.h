@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraph.h"
+
+class UEdGraphNode;
+class UEdGraphPin;
+
+/**
+ * Hash index of one graph's nodes by id, and of their pins by name.
+ *
+ * Received operations name nodes by id and pins by name; on large graphs a scan of Graph->Nodes
+ * per message makes a burst of them quadratic. The index is kept up to date from the graph's
+ * change notifications: removed nodes are patched out, and any other change marks it for a
+ * rebuild on the next lookup. Added nodes are only indexed at the next lookup, because the
+ * notification fires before a pasted or spawned node is given its final guid; a lookup that
+ * still misses rebuilds once in case an id changed without a notification. Pins are indexed per
+ * node on first use, and a cached pin is checked before it is returned, so a node that
+ * reconstructed its pins is simply re-indexed.
+ * Debug builds check the index against the graph after every update.
+ * Game thread only.
+ */
+class LIVEBPEDITOR_API FLiveBPGraphIndex
+{
+public:
+	/** The id a node is known by on the wire */
+	using FNodeIdFunc = TFunction<FGuid(UEdGraphNode* Node)>;
+
+	FLiveBPGraphIndex(UEdGraph* InGraph, FNodeIdFunc InGetNodeId);
+	~FLiveBPGraphIndex();
+
+	FLiveBPGraphIndex(const FLiveBPGraphIndex&) = delete;
+	FLiveBPGraphIndex& operator=(const FLiveBPGraphIndex&) = delete;
+
+	UEdGraphNode* FindNode(const FGuid& NodeId);
+	UEdGraphPin* FindPin(const FGuid& NodeId, FName PinName);
+
+	UEdGraph* GetGraph() const { return Graph.Get(); }
+	int32 Num() const { return NodeIds.Num(); }
+
+private:
+	struct FNodeEntry
+	{
+		TWeakObjectPtr<UEdGraphNode> Node;
+		TMap<FName, int32> PinIndices;
+		bool bPinsIndexed = false;
+	};
+
+	void OnGraphChanged(const FEdGraphEditAction& Action);
+	void Rebuild();
+	void IndexAddedNodes();
+	void AddNode(UEdGraphNode* Node);
+	void RemoveNode(const UEdGraphNode* Node);
+	static void IndexPins(FNodeEntry& Entry);
+	void Verify() const;
+
+	TWeakObjectPtr<UEdGraph> Graph;
+	FNodeIdFunc GetNodeId;
+	FDelegateHandle GraphChangedHandle;
+
+	TMap<FGuid, FNodeEntry> Nodes;
+	// Ids can be derived from a node's position, so removal goes by the id it was indexed under
+	TMap<const UEdGraphNode*, FGuid> NodeIds;
+	// Added since the last lookup, not indexed yet
+	TArray<TWeakObjectPtr<UEdGraphNode>> AddedNodes;
+	bool bNeedsRebuild;
+	bool bRebuiltSinceChange;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraph;
+
+/**
+ * Every graph of one Blueprint by wire id: event graphs, functions, macros, delegate signatures
+ * and the sub-graphs nested in them (collapsed nodes, composite graphs).
+ *
+ * Built when the Blueprint is opened, and rebuilt on the next lookup after its owner invalidates it:
+ * when the Blueprint changes structurally (graphs added, removed or collapsed) or a graph is renamed.
+ * Game thread only.
+ */
+class LIVEBPEDITOR_API FLiveBPGraphRegistry
+{
+public:
+	using FGraphIdFunc = TFunctionRef<FGuid(UEdGraph* Graph)>;
+
+	void Rebuild(UBlueprint* Blueprint, FGraphIdFunc GetGraphId);
+	void Invalidate() { bIsBuilt = false; }
+	bool IsBuilt() const { return bIsBuilt; }
+
+	UEdGraph* Find(const FGuid& GraphId) const;
+
+	/** Every graph still alive */
+	void GetGraphs(TArray<UEdGraph*>& OutGraphs) const;
+
+	int32 Num() const { return Graphs.Num(); }
+
+private:
+	TMap<FGuid, TWeakObjectPtr<UEdGraph>> Graphs;
+	bool bIsBuilt = false;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+/**
+ * Wire ids of Blueprints, graphs and nodes, cached per object.
+ *
+ * Ids are derived from paths and names, which is too slow to redo for every message sent and every
+ * graph scanned for an incoming one. Each object's id is computed once and kept until its owner
+ * invalidates it: when it is renamed, or its Blueprint changes structurally (graphs added or removed,
+ * reparenting). Objects are held weakly; a destroyed object's stale entry goes when its Blueprint
+ * is invalidated or closed. Lookups by id go through the Blueprint map and graph registry instead.
+ * Game thread only.
+ */
+class LIVEBPEDITOR_API FLiveBPIdentityCache
+{
+public:
+	/** The object's cached id, computed and cached if there is none */
+	FGuid FindOrAdd(UObject* Object, TFunctionRef<FGuid()> Compute);
+
+	/** Forgets the ids of Outer and of everything inside it, along with any entry whose object is gone */
+	void RemoveWithin(const UObject* Outer);
+
+	int32 Num() const { return Ids.Num(); }
+
+	void Reset();
+
+private:
+	TMap<TWeakObjectPtr<UObject>, FGuid> Ids;
+};
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "LiveBPDataTypes.h"
 #include "LiveBPSettings.generated.h"
 
 UCLASS(Config = EditorSettings, DefaultConfig, Category = "Live Blueprint")
@@ -13,12 +14,32 @@ public:
 	ULiveBPSettings();
 
 	// Wire preview settings
+	// Starting send rate; with an adaptive rate, each peer's rate then follows its link within the bounds below
 	UPROPERTY(Config, EditAnywhere, Category = "Wire Previews", meta = (ClampMin = "1", ClampMax = "60"))
 	int32 WirePreviewUpdateRate = 10; // Hz
 
+	// Lower the rate to a peer when its round trip grows, previews to it get lost or our send queue backs up
+	UPROPERTY(Config, EditAnywhere, Category = "Wire Previews")
+	bool bAdaptiveSendRate = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Wire Previews", meta = (ClampMin = "1", ClampMax = "60", EditCondition = "bAdaptiveSendRate"))
+	float MinSendRateHz = 2.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Wire Previews", meta = (ClampMin = "1", ClampMax = "120", EditCondition = "bAdaptiveSendRate"))
+	float MaxSendRateHz = 60.0f;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Wire Previews")
 	bool bShowRemoteWirePreviews = true;
 
+	// Remote previews and cursors are drawn this far in the past and interpolated between updates.
+	// Keep it above the send interval (1 / MinSendRateHz); below it motion relies on extrapolation.
+	UPROPERTY(Config, EditAnywhere, Category = "Wire Previews", meta = (ClampMin = "0", ClampMax = "1000"))
+	float RemotePlayoutDelayMs = 150.0f;
+
+	// How long remote motion keeps going at its last velocity when the next update is late
+	UPROPERTY(Config, EditAnywhere, Category = "Wire Previews", meta = (ClampMin = "0", ClampMax = "500"))
+	float MaxExtrapolationMs = 100.0f;
+
 	UPROPERTY(Config, EditAnywhere, Category = "Wire Previews")
 	FLinearColor RemoteWirePreviewColor = FLinearColor(1.0f, 0.5f, 0.0f, 0.8f);
 
@@ -46,11 +67,39 @@ public:
 	int32 MaxConcurrentUsers = 10;
 
 	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "10", ClampMax = "1000"))
-	int32 MaxMessageQueueSize = 100;
+	int32 MaxMessageQueueSize = 100; // Per priority class; a full preview class keeps only the latest value per stream
 
 	UPROPERTY(Config, EditAnywhere, Category = "Performance")
 	bool bThrottleMessages = true;
 
+	// Time per frame spent applying received node operations; the rest of a burst waits for the next frames
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0.5", ClampMax = "50"))
+	float RemoteApplyBudgetMs = 4.0f;
+
+	// Serialize and batch outgoing messages on a background thread instead of the game thread
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bSendOnWorkerThread = true;
+
+	// Pack the messages produced during a tick into one Concert event per destination
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bBatchOutgoingMessages = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "256", ClampMax = "262144", EditCondition = "bBatchOutgoingMessages"))
+	int32 MaxBatchBytes = 16384; // Flush as soon as a batch reaches this size
+
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "0", ClampMax = "250", EditCondition = "bBatchOutgoingMessages"))
+	float MaxBatchDelayMs = 0.0f; // 0 flushes at the end of every tick
+
+	// Compress message payloads (e.g. pasted nodes with property data) above a size threshold
+	UPROPERTY(Config, EditAnywhere, Category = "Performance")
+	bool bCompressLargePayloads = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (ClampMin = "64", ClampMax = "65536", EditCondition = "bCompressLargePayloads"))
+	int32 CompressionThresholdBytes = 1024;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Performance", meta = (EditCondition = "bCompressLargePayloads"))
+	ELiveBPCompressionFormat CompressionFormat = ELiveBPCompressionFormat::Oodle;
+
 	// UI settings
 	UPROPERTY(Config, EditAnywhere, Category = "User Interface")
 	bool bShowCollaboratorCursors = true;
@@ -58,6 +107,17 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "User Interface")
 	bool bShowCollaboratorNames = true;
 
+	// Publish our cursor and the visible part of the graph; peers also use the view to skip previews we can't see
+	UPROPERTY(Config, EditAnywhere, Category = "User Interface")
+	bool bBroadcastPresence = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "User Interface", meta = (ClampMin = "1", ClampMax = "30", EditCondition = "bBroadcastPresence"))
+	float PresenceUpdateRateHz = 10.0f;
+
+	// Graph units the cursor or view must move before an update is sent
+	UPROPERTY(Config, EditAnywhere, Category = "User Interface", meta = (ClampMin = "16", ClampMax = "512", EditCondition = "bBroadcastPresence"))
+	float PresenceMovementThreshold = 32.0f;
+
 	UPROPERTY(Config, EditAnywhere, Category = "User Interface")
 	bool bShowActivityNotifications = true;
 
@@ -111,4 +171,8 @@ public:
 
 	UPROPERTY(Config, EditAnywhere, Category = "Debug")
 	bool bShowDebugOverlay = false;
+
+	// Send node operations and locks as JSON instead of the binary codec (development builds only)
+	UPROPERTY(Config, EditAnywhere, Category = "Debug")
+	bool bUseJsonPayloadsForDebugging = false;
 };